@@ -28,8 +28,8 @@ void call_consumer_thread()
         
         while (consumer_worker->is_running()) 
         {
-            const char* paylod= consumer_worker->consume(1000);
-            if(strlen(paylod) > 0)
+            const std::string paylod= consumer_worker->consume(1000);
+            if(paylod.length() > 0)
             {
                 spdlog::info("Consumed message payload: {0}", paylod );
             }
@@ -0,0 +1,146 @@
+#ifndef BOUNDED_MPMC_QUEUE_H
+#define BOUNDED_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace kafka_clients
+{
+    /**
+     * @brief Lock free bounded multi producer multi consumer queue (Vyukov). Each cell carries a sequence
+     * number telling producers and consumers whether it is free or filled for their position, so push and pop
+     * only contend on a single compare and swap of their respective position counter.
+     *
+     * @tparam T movable element type.
+     */
+    template <typename T>
+    class bounded_mpmc_queue
+    {
+        private:
+            struct cell
+            {
+                std::atomic<size_t> sequence;
+                T data;
+            };
+            // Avoid false sharing between producer and consumer positions
+            static constexpr size_t CACHE_LINE_SIZE = 64;
+
+            std::unique_ptr<cell[]> _buffer;
+            size_t _mask;
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> _enqueue_pos{0};
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> _dequeue_pos{0};
+
+            static size_t round_up_power_of_two(size_t value)
+            {
+                size_t result = 2;
+                while (result < value)
+                {
+                    result <<= 1;
+                }
+                return result;
+            }
+
+        public:
+            /**
+             * @brief Construct a queue.
+             *
+             * @param capacity minimum number of elements, rounded up to a power of two.
+             */
+            explicit bounded_mpmc_queue(size_t capacity) : _buffer(new cell[round_up_power_of_two(capacity)]),
+                                                           _mask(round_up_power_of_two(capacity) - 1)
+            {
+                for (size_t i = 0; i <= _mask; i++)
+                {
+                    _buffer[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+            bounded_mpmc_queue(const bounded_mpmc_queue &) = delete;
+            bounded_mpmc_queue &operator=(const bounded_mpmc_queue &) = delete;
+
+            /**
+             * @brief Push an element without blocking.
+             *
+             * @param value element, moved into the queue on success.
+             * @return false if the queue is full.
+             */
+            bool try_push(T &&value)
+            {
+                cell *target;
+                size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    target = &_buffer[pos & _mask];
+                    size_t seq = target->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                    if (diff == 0)
+                    {
+                        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = _enqueue_pos.load(std::memory_order_relaxed);
+                    }
+                }
+                target->data = std::move(value);
+                target->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pop an element without blocking.
+             *
+             * @param value set to the popped element on success.
+             * @return false if the queue is empty.
+             */
+            bool try_pop(T &value)
+            {
+                cell *target;
+                size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    target = &_buffer[pos & _mask];
+                    size_t seq = target->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                    if (diff == 0)
+                    {
+                        if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = _dequeue_pos.load(std::memory_order_relaxed);
+                    }
+                }
+                value = std::move(target->data);
+                // Release the element now rather than when the cell is reused
+                target->data = T();
+                target->sequence.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Number of elements the queue can hold.
+             */
+            size_t capacity() const
+            {
+                return _mask + 1;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef IN_MEMORY_TOPIC_BUS_H
+#define IN_MEMORY_TOPIC_BUS_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bounded_mpmc_queue.h"
+#include "kafka_message.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Queue of records published to the topics a consumer subscribed to.
+     */
+    class in_memory_subscription
+    {
+        private:
+            bounded_mpmc_queue<std::shared_ptr<const in_memory_record>> _queue;
+
+        public:
+            explicit in_memory_subscription(size_t capacity);
+            /**
+             * @brief Enqueue a record without blocking.
+             *
+             * @return false if the subscriber queue is full and the record was dropped.
+             */
+            bool push(std::shared_ptr<const in_memory_record> record);
+            /**
+             * @brief Dequeue a record, spinning and then sleeping briefly while the queue is empty.
+             *
+             * @param record set to the dequeued record.
+             * @param timeout_ms maximum time to wait for a record, 0 to return immediately.
+             * @return false on timeout.
+             */
+            bool pop(std::shared_ptr<const in_memory_record> &record, int timeout_ms);
+    };
+
+    /**
+     * @brief Topic of the in process bus. Publishing is lock free: the list of subscribers is an immutable
+     * snapshot replaced on subscribe and unsubscribe.
+     */
+    class in_memory_topic
+    {
+        private:
+            using subscriber_list = std::vector<std::shared_ptr<in_memory_subscription>>;
+
+            std::string _name;
+            std::atomic<int64_t> _next_offset{0};
+            std::shared_ptr<const subscriber_list> _subscribers;
+
+        public:
+            explicit in_memory_topic(const std::string &name);
+            const std::string &get_name() const;
+            /**
+             * @brief Publish a record to all current subscribers. Records published while there are no
+             * subscribers are dropped, like a Kafka consumer starting at the end of the topic.
+             *
+             * @param payload message payload, moved into the shared record.
+             * @param key message key.
+             * @param trace value of the TRACE_HEADER header, empty for none.
+             * @return false if the record was dropped by a full subscriber queue.
+             */
+            bool publish(std::string &&payload, const std::string &key, const std::string &trace = "");
+            void add_subscriber(const std::shared_ptr<in_memory_subscription> &subscription);
+            void remove_subscriber(const std::shared_ptr<in_memory_subscription> &subscription);
+    };
+
+    /**
+     * @brief In process stand in for a Kafka broker. Every subscription receives every record published to its
+     * topics after it subscribed, in publish order per producer; consumer groups and partitions are not modeled.
+     */
+    class in_memory_topic_bus
+    {
+        private:
+            // Guards topic creation and subscription changes, never taken on publish or consume
+            std::mutex _topics_mtx;
+            std::unordered_map<std::string, std::shared_ptr<in_memory_topic>> _topics;
+
+        public:
+            // Default number of records buffered per subscription
+            static constexpr size_t DEFAULT_QUEUE_CAPACITY = 65536;
+
+            /**
+             * @brief Bus shared by all in memory workers of the process.
+             */
+            static std::shared_ptr<in_memory_topic_bus> get_default();
+            /**
+             * @brief Get a topic, creating it on first use.
+             */
+            std::shared_ptr<in_memory_topic> get_topic(const std::string &name);
+            /**
+             * @brief Subscribe to a list of topics.
+             *
+             * @param topics topic names.
+             * @param capacity number of records buffered before publishers drop records for this subscription.
+             * @return std::shared_ptr<in_memory_subscription> subscription receiving records of all topics.
+             */
+            std::shared_ptr<in_memory_subscription> subscribe(const std::vector<std::string> &topics, size_t capacity = DEFAULT_QUEUE_CAPACITY);
+            /**
+             * @brief Remove a subscription from all topics.
+             */
+            void unsubscribe(const std::shared_ptr<in_memory_subscription> &subscription);
+    };
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef IN_MEMORY_TRANSPORT_H
+#define IN_MEMORY_TRANSPORT_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "kafka_transport.h"
+#include "in_memory_topic_bus.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief consumer_transport reading from an in_memory_topic_bus instead of a Kafka broker.
+     */
+    class in_memory_consumer_worker : public consumer_transport
+    {
+        private:
+            std::shared_ptr<in_memory_topic_bus> _bus;
+            std::vector<std::string> _topics;
+            std::string _group_id;
+            // Accessed with std::atomic_load/atomic_store since stop() may run while another thread consumes
+            std::shared_ptr<in_memory_subscription> _subscription;
+            std::atomic<bool> _run{false};
+            kafka_client_metrics _metrics;
+
+        public:
+            /**
+             * @brief Construct a consumer of the given topics.
+             *
+             * @param bus topic bus shared with the producers.
+             * @param topics topics to subscribe to.
+             * @param group_id consumer group, only used for logging since the bus does not model groups.
+             */
+            in_memory_consumer_worker(std::shared_ptr<in_memory_topic_bus> bus, const std::vector<std::string> &topics, const std::string &group_id);
+            ~in_memory_consumer_worker() override;
+            bool init() override;
+            void subscribe() override;
+            kafka_message consume_message(int timeout_ms) override;
+            std::string consume(int timeout_ms) override;
+            size_t consume_batch(std::vector<kafka_message> &batch, size_t max_messages, int timeout_ms) override;
+            void stop() override;
+            bool is_running() const override;
+            const std::vector<std::string> &get_topics() const override;
+            const kafka_client_metrics &get_metrics() const override;
+    };
+
+    /**
+     * @brief producer_transport publishing to an in_memory_topic_bus instead of a Kafka broker. Messages are
+     * delivered synchronously to the subscriber queues, so a send is reported as delivered right away.
+     */
+    class in_memory_producer_worker : public producer_transport
+    {
+        private:
+            std::shared_ptr<in_memory_topic_bus> _bus;
+            std::string _topic_name;
+            std::shared_ptr<in_memory_topic> _topic;
+            std::atomic<bool> _run{false};
+            kafka_client_metrics _metrics;
+
+            bool publish(std::string &&msg, const std::string &key, const std::string &trace);
+
+        public:
+            /**
+             * @brief Construct a producer of the given topic.
+             *
+             * @param bus topic bus shared with the consumers.
+             * @param topic topic to publish to.
+             */
+            in_memory_producer_worker(std::shared_ptr<in_memory_topic_bus> bus, const std::string &topic);
+            bool init() override;
+            bool send(const std::string &msg) override;
+            bool send(std::string &&msg) override;
+            bool send(const std::string &msg, const std::string &key) override;
+            bool send(std::string &&msg, const std::string &key) override;
+            bool send(std::string &&msg, const trace_context &trace) override;
+            producer_stats get_stats() const override;
+            const kafka_client_metrics &get_metrics() const override;
+            void stop() override;
+    };
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "kafka_producer_worker.h"
 #include "kafka_consumer_worker.h"
+#include "kafka_tuning_profile.h"
+#include "kafka_consumer_dispatcher.h"
+#include "kafka_transport.h"
+#include "in_memory_transport.h"
 #include <boost/thread.hpp>
 #include <boost/chrono.hpp>
 #include <spdlog/spdlog.h>
@@ -14,10 +18,61 @@ namespace kafka_clients
 
     class kafka_client
     {
+    private:
+        transport_type _transport;
+        std::shared_ptr<in_memory_topic_bus> _bus;
+
     public:
+        /**
+         * @brief Construct a client.
+         *
+         * @param transport transport of the workers created by create_consumer_transport() and create_producer_transport().
+         * @param bus topic bus used by the in memory transport, defaults to the bus shared by the whole process.
+         */
+        explicit kafka_client(transport_type transport = transport_type::KAFKA, std::shared_ptr<in_memory_topic_bus> bus = nullptr);
         std::shared_ptr<kafka_clients::kafka_consumer_worker> create_consumer(const std::string &broker_str, const std::string &topic_str,
                                                                               std::string &group_id_str) const;
         std::shared_ptr<kafka_clients::kafka_producer_worker> create_producer(const std::string &broker_str, const std::string &topic_str) const;
+        /**
+         * @brief Create a consumer configured with librdkafka tuning properties.
+         *
+         * @param properties librdkafka properties, e.g. from get_consumer_properties().
+         */
+        std::shared_ptr<kafka_clients::kafka_consumer_worker> create_consumer(const std::string &broker_str, const std::string &topic_str,
+                                                                              std::string &group_id_str, const kafka_properties &properties) const;
+        /**
+         * @brief Create a single consumer subscribing to several topics in one consumer group. Pair it with a
+         * kafka_consumer_dispatcher to serve all topics from one poll loop.
+         *
+         * @param topics topics to subscribe to.
+         * @param properties librdkafka properties, e.g. from get_consumer_properties().
+         */
+        std::shared_ptr<kafka_clients::kafka_consumer_worker> create_consumer(const std::string &broker_str, const std::vector<std::string> &topics,
+                                                                              const std::string &group_id_str, const kafka_properties &properties = {}) const;
+        /**
+         * @brief Create a producer configured with librdkafka tuning properties.
+         *
+         * @param properties librdkafka properties, e.g. from get_producer_properties().
+         */
+        std::shared_ptr<kafka_clients::kafka_producer_worker> create_producer(const std::string &broker_str, const std::string &topic_str,
+                                                                              const kafka_properties &properties) const;
+        /**
+         * @brief Create a consumer of the client transport, a kafka_consumer_worker connected to broker_str or an
+         * in_memory_consumer_worker on the client topic bus.
+         *
+         * @param topics topics to subscribe to.
+         * @param properties librdkafka properties, ignored by the in memory transport.
+         */
+        std::shared_ptr<kafka_clients::consumer_transport> create_consumer_transport(const std::string &broker_str, const std::vector<std::string> &topics,
+                                                                                     const std::string &group_id_str, const kafka_properties &properties = {}) const;
+        /**
+         * @brief Create a producer of the client transport, a kafka_producer_worker connected to broker_str or an
+         * in_memory_producer_worker on the client topic bus.
+         *
+         * @param properties librdkafka properties, ignored by the in memory transport.
+         */
+        std::shared_ptr<kafka_clients::producer_transport> create_producer_transport(const std::string &broker_str, const std::string &topic_str,
+                                                                                     const kafka_properties &properties = {}) const;
         rapidjson::Document read_json_file(const std::string &json_file) const;
         std::string get_value_by_doc(rapidjson::Document &doc, const char *key) const;
     };
@@ -0,0 +1,123 @@
+#ifndef KAFKA_CLIENT_METRICS_H
+#define KAFKA_CLIENT_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "latency_histogram.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Per partition values read from the librdkafka statistics JSON.
+     */
+    struct partition_statistics
+    {
+        std::string topic;
+        int32_t partition = 0;
+        // Difference between the partition high watermark and the consumer position, -1 if unknown
+        int64_t consumer_lag = -1;
+        // Messages fetched and waiting to be consumed by the application
+        int64_t fetch_queue_depth = 0;
+        // Messages waiting to be produced to the partition
+        int64_t message_queue_depth = 0;
+    };
+
+    /**
+     * @brief Client wide values read from the latest librdkafka statistics JSON. Message and byte counts are
+     * totals since the client was created.
+     */
+    struct kafka_statistics
+    {
+        // librdkafka internal monotonic clock in microseconds at which the statistics were emitted
+        int64_t timestamp_us = 0;
+        int64_t messages_in = 0;
+        int64_t bytes_in = 0;
+        int64_t messages_out = 0;
+        int64_t bytes_out = 0;
+        // Messages in the producer queues
+        int64_t queue_depth = 0;
+        // Operations (callbacks, events) waiting to be served by poll()/consume()
+        int64_t reply_queue_depth = 0;
+        std::vector<partition_statistics> partitions;
+    };
+
+    /**
+     * @brief Metrics of a single kafka consumer or producer worker. Combines counters and latency histograms
+     * recorded by the worker on the message path with the statistics librdkafka emits every
+     * statistics.interval.ms, so Kafka lag and queueing can be told apart from service compute time.
+     * Recording is lock free, statistics snapshots are guarded by a mutex.
+     */
+    class kafka_client_metrics
+    {
+        private:
+            std::atomic<uint64_t> _queued{0};
+            std::atomic<uint64_t> _delivered{0};
+            std::atomic<uint64_t> _failed{0};
+            std::atomic<uint64_t> _consumed{0};
+            std::atomic<uint64_t> _consumed_bytes{0};
+            latency_histogram _delivery_latency;
+            latency_histogram _end_to_end_latency;
+            mutable std::mutex _statistics_mtx;
+            kafka_statistics _statistics;
+            std::string _name;
+
+        public:
+            kafka_client_metrics() = default;
+            kafka_client_metrics(const kafka_client_metrics &) = delete;
+            kafka_client_metrics &operator=(const kafka_client_metrics &) = delete;
+
+            /**
+             * @brief Record the result of a produce call.
+             *
+             * @param accepted true if librdkafka queued the message.
+             */
+            void record_produce(bool accepted);
+            /**
+             * @brief Record a delivery report.
+             *
+             * @param delivered true if the broker acknowledged the message.
+             * @param latency_us produce to delivery report latency in microseconds, negative if unknown.
+             */
+            void record_delivery(bool delivered, int64_t latency_us);
+            /**
+             * @brief Record a consumed message and its end to end latency.
+             *
+             * @param bytes payload size.
+             * @param timestamp_ms message timestamp in milliseconds since epoch, negative if unavailable.
+             */
+            void record_consume(size_t bytes, int64_t timestamp_ms);
+            /**
+             * @brief Update statistics from a librdkafka statistics JSON (RdKafka::Event::EVENT_STATS).
+             *
+             * @param json statistics JSON string.
+             * @return true if the statistics were parsed successfully.
+             */
+            bool update_statistics(const std::string &json);
+
+            uint64_t get_queued() const;
+            uint64_t get_delivered() const;
+            uint64_t get_failed() const;
+            uint64_t get_consumed() const;
+            uint64_t get_consumed_bytes() const;
+            const latency_histogram &get_delivery_latency() const;
+            const latency_histogram &get_end_to_end_latency() const;
+            /**
+             * @brief Get a copy of the latest librdkafka statistics.
+             */
+            kafka_statistics get_statistics() const;
+            /**
+             * @brief Largest consumer lag over all assigned partitions, -1 if unknown.
+             */
+            int64_t get_max_consumer_lag() const;
+            /**
+             * @brief Single line summary of the metrics for periodic logging.
+             */
+            std::string to_string() const;
+    };
+}
+
+#endif
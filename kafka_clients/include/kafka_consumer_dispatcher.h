@@ -0,0 +1,73 @@
+#ifndef KAFKA_CONSUMER_DISPATCHER_H
+#define KAFKA_CONSUMER_DISPATCHER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "kafka_transport.h"
+#include "kafka_message.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Handler invoked for every message consumed from the topic it is registered for. The message
+     * payload is only valid for the duration of the call.
+     */
+    using kafka_message_handler = std::function<void(const kafka_message &)>;
+
+    /**
+     * @brief Serves a consumer subscribed to several topics (see kafka_client::create_consumer with a topic list)
+     * from a single poll loop, dispatching each message to the handler registered for its topic. Replaces one
+     * consumer, broker connection and blocking thread per topic.
+     */
+    class kafka_consumer_dispatcher
+    {
+        private:
+            std::shared_ptr<consumer_transport> _consumer;
+            std::unordered_map<std::string, kafka_message_handler> _handlers;
+            // Reused across polls so the batch capacity is only allocated once
+            std::vector<kafka_message> _batch;
+
+        public:
+            // Default maximum number of messages drained per poll
+            static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+            // Default maximum time a poll blocks waiting for the first message
+            static constexpr int DEFAULT_TIMEOUT_MS = 1000;
+
+            /**
+             * @brief Construct a dispatcher for an initialized and subscribed consumer.
+             *
+             * @param consumer consumer worker to poll.
+             */
+            explicit kafka_consumer_dispatcher(std::shared_ptr<consumer_transport> consumer);
+            /**
+             * @brief Register the handler for messages of a topic, replacing any previous handler of that topic.
+             *
+             * @param topic topic name.
+             * @param handler handler called from the polling thread.
+             */
+            void register_handler(const std::string &topic, kafka_message_handler handler);
+            /**
+             * @brief Poll the consumer once and dispatch the consumed messages. Messages of topics without a
+             * handler are dropped. Exceptions thrown by a handler are logged and do not stop the dispatch.
+             *
+             * @param max_messages maximum number of messages to consume.
+             * @param timeout_ms maximum time to block waiting for the first message.
+             * @return size_t number of messages dispatched to a handler.
+             */
+            size_t dispatch(size_t max_messages = DEFAULT_BATCH_SIZE, int timeout_ms = DEFAULT_TIMEOUT_MS);
+            /**
+             * @brief Dispatch messages until the consumer stops running.
+             *
+             * @param max_messages maximum number of messages to consume per poll.
+             * @param timeout_ms maximum time a poll blocks waiting for the first message.
+             */
+            void run(size_t max_messages = DEFAULT_BATCH_SIZE, int timeout_ms = DEFAULT_TIMEOUT_MS);
+    };
+}
+
+#endif
@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <csignal>
 #include <cstring>
+#include <vector>
+#include <chrono>
 #include <sys/time.h>
 #include <spdlog/spdlog.h>
 
@@ -22,6 +24,11 @@
 #endif
 
 #include <librdkafka/rdkafkacpp.h>
+#include "kafka_message.h"
+#include "kafka_tuning_profile.h"
+#include "kafka_client_metrics.h"
+#include "kafka_transport.h"
+
 namespace kafka_clients
 {
     static int partition_cnt = 0;
@@ -75,8 +82,11 @@ namespace kafka_clients
 
     class consumer_event_cb : public RdKafka::EventCb 
     {
+        private:
+            kafka_client_metrics &_metrics;
+
         public:
-            consumer_event_cb(){};
+            explicit consumer_event_cb(kafka_client_metrics &metrics) : _metrics(metrics){};
             ~consumer_event_cb(){};
             void event_cb (RdKafka::Event &event) 
             {
@@ -91,7 +101,10 @@ namespace kafka_clients
                     break;
 
                 case RdKafka::Event::EVENT_STATS:
-                    SPDLOG_CRITICAL("{0} : Line {1}. STATS:  {2}  {3}",__FILE__, __LINE__, RdKafka::err2str(event.err()) ,event.str() );
+                    if (_metrics.update_statistics(event.str()))
+                    {
+                        SPDLOG_INFO("Consumer statistics {0}", _metrics.to_string());
+                    }
                     break;
 
                 case RdKafka::Event::EVENT_LOG:
@@ -109,7 +122,7 @@ namespace kafka_clients
             }
     };
         
-    class kafka_consumer_worker
+    class kafka_consumer_worker : public consumer_transport
     {
         private:
             const std::string BOOTSTRAP_SERVER="bootstrap.servers";
@@ -118,11 +131,16 @@ namespace kafka_clients
             const std::string GROUP_ID="group.id";
             const std::string MAX_PARTITION_FETCH_SIZE="max.partition.fetch.bytes";
             const std::string ENABLE_PARTITION_END_OF="enable.partition.eof";
+            const std::string STATISTICS_INTERVAL="statistics.interval.ms";
+
+            // Default interval of librdkafka statistics events, overridable through the pass-through properties
+            std::string STR_STATISTICS_INTERVAL_MS = "10000";
 
             //maximum size for pulling message from a single partition at a time
             std::string STR_FETCH_NUM = "10240000";
             
             std::string _topics_str = "";
+            std::vector<std::string> _topics_list;
             std::string _broker_str = "";
             std::string _group_id_str = "";
             int64_t _last_offset = 0;
@@ -131,18 +149,83 @@ namespace kafka_clients
             int64_t _cur_offet =  RdKafka::Topic::OFFSET_BEGINNING;
             int32_t _partition = 0;
             bool _run = false;
-            consumer_event_cb _consumer_event_cb;
+            // Tuning and pass-through librdkafka properties applied on top of the defaults in init()
+            kafka_properties _properties;
+            // Declared before the callbacks that record into it
+            kafka_client_metrics _metrics;
+            consumer_event_cb _consumer_event_cb{_metrics};
             consumer_rebalance_cb _consumer_rebalance_cb;
-            const char* msg_consume(RdKafka::Message *message, void *opaque);
+            bool msg_consume(const RdKafka::Message *message);
 
         public:
             kafka_consumer_worker(const std::string &broker_str, const std::string &topic_str, const std::string & group_id, int64_t cur_offset = 0, int32_t partition = 0);
-            bool init();
-            const char* consume(int timeout_ms);
-            void subscribe();
-            void stop();
+            /**
+             * @brief Construct a consumer subscribing to several topics with a single group membership and broker
+             * connection. Use kafka_message::topic() or a kafka_consumer_dispatcher to tell the messages apart.
+             *
+             * @param broker_str bootstrap servers.
+             * @param topics topics to subscribe to.
+             * @param group_id consumer group.
+             */
+            kafka_consumer_worker(const std::string &broker_str, const std::vector<std::string> &topics, const std::string & group_id, int64_t cur_offset = 0, int32_t partition = 0);
+            /**
+             * @brief Set librdkafka properties (e.g. from a tuning profile) to apply on top of the worker defaults.
+             * Must be called before init().
+             *
+             * @param properties librdkafka property names and values.
+             */
+            void set_properties(const kafka_properties &properties);
+            bool init() override;
+            /**
+             * @brief Consume a single message and return an owning handle to it. The handle is empty on timeout,
+             * partition EOF or error. The payload is read in place from librdkafka memory and released when the
+             * handle is dropped.
+             *
+             * @param timeout_ms maximum time to block waiting for a message.
+             * @return kafka_message owning the consumed message.
+             */
+            kafka_message consume_message(int timeout_ms) override;
+            /**
+             * @brief Consume a single message and copy its payload. Prefer consume_message() on hot paths.
+             *
+             * @param timeout_ms maximum time to block waiting for a message.
+             * @return std::string message payload, empty on timeout, partition EOF or error.
+             */
+            std::string consume(int timeout_ms) override;
+            /**
+             * @brief Consume up to max_messages messages in one call. Blocks for at most timeout_ms waiting for the
+             * first message and then drains, without blocking, messages librdkafka has already fetched. Messages are
+             * appended to batch, which is cleared first so callers can reuse its capacity across calls.
+             *
+             * @param batch vector to fill with owning message handles.
+             * @param max_messages maximum number of messages to return.
+             * @param timeout_ms maximum time to block waiting for the first message.
+             * @return size_t number of messages consumed.
+             */
+            size_t consume_batch(std::vector<kafka_message> &batch, size_t max_messages, int timeout_ms) override;
+            /**
+             * @brief Consume up to max_messages messages in one call. See consume_batch(std::vector<kafka_message>&, size_t, int).
+             *
+             * @param max_messages maximum number of messages to return.
+             * @param timeout_ms maximum time to block waiting for the first message.
+             * @return std::vector<kafka_message> owning message handles, empty on timeout.
+             */
+            std::vector<kafka_message> consume_batch(size_t max_messages, int timeout_ms);
+            void subscribe() override;
+            void stop() override;
             void printCurrConf();
-            bool is_running() const;
+            bool is_running() const override;
+            /**
+             * @brief Topics this consumer subscribes to.
+             */
+            const std::vector<std::string> &get_topics() const override;
+            /**
+             * @brief Consumer metrics: consumed message counts, end to end latency from the message timestamp and
+             * the latest librdkafka statistics (consumer lag, fetch queue depth), updated every statistics.interval.ms.
+             *
+             * @return const kafka_client_metrics&
+             */
+            const kafka_client_metrics &get_metrics() const override;
     };
 }
 
@@ -0,0 +1,128 @@
+#ifndef KAFKA_MESSAGE_H
+#define KAFKA_MESSAGE_H
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include <librdkafka/rdkafkacpp.h>
+
+namespace kafka_clients
+{
+    // Header carrying the pipeline trace of a message, see pipeline_trace.h
+    const std::string TRACE_HEADER = "streets_trace";
+
+    /**
+     * @brief Message published on the in process topic bus. Shared, immutable, between all consumers
+     * subscribed to its topic.
+     */
+    struct in_memory_record
+    {
+        std::string topic;
+        std::string key;
+        std::string payload;
+        int64_t offset = 0;
+        // Publish time in milliseconds since epoch
+        int64_t timestamp = -1;
+        // Value of the TRACE_HEADER header, empty if the record has none
+        std::string trace;
+    };
+
+    /**
+     * @brief Move-only handle owning a consumed RdKafka::Message, or sharing an in_memory_record. The payload and key point directly into
+     * librdkafka memory and stay valid until the handle is destroyed, so callers can parse the payload in
+     * place without copying it into a std::string. The payload is NOT guaranteed to be NUL-terminated,
+     * always use length() to bound reads.
+     */
+    class kafka_message
+    {
+        private:
+            std::unique_ptr<RdKafka::Message> _message;
+            std::shared_ptr<const in_memory_record> _record;
+
+        public:
+            /**
+             * @brief Construct an empty message handle.
+             */
+            kafka_message() = default;
+            /**
+             * @brief Take ownership of a message returned by RdKafka::KafkaConsumer::consume().
+             *
+             * @param message consumed message. Deleted when the handle is destroyed.
+             */
+            explicit kafka_message(RdKafka::Message *message);
+            /**
+             * @brief Share a message consumed from the in process topic bus.
+             *
+             * @param record published record.
+             */
+            explicit kafka_message(std::shared_ptr<const in_memory_record> record);
+
+            kafka_message(kafka_message &&other) noexcept = default;
+            kafka_message &operator=(kafka_message &&other) noexcept = default;
+            kafka_message(const kafka_message &) = delete;
+            kafka_message &operator=(const kafka_message &) = delete;
+            ~kafka_message() = default;
+
+            /**
+             * @brief Check whether the handle holds a message with a non empty payload.
+             *
+             * @return true if there is no payload to process.
+             */
+            bool empty() const;
+            /**
+             * @brief Pointer to the payload bytes owned by librdkafka, nullptr if empty.
+             */
+            const char *payload() const;
+            /**
+             * @brief Payload size in bytes.
+             */
+            size_t length() const;
+            /**
+             * @brief Pointer to the message key bytes, nullptr if the message has no key.
+             */
+            const char *key() const;
+            /**
+             * @brief Message key size in bytes.
+             */
+            size_t key_length() const;
+            /**
+             * @brief Name of the topic the message was consumed from.
+             */
+            std::string topic() const;
+            /**
+             * @brief Message offset, or RdKafka::Topic::OFFSET_INVALID if empty.
+             */
+            int64_t offset() const;
+            /**
+             * @brief Partition the message was consumed from, or RdKafka::Topic::PARTITION_UA if empty.
+             */
+            int32_t partition() const;
+            /**
+             * @brief Message timestamp in milliseconds since epoch, or -1 if unavailable.
+             */
+            int64_t timestamp() const;
+            /**
+             * @brief Message headers. The returned object is owned by the message and valid for the
+             * lifetime of this handle.
+             *
+             * @return RdKafka::Headers* or nullptr if the message has no headers or is an in_memory_record.
+             */
+            RdKafka::Headers *headers() const;
+            /**
+             * @brief Value of the TRACE_HEADER header, from the message headers or the in_memory_record.
+             *
+             * @return std::string header value, empty if the message has none.
+             */
+            std::string trace() const;
+            /**
+             * @brief Copy the payload into a std::string. Only use when the consumer API requires an owned string.
+             *
+             * @return std::string payload copy.
+             */
+            std::string to_string() const;
+    };
+}
+
+#endif
@@ -7,36 +7,46 @@
 #include <cstdio>
 #include <csignal>
 #include <cstring>
+#include <atomic>
+#include <thread>
 #if _AIX
 #include <unistd.h>
 #endif
 
 #include <librdkafka/rdkafkacpp.h>
 #include <spdlog/spdlog.h>
+#include "kafka_tuning_profile.h"
+#include "kafka_client_metrics.h"
+#include "kafka_transport.h"
 
 
 namespace kafka_clients
 {  
     class producer_delivery_report_cb : public RdKafka::DeliveryReportCb
     {
+        private:
+            kafka_client_metrics &_metrics;
+
         public:
-            producer_delivery_report_cb(){
+            explicit producer_delivery_report_cb(kafka_client_metrics &metrics) : _metrics(metrics){
 
             };
             ~producer_delivery_report_cb(){
 
             };
-            void dr_cb (RdKafka::Message &message)
-            {
-                SPDLOG_TRACE("Message dellivery for:  {0} bytes [ {1} ]",message.len(), message.errstr().c_str());
-                if(message.key())                 
-                    SPDLOG_INFO(" Key:  {:>8}",(char*)(message.key()));
-            }
+            /**
+             * @brief Record delivery result and latency and release payload buffers handed over to
+             * librdkafka by kafka_producer_worker::send(std::string &&).
+             */
+            void dr_cb (RdKafka::Message &message);
     };
     class producer_event_cb:public RdKafka::EventCb
     {
+        private:
+            kafka_client_metrics &_metrics;
+
         public:
-            producer_event_cb(){
+            explicit producer_event_cb(kafka_client_metrics &metrics) : _metrics(metrics){
 
             };
             ~producer_event_cb(){
@@ -48,10 +58,12 @@ namespace kafka_clients
                 {
                 case RdKafka::Event::EVENT_ERROR:                 
                     SPDLOG_CRITICAL("ERROR:  {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
-                    if (event.err() == RdKafka::ERR__ALL_BROKERS_DOWN)
                     break;
                 case RdKafka::Event::EVENT_STATS:
-                    SPDLOG_CRITICAL("STATS: {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
+                    if (_metrics.update_statistics(event.str()))
+                    {
+                        SPDLOG_INFO("Producer statistics {0}", _metrics.to_string());
+                    }
                     break;
                 case RdKafka::Event::EVENT_LOG:
                     SPDLOG_CRITICAL("LOG:  {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
@@ -63,27 +75,120 @@ namespace kafka_clients
             }
     };
 
-    class kafka_producer_worker
+    class kafka_producer_worker : public producer_transport
     {
         private:
             const std::string BOOTSTRAP_SERVER="bootstrap.servers";
             const std::string DR_CB="dr_cb";
             const std::string EVENT_CB="event_cb";
+            const std::string STATISTICS_INTERVAL="statistics.interval.ms";
+            // Default interval of librdkafka statistics events, overridable through the pass-through properties
+            const std::string STR_STATISTICS_INTERVAL_MS = "10000";
+            // Maximum time the background thread blocks in poll() waiting for delivery reports
+            const int POLL_TIMEOUT_MS = 100;
 
             RdKafka::Producer *_producer = nullptr;
             RdKafka::Topic *_topic = nullptr;
             std::string _topics_str = "";
             std::string _broker_str = "";
-            bool _run = false;
+            std::atomic<bool> _run{false};
             int _partition = 0;
-            producer_delivery_report_cb _producer_delivery_report_cb;
-            producer_event_cb _producer_event_cb;
+            std::thread _poll_thread;
+            // Tuning and pass-through librdkafka properties applied on top of the defaults in init()
+            kafka_properties _properties;
+            // Declared before the callbacks that record into it
+            kafka_client_metrics _metrics;
+            producer_delivery_report_cb _producer_delivery_report_cb{_metrics};
+            producer_event_cb _producer_event_cb{_metrics};
+
+            /**
+             * @brief Serve delivery reports and events until the producer is stopped.
+             */
+            void poll_loop();
+            /**
+             * @brief Purge the messages still queued or in flight and serve their delivery reports, so the callback
+             * releases the payloads moved into the producer by send(std::string &&).
+             */
+            void purge_undelivered();
+            /**
+             * @brief Enqueue a message. Never blocks, a full librdkafka queue is reported as a failure.
+             *
+             * @param payload message payload.
+             * @param len payload size in bytes.
+             * @param msgflags RdKafka::Producer message flags.
+             * @param key message key, nullptr for the configured partition.
+             * @param headers message headers, nullptr for none. Owned by librdkafka once produced, deleted on failure.
+             * @param msg_opaque per message opaque passed to the delivery report callback.
+             * @return true if librdkafka accepted the message.
+             */
+            bool produce(const char *payload, size_t len, int msgflags, const std::string *key, RdKafka::Headers *headers, void *msg_opaque);
 
         public:
             kafka_producer_worker(const std::string &brokers, const std::string &topics, int n_partition = 0);
-            bool init();
-            void send(const std::string &msg);
-            void stop();
+            ~kafka_producer_worker() override;
+            /**
+             * @brief Set librdkafka properties (e.g. from a tuning profile) to apply on top of the worker defaults.
+             * Must be called before init().
+             *
+             * @param properties librdkafka property names and values.
+             */
+            void set_properties(const kafka_properties &properties);
+            bool init() override;
+            /**
+             * @brief Produce a copy of msg to the configured partition.
+             *
+             * @param msg message payload.
+             * @return true if the message was queued for delivery.
+             */
+            bool send(const std::string &msg) override;
+            /**
+             * @brief Produce msg to the configured partition without copying it. The string is kept alive by the
+             * producer and released from the delivery report callback.
+             *
+             * @param msg message payload, moved into the producer.
+             * @return true if the message was queued for delivery.
+             */
+            bool send(std::string &&msg) override;
+            /**
+             * @brief Produce a copy of msg with a key. The partition is chosen by the configured partitioner from
+             * the key, so all messages of e.g. one vehicle land in the same partition in order.
+             *
+             * @param msg message payload.
+             * @param key message key.
+             * @return true if the message was queued for delivery.
+             */
+            bool send(const std::string &msg, const std::string &key) override;
+            /**
+             * @brief Produce msg with a key without copying the payload. See send(const std::string&, const std::string&).
+             *
+             * @param msg message payload, moved into the producer.
+             * @param key message key.
+             * @return true if the message was queued for delivery.
+             */
+            bool send(std::string &&msg, const std::string &key) override;
+            /**
+             * @brief Produce msg to the configured partition without copying it, with its pipeline trace in the
+             * TRACE_HEADER header.
+             *
+             * @param msg message payload, moved into the producer.
+             * @param trace pipeline trace of the message.
+             * @return true if the message was queued for delivery.
+             */
+            bool send(std::string &&msg, const trace_context &trace) override;
+            /**
+             * @brief Get the delivery counters of this producer.
+             *
+             * @return producer_stats snapshot.
+             */
+            producer_stats get_stats() const override;
+            /**
+             * @brief Producer metrics: delivery counters and latency and the latest librdkafka statistics
+             * (queue depths, bytes out), updated every statistics.interval.ms.
+             *
+             * @return const kafka_client_metrics&
+             */
+            const kafka_client_metrics &get_metrics() const override;
+            void stop() override;
             void printCurrConf();
         };
 }
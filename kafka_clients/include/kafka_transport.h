@@ -0,0 +1,150 @@
+#ifndef KAFKA_TRANSPORT_H
+#define KAFKA_TRANSPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "kafka_message.h"
+#include "kafka_client_metrics.h"
+#include "pipeline_trace.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Message transport used by the consumer and producer workers.
+     */
+    enum class transport_type
+    {
+        // librdkafka clients connected to a Kafka broker
+        KAFKA,
+        // In process topic bus, for running several services in one process without a broker
+        IN_MEMORY,
+    };
+
+    // Transport names used in service manifests
+    const std::string KAFKA_TRANSPORT = "kafka";
+    const std::string IN_MEMORY_TRANSPORT = "in_memory";
+
+    /**
+     * @brief Get the transport type from its manifest name.
+     *
+     * @param transport transport name (kafka or in_memory).
+     * @return transport_type. KAFKA for unknown names.
+     */
+    transport_type parse_transport_type(const std::string &transport);
+
+    /**
+     * @brief Snapshot of producer delivery counters.
+     */
+    struct producer_stats
+    {
+        // Messages accepted by librdkafka for delivery
+        uint64_t queued = 0;
+        // Messages acknowledged by the broker
+        uint64_t delivered = 0;
+        // Messages rejected on produce or failed in delivery report
+        uint64_t failed = 0;
+        // 99th percentile produce to delivery report latency in microseconds
+        uint64_t p99_delivery_latency_us = 0;
+    };
+
+    /**
+     * @brief Consumer side of a message transport. Implemented by kafka_consumer_worker and
+     * in_memory_consumer_worker so services can run with or without a broker.
+     */
+    class consumer_transport
+    {
+        public:
+            virtual ~consumer_transport() = default;
+            /**
+             * @brief Initialize the consumer.
+             *
+             * @return true if the consumer is ready to subscribe.
+             */
+            virtual bool init() = 0;
+            /**
+             * @brief Subscribe to the configured topics and start running.
+             */
+            virtual void subscribe() = 0;
+            /**
+             * @brief Consume a single message. The handle is empty on timeout.
+             *
+             * @param timeout_ms maximum time to block waiting for a message.
+             * @return kafka_message owning the consumed message.
+             */
+            virtual kafka_message consume_message(int timeout_ms) = 0;
+            /**
+             * @brief Consume a single message and copy its payload.
+             *
+             * @param timeout_ms maximum time to block waiting for a message.
+             * @return std::string message payload, empty on timeout.
+             */
+            virtual std::string consume(int timeout_ms) = 0;
+            /**
+             * @brief Consume up to max_messages messages, blocking for at most timeout_ms for the first one.
+             * batch is cleared first so callers can reuse its capacity.
+             *
+             * @return size_t number of messages consumed.
+             */
+            virtual size_t consume_batch(std::vector<kafka_message> &batch, size_t max_messages, int timeout_ms) = 0;
+            virtual void stop() = 0;
+            virtual bool is_running() const = 0;
+            /**
+             * @brief Topics this consumer subscribes to.
+             */
+            virtual const std::vector<std::string> &get_topics() const = 0;
+            virtual const kafka_client_metrics &get_metrics() const = 0;
+    };
+
+    /**
+     * @brief Producer side of a message transport. Implemented by kafka_producer_worker and
+     * in_memory_producer_worker so services can run with or without a broker.
+     */
+    class producer_transport
+    {
+        public:
+            virtual ~producer_transport() = default;
+            /**
+             * @brief Initialize the producer.
+             *
+             * @return true if the producer is ready to send.
+             */
+            virtual bool init() = 0;
+            /**
+             * @brief Send a copy of msg.
+             *
+             * @return true if the message was queued for delivery.
+             */
+            virtual bool send(const std::string &msg) = 0;
+            /**
+             * @brief Send msg without copying it.
+             *
+             * @return true if the message was queued for delivery.
+             */
+            virtual bool send(std::string &&msg) = 0;
+            /**
+             * @brief Send a copy of msg with a key.
+             *
+             * @return true if the message was queued for delivery.
+             */
+            virtual bool send(const std::string &msg, const std::string &key) = 0;
+            /**
+             * @brief Send msg with a key without copying it.
+             *
+             * @return true if the message was queued for delivery.
+             */
+            virtual bool send(std::string &&msg, const std::string &key) = 0;
+            /**
+             * @brief Send msg without copying it, with its pipeline trace in the TRACE_HEADER header.
+             *
+             * @return true if the message was queued for delivery.
+             */
+            virtual bool send(std::string &&msg, const trace_context &trace) = 0;
+            virtual producer_stats get_stats() const = 0;
+            virtual const kafka_client_metrics &get_metrics() const = 0;
+            virtual void stop() = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef KAFKA_TUNING_PROFILE_H
+#define KAFKA_TUNING_PROFILE_H
+
+#include <map>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace kafka_clients
+{
+    /**
+     * @brief librdkafka configuration properties (name to value) applied on top of the worker defaults.
+     */
+    using kafka_properties = std::map<std::string, std::string>;
+
+    // Keep librdkafka defaults
+    const std::string DEFAULT_PROFILE = "default";
+    // Minimize per message latency, e.g. SPaT published at 10 Hz
+    const std::string LOW_LATENCY_PROFILE = "low_latency";
+    // Maximize messages per second at the cost of batching delay, e.g. BSM and MobilityPath ingest
+    const std::string HIGH_THROUGHPUT_PROFILE = "high_throughput";
+
+    /**
+     * @brief Get the librdkafka properties of a named producer tuning profile. The profiles only trade latency for
+     * throughput: broker acknowledgements (acks) are left at the librdkafka default, and the low_latency profile keeps
+     * the default queue.buffering.max.messages so it does not drop more messages on a full queue.
+     *
+     * @param profile profile name (default, low_latency or high_throughput).
+     * @return kafka_properties of the profile. Empty for default or unknown profiles.
+     */
+    kafka_properties get_producer_profile(const std::string &profile);
+    /**
+     * @brief Get the librdkafka properties of a named consumer tuning profile.
+     *
+     * @param profile profile name (default, low_latency or high_throughput).
+     * @return kafka_properties of the profile. Empty for default or unknown profiles.
+     */
+    kafka_properties get_consumer_profile(const std::string &profile);
+    /**
+     * @brief Parse a list of librdkafka properties in the form "name=value;name=value". Whitespace around
+     * names and values is ignored and malformed entries are skipped.
+     *
+     * @param properties string list of properties.
+     * @return kafka_properties parsed properties.
+     */
+    kafka_properties parse_properties(const std::string &properties);
+    /**
+     * @brief Get producer properties for a tuning profile with pass-through overrides applied on top.
+     *
+     * @param profile producer profile name.
+     * @param overrides string list of properties, see parse_properties.
+     * @return kafka_properties merged properties.
+     */
+    kafka_properties get_producer_properties(const std::string &profile, const std::string &overrides);
+    /**
+     * @brief Get consumer properties for a tuning profile with pass-through overrides applied on top.
+     *
+     * @param profile consumer profile name.
+     * @param overrides string list of properties, see parse_properties.
+     * @return kafka_properties merged properties.
+     */
+    kafka_properties get_consumer_properties(const std::string &profile, const std::string &overrides);
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace kafka_clients
+{
+    /**
+     * @brief Lock free histogram of latencies in microseconds using power of two buckets. Bucket i holds values
+     * with a bit length of i, i.e. [2^(i-1), 2^i), so percentiles are reported as the upper bound of the bucket
+     * they fall into. Recording is a single relaxed atomic increment, so it is safe to call from librdkafka
+     * callbacks while other threads read percentiles.
+     */
+    class latency_histogram
+    {
+        public:
+            static constexpr size_t BUCKET_COUNT = 40;
+
+            latency_histogram();
+            latency_histogram(const latency_histogram &) = delete;
+            latency_histogram &operator=(const latency_histogram &) = delete;
+            /**
+             * @brief Record a latency sample.
+             *
+             * @param value_us latency in microseconds.
+             */
+            void record(uint64_t value_us);
+            /**
+             * @brief Number of recorded samples.
+             */
+            uint64_t count() const;
+            /**
+             * @brief Get the latency percentile.
+             *
+             * @param percentile in range [0, 1], e.g. 0.99 for p99.
+             * @return uint64_t upper bound in microseconds of the bucket holding the percentile, 0 if no samples.
+             */
+            uint64_t percentile(double percentile) const;
+            /**
+             * @brief Add the samples of another histogram, e.g. to merge per thread histograms for reporting.
+             *
+             * @param other histogram to add, may be recorded to concurrently.
+             */
+            void add(const latency_histogram &other);
+            /**
+             * @brief Clear all recorded samples.
+             */
+            void reset();
+
+        private:
+            std::array<std::atomic<uint64_t>, BUCKET_COUNT> _buckets;
+            std::atomic<uint64_t> _count;
+            static size_t bucket_index(uint64_t value_us);
+    };
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef PIPELINE_TRACE_H
+#define PIPELINE_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "kafka_message.h"
+#include "latency_histogram.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Stages of the vehicle status and intent pipeline, in pipeline order. The duration of a stage is the time
+     * from the previous reached stage, or from the trace origin for the first stage.
+     */
+    enum class trace_stage : size_t
+    {
+        // message_services: BSM, MobilityOperation or MobilityPath consumed
+        INGEST = 0,
+        // message_services: messages of the vehicle joined
+        JOIN,
+        // message_services: vehicle status and intent composed from the lanelet lookups
+        LANELET_LOOKUP,
+        // message_services: vehicle status and intent serialized
+        SERIALIZE,
+        // message_services: vehicle status and intent handed to the producer
+        PRODUCE,
+        // scheduling_service: vehicle status and intent consumed
+        SCHEDULE_INGEST,
+        // scheduling_service: schedule computed with the vehicle update
+        SCHEDULE,
+        // scheduling_service: schedule serialized
+        SCHEDULE_SERIALIZE,
+        // scheduling_service: schedule handed to the producer
+        SCHEDULE_PRODUCE,
+        // tsc_client_service: desired phase plan consumed
+        TSC_INGEST,
+        // tsc_client_service: desired phase plan applied
+        TSC_UPDATE,
+        COUNT
+    };
+
+    static constexpr size_t TRACE_STAGE_COUNT = static_cast<size_t>(trace_stage::COUNT);
+
+    /**
+     * @brief Name of a stage in logs.
+     */
+    const char *trace_stage_name(trace_stage stage);
+
+    /**
+     * @brief Current system clock time in microseconds since epoch, comparable between services on synchronized hosts.
+     */
+    int64_t trace_now_us();
+
+    /**
+     * @brief Time at which a message reached each pipeline stage. Carried between services in the TRACE_HEADER
+     * message header, so each service adds its stages to the trace of the message it was produced from.
+     */
+    struct trace_context
+    {
+        // Time the first message of the trace was produced, in microseconds since epoch, 0 if unknown
+        int64_t origin_us = 0;
+        // Time each stage was reached, in microseconds since epoch, 0 for stages not reached
+        std::array<int64_t, TRACE_STAGE_COUNT> stage_us{};
+
+        /**
+         * @brief Record that the message reached a stage now.
+         */
+        void mark(trace_stage stage);
+        bool reached(trace_stage stage) const;
+        /**
+         * @brief Encode the trace as a header value: the origin followed by stage index:time pairs of the reached stages.
+         */
+        std::string encode() const;
+        /**
+         * @brief Decode a header value written by encode().
+         *
+         * @return false if the value is malformed, the trace is then left empty.
+         */
+        bool decode(const char *value, size_t length);
+    };
+
+    /**
+     * @brief Start the trace of a consumed message: continue the trace of its TRACE_HEADER header if present, otherwise
+     * start a trace with the message timestamp as origin.
+     *
+     * @param msg consumed message.
+     * @return trace of the message.
+     */
+    trace_context read_trace_context(const kafka_message &msg);
+
+    /**
+     * @brief Process wide per stage latency histograms. Each thread records into its own histograms with relaxed
+     * atomic increments, the histograms of all threads are merged when reporting. A summary is logged every log
+     * interval by the thread recording when it elapses.
+     */
+    class pipeline_trace_metrics
+    {
+        private:
+            struct thread_histograms
+            {
+                // Time from the previous reached stage
+                std::array<latency_histogram, TRACE_STAGE_COUNT> stages;
+                // Time from the trace origin, the end to end latency up to the stage
+                std::array<latency_histogram, TRACE_STAGE_COUNT> since_origin;
+            };
+
+            // Guards thread registration and reporting, never taken when recording
+            mutable std::mutex _threads_mtx;
+            std::vector<std::shared_ptr<thread_histograms>> _threads;
+            std::atomic<int64_t> _log_interval_us{0};
+            std::atomic<int64_t> _next_log_us{0};
+
+            pipeline_trace_metrics() = default;
+            thread_histograms &local();
+            void merge(trace_stage stage, bool since_origin, latency_histogram &merged) const;
+
+        public:
+            pipeline_trace_metrics(const pipeline_trace_metrics &) = delete;
+            pipeline_trace_metrics &operator=(const pipeline_trace_metrics &) = delete;
+
+            static pipeline_trace_metrics &instance();
+
+            /**
+             * @brief Record the reached stages of a trace from first to last: the time from the previous reached stage
+             * and the time from the trace origin.
+             *
+             * @param trace trace of a message.
+             * @param first first stage of the recording service, the earlier stages are recorded by upstream services.
+             * @param last last stage of the recording service.
+             */
+            void record(const trace_context &trace, trace_stage first, trace_stage last);
+            /**
+             * @brief Log a summary every interval, 0 to disable the log.
+             */
+            void set_log_interval_ms(int64_t interval_ms);
+            uint64_t count(trace_stage stage) const;
+            /**
+             * @brief Stage latency percentile over all threads, see latency_histogram::percentile.
+             */
+            uint64_t percentile(trace_stage stage, double percentile) const;
+            /**
+             * @brief Percentile of the time from the trace origin to the stage over all threads.
+             */
+            uint64_t since_origin_percentile(trace_stage stage, double percentile) const;
+            /**
+             * @brief Single line summary of the recorded stages: count, p50 and p99 stage latency and p99 latency since origin.
+             */
+            std::string to_string() const;
+            void reset();
+    };
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "in_memory_topic_bus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        // Empty polls answered with a yield before the consumer starts sleeping
+        const int SPIN_COUNT = 64;
+        const std::chrono::microseconds IDLE_SLEEP(50);
+    }
+
+    in_memory_subscription::in_memory_subscription(size_t capacity) : _queue(capacity)
+    {
+    }
+
+    bool in_memory_subscription::push(std::shared_ptr<const in_memory_record> record)
+    {
+        return _queue.try_push(std::move(record));
+    }
+
+    bool in_memory_subscription::pop(std::shared_ptr<const in_memory_record> &record, int timeout_ms)
+    {
+        if (_queue.try_pop(record))
+        {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        int spins = 0;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (spins < SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                spins++;
+            }
+            else
+            {
+                std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+            if (_queue.try_pop(record))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    in_memory_topic::in_memory_topic(const std::string &name) : _name(name), _subscribers(std::make_shared<subscriber_list>())
+    {
+    }
+
+    const std::string &in_memory_topic::get_name() const
+    {
+        return _name;
+    }
+
+    bool in_memory_topic::publish(std::string &&payload, const std::string &key, const std::string &trace)
+    {
+        auto subscribers = std::atomic_load(&_subscribers);
+        auto record = std::make_shared<in_memory_record>();
+        record->topic = _name;
+        record->key = key;
+        record->payload = std::move(payload);
+        record->trace = trace;
+        record->offset = _next_offset.fetch_add(1, std::memory_order_relaxed);
+        record->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        std::shared_ptr<const in_memory_record> shared_record(std::move(record));
+        bool delivered = true;
+        for (const auto &subscriber : *subscribers)
+        {
+            delivered = subscriber->push(shared_record) && delivered;
+        }
+        return delivered;
+    }
+
+    void in_memory_topic::add_subscriber(const std::shared_ptr<in_memory_subscription> &subscription)
+    {
+        auto subscribers = std::make_shared<subscriber_list>(*std::atomic_load(&_subscribers));
+        subscribers->push_back(subscription);
+        std::atomic_store(&_subscribers, std::shared_ptr<const subscriber_list>(std::move(subscribers)));
+    }
+
+    void in_memory_topic::remove_subscriber(const std::shared_ptr<in_memory_subscription> &subscription)
+    {
+        auto subscribers = std::make_shared<subscriber_list>(*std::atomic_load(&_subscribers));
+        subscribers->erase(std::remove(subscribers->begin(), subscribers->end(), subscription), subscribers->end());
+        std::atomic_store(&_subscribers, std::shared_ptr<const subscriber_list>(std::move(subscribers)));
+    }
+
+    std::shared_ptr<in_memory_topic_bus> in_memory_topic_bus::get_default()
+    {
+        static auto bus = std::make_shared<in_memory_topic_bus>();
+        return bus;
+    }
+
+    std::shared_ptr<in_memory_topic> in_memory_topic_bus::get_topic(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lck(_topics_mtx);
+        auto &topic = _topics[name];
+        if (!topic)
+        {
+            topic = std::make_shared<in_memory_topic>(name);
+        }
+        return topic;
+    }
+
+    std::shared_ptr<in_memory_subscription> in_memory_topic_bus::subscribe(const std::vector<std::string> &topics, size_t capacity)
+    {
+        auto subscription = std::make_shared<in_memory_subscription>(capacity);
+        for (const auto &name : topics)
+        {
+            // add/remove_subscriber copy-on-write must not race with each other
+            auto topic = get_topic(name);
+            std::lock_guard<std::mutex> lck(_topics_mtx);
+            topic->add_subscriber(subscription);
+        }
+        return subscription;
+    }
+
+    void in_memory_topic_bus::unsubscribe(const std::shared_ptr<in_memory_subscription> &subscription)
+    {
+        std::lock_guard<std::mutex> lck(_topics_mtx);
+        for (auto &topic : _topics)
+        {
+            topic.second->remove_subscriber(subscription);
+        }
+    }
+}
@@ -0,0 +1,187 @@
+#include "in_memory_transport.h"
+
+#include <chrono>
+
+namespace kafka_clients
+{
+    transport_type parse_transport_type(const std::string &transport)
+    {
+        if (transport == IN_MEMORY_TRANSPORT)
+        {
+            return transport_type::IN_MEMORY;
+        }
+        if (transport != KAFKA_TRANSPORT && !transport.empty())
+        {
+            SPDLOG_ERROR("Unknown message transport {0}, using kafka!", transport);
+        }
+        return transport_type::KAFKA;
+    }
+
+    in_memory_consumer_worker::in_memory_consumer_worker(std::shared_ptr<in_memory_topic_bus> bus, const std::vector<std::string> &topics,
+                                                         const std::string &group_id)
+        : _bus(std::move(bus)), _topics(topics), _group_id(group_id)
+    {
+    }
+
+    in_memory_consumer_worker::~in_memory_consumer_worker()
+    {
+        stop();
+    }
+
+    bool in_memory_consumer_worker::init()
+    {
+        if (!_bus || _topics.empty())
+        {
+            SPDLOG_CRITICAL("In memory consumer requires a topic bus and at least one topic");
+            return false;
+        }
+        return true;
+    }
+
+    void in_memory_consumer_worker::subscribe()
+    {
+        std::atomic_store(&_subscription, _bus->subscribe(_topics));
+        _run = true;
+        SPDLOG_INFO("In memory consumer of group {0} subscribed to {1} topics", _group_id, _topics.size());
+    }
+
+    kafka_message in_memory_consumer_worker::consume_message(int timeout_ms)
+    {
+        std::shared_ptr<const in_memory_record> record;
+        // Pop from a local copy so a concurrent stop() can not release the subscription while blocked in pop()
+        auto subscription = std::atomic_load(&_subscription);
+        if (!_run || !subscription || !subscription->pop(record, timeout_ms))
+        {
+            return kafka_message();
+        }
+        _metrics.record_consume(record->payload.size(), record->timestamp);
+        return kafka_message(std::move(record));
+    }
+
+    std::string in_memory_consumer_worker::consume(int timeout_ms)
+    {
+        return consume_message(timeout_ms).to_string();
+    }
+
+    size_t in_memory_consumer_worker::consume_batch(std::vector<kafka_message> &batch, size_t max_messages, int timeout_ms)
+    {
+        batch.clear();
+        // Block for the first record only, then drain what is already queued
+        int remaining_ms = timeout_ms;
+        while (batch.size() < max_messages)
+        {
+            auto msg = consume_message(remaining_ms);
+            if (msg.empty())
+            {
+                break;
+            }
+            batch.push_back(std::move(msg));
+            remaining_ms = 0;
+        }
+        return batch.size();
+    }
+
+    void in_memory_consumer_worker::stop()
+    {
+        _run = false;
+        auto subscription = std::atomic_exchange(&_subscription, std::shared_ptr<in_memory_subscription>());
+        if (subscription)
+        {
+            _bus->unsubscribe(subscription);
+        }
+    }
+
+    bool in_memory_consumer_worker::is_running() const
+    {
+        return _run;
+    }
+
+    const std::vector<std::string> &in_memory_consumer_worker::get_topics() const
+    {
+        return _topics;
+    }
+
+    const kafka_client_metrics &in_memory_consumer_worker::get_metrics() const
+    {
+        return _metrics;
+    }
+
+    in_memory_producer_worker::in_memory_producer_worker(std::shared_ptr<in_memory_topic_bus> bus, const std::string &topic)
+        : _bus(std::move(bus)), _topic_name(topic)
+    {
+    }
+
+    bool in_memory_producer_worker::init()
+    {
+        if (!_bus)
+        {
+            SPDLOG_CRITICAL("In memory producer requires a topic bus");
+            return false;
+        }
+        _topic = _bus->get_topic(_topic_name);
+        _run = true;
+        return true;
+    }
+
+    bool in_memory_producer_worker::publish(std::string &&msg, const std::string &key, const std::string &trace)
+    {
+        if (!_run || msg.empty())
+            return false;
+        bool delivered = _topic->publish(std::move(msg), key, trace);
+        _metrics.record_produce(delivered);
+        if (delivered)
+        {
+            _metrics.record_delivery(true, 0);
+        }
+        else
+        {
+            SPDLOG_ERROR("In memory topic {0} dropped a message for a full subscriber queue", _topic_name);
+        }
+        return delivered;
+    }
+
+    bool in_memory_producer_worker::send(const std::string &msg)
+    {
+        return publish(std::string(msg), "", "");
+    }
+
+    bool in_memory_producer_worker::send(std::string &&msg)
+    {
+        return publish(std::move(msg), "", "");
+    }
+
+    bool in_memory_producer_worker::send(const std::string &msg, const std::string &key)
+    {
+        return publish(std::string(msg), key, "");
+    }
+
+    bool in_memory_producer_worker::send(std::string &&msg, const std::string &key)
+    {
+        return publish(std::move(msg), key, "");
+    }
+
+    bool in_memory_producer_worker::send(std::string &&msg, const trace_context &trace)
+    {
+        return publish(std::move(msg), "", trace.encode());
+    }
+
+    producer_stats in_memory_producer_worker::get_stats() const
+    {
+        producer_stats stats;
+        stats.queued = _metrics.get_queued();
+        stats.delivered = _metrics.get_delivered();
+        stats.failed = _metrics.get_failed();
+        stats.p99_delivery_latency_us = _metrics.get_delivery_latency().percentile(0.99);
+        return stats;
+    }
+
+    const kafka_client_metrics &in_memory_producer_worker::get_metrics() const
+    {
+        return _metrics;
+    }
+
+    void in_memory_producer_worker::stop()
+    {
+        _run = false;
+    }
+}
@@ -2,6 +2,11 @@
 
 namespace kafka_clients
 {
+    kafka_client::kafka_client(transport_type transport, std::shared_ptr<in_memory_topic_bus> bus)
+        : _transport(transport), _bus(bus ? std::move(bus) : in_memory_topic_bus::get_default())
+    {
+    }
+
     std::shared_ptr<kafka_clients::kafka_consumer_worker> kafka_client::create_consumer(const std::string &bootstrap_server, const std::string &topic_str,
                                                                                         std::string &group_id_str) const
     {
@@ -37,4 +42,58 @@ namespace kafka_clients
     }
 
 
-}
\ No newline at end of file
+    std::shared_ptr<kafka_clients::kafka_consumer_worker> kafka_client::create_consumer(const std::string &bootstrap_server, const std::string &topic_str,
+                                                                                        std::string &group_id_str, const kafka_properties &properties) const
+    {
+        auto consumer_ptr = create_consumer(bootstrap_server, topic_str, group_id_str);
+        consumer_ptr->set_properties(properties);
+        return consumer_ptr;
+    }
+
+    std::shared_ptr<kafka_clients::kafka_consumer_worker> kafka_client::create_consumer(const std::string &bootstrap_server, const std::vector<std::string> &topics,
+                                                                                        const std::string &group_id_str, const kafka_properties &properties) const
+    {
+        try
+        {
+            int partition = 0;
+            int64_t cur_offset = RdKafka::Topic::OFFSET_END;
+            auto consumer_ptr = std::make_shared<kafka_clients::kafka_consumer_worker>(bootstrap_server, topics, group_id_str, cur_offset, partition);
+            consumer_ptr->set_properties(properties);
+            return consumer_ptr;
+        }
+        catch (...)
+        {
+            std::exception_ptr p = std::current_exception();
+            SPDLOG_CRITICAL("Create consumer failure: {0}", (p ? p.__cxa_exception_type()->name() : "null"));
+            exit(1);
+        }
+    }
+
+    std::shared_ptr<kafka_clients::kafka_producer_worker> kafka_client::create_producer(const std::string &bootstrap_server, const std::string &topic_str,
+                                                                                        const kafka_properties &properties) const
+    {
+        auto producer_ptr = create_producer(bootstrap_server, topic_str);
+        producer_ptr->set_properties(properties);
+        return producer_ptr;
+    }
+
+    std::shared_ptr<kafka_clients::consumer_transport> kafka_client::create_consumer_transport(const std::string &bootstrap_server, const std::vector<std::string> &topics,
+                                                                                               const std::string &group_id_str, const kafka_properties &properties) const
+    {
+        if (_transport == transport_type::IN_MEMORY)
+        {
+            return std::make_shared<kafka_clients::in_memory_consumer_worker>(_bus, topics, group_id_str);
+        }
+        return create_consumer(bootstrap_server, topics, group_id_str, properties);
+    }
+
+    std::shared_ptr<kafka_clients::producer_transport> kafka_client::create_producer_transport(const std::string &bootstrap_server, const std::string &topic_str,
+                                                                                               const kafka_properties &properties) const
+    {
+        if (_transport == transport_type::IN_MEMORY)
+        {
+            return std::make_shared<kafka_clients::in_memory_producer_worker>(_bus, topic_str);
+        }
+        return create_producer(bootstrap_server, topic_str, properties);
+    }
+}
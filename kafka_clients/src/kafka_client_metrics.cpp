@@ -0,0 +1,193 @@
+#include "kafka_client_metrics.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <rapidjson/document.h>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        int64_t get_int64(const rapidjson::Value &obj, const char *key)
+        {
+            auto itr = obj.FindMember(key);
+            if (itr == obj.MemberEnd() || !itr->value.IsInt64())
+            {
+                return 0;
+            }
+            return itr->value.GetInt64();
+        }
+    }
+
+    void kafka_client_metrics::record_produce(bool accepted)
+    {
+        if (accepted)
+        {
+            _queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            _failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void kafka_client_metrics::record_delivery(bool delivered, int64_t latency_us)
+    {
+        if (!delivered)
+        {
+            _failed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _delivered.fetch_add(1, std::memory_order_relaxed);
+        if (latency_us >= 0)
+        {
+            _delivery_latency.record(static_cast<uint64_t>(latency_us));
+        }
+    }
+
+    void kafka_client_metrics::record_consume(size_t bytes, int64_t timestamp_ms)
+    {
+        _consumed.fetch_add(1, std::memory_order_relaxed);
+        _consumed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (timestamp_ms > 0)
+        {
+            auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            // Clocks of producer and consumer hosts may be skewed, ignore messages from the future.
+            if (now_ms >= timestamp_ms)
+            {
+                _end_to_end_latency.record(static_cast<uint64_t>(now_ms - timestamp_ms) * 1000);
+            }
+        }
+    }
+
+    bool kafka_client_metrics::update_statistics(const std::string &json)
+    {
+        rapidjson::Document doc;
+        doc.Parse(json.c_str(), json.size());
+        if (doc.HasParseError() || !doc.IsObject())
+        {
+            SPDLOG_ERROR("Failed to parse librdkafka statistics: parse error {0} at offset {1}", doc.GetParseError(), doc.GetErrorOffset());
+            return false;
+        }
+        kafka_statistics statistics;
+        statistics.timestamp_us = get_int64(doc, "ts");
+        statistics.messages_in = get_int64(doc, "rxmsgs");
+        statistics.bytes_in = get_int64(doc, "rxmsg_bytes");
+        statistics.messages_out = get_int64(doc, "txmsgs");
+        statistics.bytes_out = get_int64(doc, "txmsg_bytes");
+        statistics.queue_depth = get_int64(doc, "msg_cnt");
+        statistics.reply_queue_depth = get_int64(doc, "replyq");
+
+        auto topics = doc.FindMember("topics");
+        if (topics != doc.MemberEnd() && topics->value.IsObject())
+        {
+            for (const auto &topic : topics->value.GetObject())
+            {
+                auto partitions = topic.value.FindMember("partitions");
+                if (partitions == topic.value.MemberEnd() || !partitions->value.IsObject())
+                {
+                    continue;
+                }
+                for (const auto &partition : partitions->value.GetObject())
+                {
+                    auto partition_id = static_cast<int32_t>(std::strtol(partition.name.GetString(), nullptr, 10));
+                    // Partition -1 is librdkafka's internal unassigned partition
+                    if (partition_id < 0 || !partition.value.IsObject())
+                    {
+                        continue;
+                    }
+                    partition_statistics partition_stats;
+                    partition_stats.topic = topic.name.GetString();
+                    partition_stats.partition = partition_id;
+                    auto lag = partition.value.FindMember("consumer_lag");
+                    partition_stats.consumer_lag = (lag != partition.value.MemberEnd() && lag->value.IsInt64()) ? lag->value.GetInt64() : -1;
+                    partition_stats.fetch_queue_depth = get_int64(partition.value, "fetchq_cnt");
+                    partition_stats.message_queue_depth = get_int64(partition.value, "msgq_cnt") + get_int64(partition.value, "xmit_msgq_cnt");
+                    statistics.partitions.push_back(partition_stats);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lck(_statistics_mtx);
+        auto name = doc.FindMember("name");
+        if (name != doc.MemberEnd() && name->value.IsString())
+        {
+            _name = name->value.GetString();
+        }
+        _statistics = std::move(statistics);
+        return true;
+    }
+
+    uint64_t kafka_client_metrics::get_queued() const
+    {
+        return _queued.load(std::memory_order_relaxed);
+    }
+
+    uint64_t kafka_client_metrics::get_delivered() const
+    {
+        return _delivered.load(std::memory_order_relaxed);
+    }
+
+    uint64_t kafka_client_metrics::get_failed() const
+    {
+        return _failed.load(std::memory_order_relaxed);
+    }
+
+    uint64_t kafka_client_metrics::get_consumed() const
+    {
+        return _consumed.load(std::memory_order_relaxed);
+    }
+
+    uint64_t kafka_client_metrics::get_consumed_bytes() const
+    {
+        return _consumed_bytes.load(std::memory_order_relaxed);
+    }
+
+    const latency_histogram &kafka_client_metrics::get_delivery_latency() const
+    {
+        return _delivery_latency;
+    }
+
+    const latency_histogram &kafka_client_metrics::get_end_to_end_latency() const
+    {
+        return _end_to_end_latency;
+    }
+
+    kafka_statistics kafka_client_metrics::get_statistics() const
+    {
+        std::lock_guard<std::mutex> lck(_statistics_mtx);
+        return _statistics;
+    }
+
+    int64_t kafka_client_metrics::get_max_consumer_lag() const
+    {
+        std::lock_guard<std::mutex> lck(_statistics_mtx);
+        int64_t max_lag = -1;
+        for (const auto &partition : _statistics.partitions)
+        {
+            if (partition.consumer_lag > max_lag)
+            {
+                max_lag = partition.consumer_lag;
+            }
+        }
+        return max_lag;
+    }
+
+    std::string kafka_client_metrics::to_string() const
+    {
+        auto max_lag = get_max_consumer_lag();
+        std::lock_guard<std::mutex> lck(_statistics_mtx);
+        int64_t fetch_queue_depth = 0;
+        for (const auto &partition : _statistics.partitions)
+        {
+            fetch_queue_depth += partition.fetch_queue_depth;
+        }
+        return fmt::format("{0}: in {1} msgs / {2} bytes, out {3} msgs / {4} bytes, queued {5}, delivered {6}, failed {7}, "
+                           "consumed {8}, queue depth {9}, fetch queue depth {10}, reply queue depth {11}, max consumer lag {12}, "
+                           "p99 delivery latency {13} us, p99 end to end latency {14} us",
+                           _name.empty() ? "UNKNOWN" : _name, _statistics.messages_in, _statistics.bytes_in, _statistics.messages_out,
+                           _statistics.bytes_out, get_queued(), get_delivered(), get_failed(), get_consumed(), _statistics.queue_depth,
+                           fetch_queue_depth, _statistics.reply_queue_depth, max_lag, _delivery_latency.percentile(0.99),
+                           _end_to_end_latency.percentile(0.99));
+    }
+}
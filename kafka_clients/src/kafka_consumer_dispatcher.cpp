@@ -0,0 +1,52 @@
+#include "kafka_consumer_dispatcher.h"
+
+namespace kafka_clients
+{
+    kafka_consumer_dispatcher::kafka_consumer_dispatcher(std::shared_ptr<consumer_transport> consumer) : _consumer(std::move(consumer))
+    {
+    }
+
+    void kafka_consumer_dispatcher::register_handler(const std::string &topic, kafka_message_handler handler)
+    {
+        _handlers[topic] = std::move(handler);
+    }
+
+    size_t kafka_consumer_dispatcher::dispatch(size_t max_messages, int timeout_ms)
+    {
+        if (!_consumer)
+        {
+            SPDLOG_CRITICAL("Kafka consumer dispatcher has no consumer");
+            return 0;
+        }
+        size_t dispatched = 0;
+        _consumer->consume_batch(_batch, max_messages, timeout_ms);
+        for (const auto &msg : _batch)
+        {
+            auto handler = _handlers.find(msg.topic());
+            if (handler == _handlers.end())
+            {
+                SPDLOG_DEBUG("No handler registered for topic {0}, dropping message at offset {1}", msg.topic(), msg.offset());
+                continue;
+            }
+            try
+            {
+                handler->second(msg);
+                dispatched++;
+            }
+            catch (const std::exception &ex)
+            {
+                SPDLOG_ERROR("Handler for topic {0} failed: {1}", handler->first, ex.what());
+            }
+        }
+        _batch.clear();
+        return dispatched;
+    }
+
+    void kafka_consumer_dispatcher::run(size_t max_messages, int timeout_ms)
+    {
+        while (_consumer && _consumer->is_running())
+        {
+            dispatch(max_messages, timeout_ms);
+        }
+    }
+}
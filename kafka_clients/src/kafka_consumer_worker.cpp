@@ -5,15 +5,37 @@ namespace kafka_clients
 
     kafka_consumer_worker::kafka_consumer_worker(const std::string &broker_str, const std::string &topic_str,
                                                  const std::string &group_id_str, int64_t cur_offset, int32_t partition)
-        :_topics_str(topic_str), _broker_str(broker_str), _group_id_str(group_id_str), _cur_offet(cur_offset),
+        :_topics_str(topic_str), _topics_list{topic_str}, _broker_str(broker_str), _group_id_str(group_id_str), _cur_offet(cur_offset),
           _partition(partition)
     {
     }
 
+    kafka_consumer_worker::kafka_consumer_worker(const std::string &broker_str, const std::vector<std::string> &topics,
+                                                 const std::string &group_id_str, int64_t cur_offset, int32_t partition)
+        :_topics_list(topics), _broker_str(broker_str), _group_id_str(group_id_str), _cur_offet(cur_offset),
+          _partition(partition)
+    {
+        for (const auto &topic : _topics_list)
+        {
+            _topics_str += _topics_str.empty() ? topic : "," + topic;
+        }
+    }
+
+    void kafka_consumer_worker::set_properties(const kafka_properties &properties)
+    {
+        _properties = properties;
+    }
+
     bool kafka_consumer_worker::init()
     {
         SPDLOG_INFO("kafka_consumer_worker init()... ");
 
+        if (_topics_list.empty())
+        {
+            SPDLOG_CRITICAL("RDKafka consumer has no topics to subscribe to ");
+            return false;
+        }
+
         std::string errstr;
         RdKafka::Conf *conf = RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL);
         if (!conf)
@@ -55,6 +77,23 @@ namespace kafka_clients
             SPDLOG_CRITICAL("RDKafka cof set max.partition failed:  {0} ", errstr.c_str());
         }
 
+        if (conf->set(STATISTICS_INTERVAL, STR_STATISTICS_INTERVAL_MS, errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RDKafka conf set statistics interval failed:  {0} ", errstr.c_str());
+            return false;
+        }
+
+        // apply tuning profile and pass-through properties
+        for (const auto &property : _properties)
+        {
+            if (conf->set(property.first, property.second, errstr) != RdKafka::Conf::CONF_OK)
+            {
+                SPDLOG_CRITICAL("RDKafka conf set {0}={1} failed:  {2} ", property.first, property.second, errstr.c_str());
+                return false;
+            }
+            SPDLOG_INFO("RDKafka conf set {0}={1}", property.first, property.second);
+        }
+
         // create consumer
         _consumer = RdKafka::KafkaConsumer::create(conf, errstr);
         if (!_consumer)
@@ -74,7 +113,7 @@ namespace kafka_clients
             return false;
         }
 
-        _topic = RdKafka::Topic::create(_consumer, _topics_str, tconf, errstr);
+        _topic = RdKafka::Topic::create(_consumer, _topics_list.front(), tconf, errstr);
         if (!_topic)
         {
             SPDLOG_CRITICAL("RDKafka create topic failed:  {0}", errstr.c_str());
@@ -95,50 +134,111 @@ namespace kafka_clients
 
     void kafka_consumer_worker::subscribe()
     {
-        std::vector<std::string> _topics_str_list;
-        _topics_str_list.push_back(_topics_str);
-        RdKafka::ErrorCode err = _consumer->subscribe(_topics_str_list);
+        RdKafka::ErrorCode err = _consumer->subscribe(_topics_list);
         if (err)
         {
-            SPDLOG_CRITICAL(" {0} Failed to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_str_list.size(), RdKafka::err2str(err).c_str());
+            SPDLOG_CRITICAL(" {0} Failed to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_list.size(), RdKafka::err2str(err).c_str());
             _run = false;
             exit(1);
         } else {
-            SPDLOG_INFO("{0} Successfully to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_str_list.size(), RdKafka::err2str(err).c_str());
+            SPDLOG_INFO("{0} Successfully to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_list.size(), RdKafka::err2str(err).c_str());
             _run = true;
         }
     }
 
-    const char *kafka_consumer_worker::consume(int timeout_ms)
+    kafka_message kafka_consumer_worker::consume_message(int timeout_ms)
     {
-        RdKafka::Message *msg = nullptr;
-        msg = _consumer->consume(timeout_ms);
-        const char *msg_str = msg_consume(msg, nullptr);
-        return msg_str;
+        RdKafka::Message *message = _consumer->consume(timeout_ms);
+        kafka_message msg(message);
+        if (!msg_consume(message))
+        {
+            return kafka_message();
+        }
+        SPDLOG_TRACE(" {0} Message Consumed at offset {1}: {2}   bytes ):  {3}", _consumer->name(), msg.offset(), static_cast<int>(msg.length()),
+                     spdlog::string_view_t(msg.payload(), msg.length()));
+        return msg;
+    }
+
+    size_t kafka_consumer_worker::consume_batch(std::vector<kafka_message> &batch, size_t max_messages, int timeout_ms)
+    {
+        batch.clear();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        int remaining_ms = timeout_ms;
+        while (_run && batch.size() < max_messages)
+        {
+            RdKafka::Message *message = _consumer->consume(remaining_ms);
+            kafka_message msg(message);
+            if (message->err() == RdKafka::ERR__TIMED_OUT)
+            {
+                break;
+            }
+            if (msg_consume(message) && !msg.empty())
+            {
+                batch.push_back(std::move(msg));
+            }
+            // Block until the first message arrives, then only drain messages already fetched by librdkafka.
+            if (batch.empty())
+            {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                remaining_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+            else
+            {
+                remaining_ms = 0;
+            }
+        }
+        if (!batch.empty())
+        {
+            SPDLOG_TRACE(" {0} Consumed batch of {1} messages, last offset {2}", _consumer->name(), batch.size(), _last_offset);
+        }
+        return batch.size();
+    }
+
+    std::vector<kafka_message> kafka_consumer_worker::consume_batch(size_t max_messages, int timeout_ms)
+    {
+        std::vector<kafka_message> batch;
+        batch.reserve(max_messages);
+        consume_batch(batch, max_messages, timeout_ms);
+        return batch;
+    }
+
+    std::string kafka_consumer_worker::consume(int timeout_ms)
+    {
+        return consume_message(timeout_ms).to_string();
     }
 
     bool kafka_consumer_worker::is_running() const
     {
         return _run;
     }
+
+    const std::vector<std::string> &kafka_consumer_worker::get_topics() const
+    {
+        return _topics_list;
+    }
+
+    const kafka_client_metrics &kafka_consumer_worker::get_metrics() const
+    {
+        return _metrics;
+    }
     void kafka_consumer_worker::printCurrConf()
     {
         SPDLOG_INFO("Consumer connect to bootstrap_server: {0} , topic:  {1} , partition:  {2}, group id: {3} ",
                      (_broker_str.empty() ? "UNKNOWN" : _broker_str), (_topics_str.empty() ? "UNKNOWN" : _topics_str), _partition, (_group_id_str.empty() ? "UNKNOWN" : _group_id_str));
     }
 
-    const char *kafka_consumer_worker::msg_consume(RdKafka::Message *message, void *opaque)
+    bool kafka_consumer_worker::msg_consume(const RdKafka::Message *message)
     {
-        const char *return_msg_str = "";
+        bool has_payload = false;
         switch (message->err())
         {
         case RdKafka::ERR__TIMED_OUT:
             break;
         case RdKafka::ERR_NO_ERROR:
-            SPDLOG_TRACE(" {0} Read message at offset {1} ", _consumer->name(), message->offset());
-            SPDLOG_TRACE(" {0} Message Consumed: {1}   bytes ):  {2}", _consumer->name(), static_cast<int>(message->len()), static_cast<const char *>(message->payload()));
             _last_offset = message->offset();
-            return_msg_str = static_cast<const char *>(message->payload());
+            has_payload = true;
+            _metrics.record_consume(message->len(),
+                                    message->timestamp().type == RdKafka::MessageTimestamp::MSG_TIMESTAMP_NOT_AVAILABLE ? -1 : message->timestamp().timestamp);
             break;
         case RdKafka::ERR__PARTITION_EOF:
             SPDLOG_TRACE("{0} Reached the end of the queue, offset : {1}", _consumer->name(), _last_offset);
@@ -155,6 +255,6 @@ namespace kafka_clients
             stop();
             break;
         }
-        return return_msg_str;
+        return has_payload;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,126 @@
+#include "kafka_message.h"
+
+namespace kafka_clients
+{
+    kafka_message::kafka_message(RdKafka::Message *message) : _message(message)
+    {
+    }
+
+    kafka_message::kafka_message(std::shared_ptr<const in_memory_record> record) : _record(std::move(record))
+    {
+    }
+
+    bool kafka_message::empty() const
+    {
+        return length() == 0 || payload() == nullptr;
+    }
+
+    const char *kafka_message::payload() const
+    {
+        if (_record)
+        {
+            return _record->payload.data();
+        }
+        return _message ? static_cast<const char *>(_message->payload()) : nullptr;
+    }
+
+    size_t kafka_message::length() const
+    {
+        if (_record)
+        {
+            return _record->payload.size();
+        }
+        return _message ? _message->len() : 0;
+    }
+
+    const char *kafka_message::key() const
+    {
+        if (_record)
+        {
+            return _record->key.empty() ? nullptr : _record->key.data();
+        }
+        return _message ? static_cast<const char *>(_message->key_pointer()) : nullptr;
+    }
+
+    size_t kafka_message::key_length() const
+    {
+        if (_record)
+        {
+            return _record->key.size();
+        }
+        return _message ? _message->key_len() : 0;
+    }
+
+    std::string kafka_message::topic() const
+    {
+        if (_record)
+        {
+            return _record->topic;
+        }
+        return _message ? _message->topic_name() : "";
+    }
+
+    int64_t kafka_message::offset() const
+    {
+        if (_record)
+        {
+            return _record->offset;
+        }
+        return _message ? _message->offset() : RdKafka::Topic::OFFSET_INVALID;
+    }
+
+    int32_t kafka_message::partition() const
+    {
+        if (_record)
+        {
+            return 0;
+        }
+        return _message ? _message->partition() : RdKafka::Topic::PARTITION_UA;
+    }
+
+    int64_t kafka_message::timestamp() const
+    {
+        if (_record)
+        {
+            return _record->timestamp;
+        }
+        if (!_message || _message->timestamp().type == RdKafka::MessageTimestamp::MSG_TIMESTAMP_NOT_AVAILABLE)
+        {
+            return -1;
+        }
+        return _message->timestamp().timestamp;
+    }
+
+    RdKafka::Headers *kafka_message::headers() const
+    {
+        return _message ? _message->headers() : nullptr;
+    }
+
+    std::string kafka_message::trace() const
+    {
+        if (_record)
+        {
+            return _record->trace;
+        }
+        RdKafka::Headers *message_headers = headers();
+        if (!message_headers)
+        {
+            return "";
+        }
+        RdKafka::Headers::Header header = message_headers->get_last(TRACE_HEADER);
+        if (header.err() != RdKafka::ERR_NO_ERROR || !header.value())
+        {
+            return "";
+        }
+        return std::string(static_cast<const char *>(header.value()), header.value_size());
+    }
+
+    std::string kafka_message::to_string() const
+    {
+        if (empty())
+        {
+            return "";
+        }
+        return std::string(payload(), length());
+    }
+}
@@ -2,12 +2,39 @@
 #include "kafka_producer_worker.h"
 namespace kafka_clients
 {
+    void producer_delivery_report_cb::dr_cb(RdKafka::Message &message)
+    {
+        SPDLOG_TRACE("Message dellivery for:  {0} bytes [ {1} ]",message.len(), message.errstr().c_str());
+        if (message.err() != RdKafka::ERR_NO_ERROR)
+        {
+            SPDLOG_ERROR("Message delivery failed: {0}", message.errstr());
+        }
+        _metrics.record_delivery(message.err() == RdKafka::ERR_NO_ERROR, message.latency());
+        // Payload buffer owned by the producer, see kafka_producer_worker::send(std::string &&)
+        delete static_cast<std::string *>(message.msg_opaque());
+    }
+
     kafka_producer_worker::kafka_producer_worker(const std::string &brokers, const std::string &topics, int partition)
         : _topics_str(topics), _broker_str(brokers), _run(true), _partition(partition)
     {
         SPDLOG_INFO("kafka_producer_worker init()... ");
     }
 
+    kafka_producer_worker::~kafka_producer_worker()
+    {
+        _run = false;
+        if (_poll_thread.joinable())
+        {
+            _poll_thread.join();
+        }
+        purge_undelivered();
+    }
+
+    void kafka_producer_worker::set_properties(const kafka_properties &properties)
+    {
+        _properties = properties;
+    }
+
     bool kafka_producer_worker::init()
     {
         std::string errstr = "";
@@ -40,6 +67,23 @@ namespace kafka_clients
             return false;
         }
 
+        if (conf->set(STATISTICS_INTERVAL, STR_STATISTICS_INTERVAL_MS, errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RdKafka conf set statistics interval failed: {0} ", errstr.c_str());
+            return false;
+        }
+
+        // apply tuning profile and pass-through properties
+        for (const auto &property : _properties)
+        {
+            if (conf->set(property.first, property.second, errstr) != RdKafka::Conf::CONF_OK)
+            {
+                SPDLOG_CRITICAL("RdKafka conf set {0}={1} failed: {2} ", property.first, property.second, errstr.c_str());
+                return false;
+            }
+            SPDLOG_INFO("RdKafka conf set {0}={1}", property.first, property.second);
+        }
+
         // create producer using accumulated global configuration.
         _producer = RdKafka::Producer::create(conf, errstr);
         if (!_producer)
@@ -61,70 +105,142 @@ namespace kafka_clients
         }
         delete tconf;
         printCurrConf();
+        // Serve delivery reports from a dedicated thread so send() never blocks on the broker.
+        _poll_thread = std::thread(&kafka_producer_worker::poll_loop, this);
         return true;
     }
 
-    void kafka_producer_worker::send(const std::string &msg)
+    void kafka_producer_worker::poll_loop()
     {
+        while (_run)
+        {
+            _producer->poll(POLL_TIMEOUT_MS);
+        }
+    }
 
-        if (!_run)
+    void kafka_producer_worker::purge_undelivered()
+    {
+        if (!_producer || _producer->outq_len() == 0)
+        {
             return;
+        }
+        SPDLOG_INFO("  {0} {1} message(s) were not delivered  ", _producer->name(), _producer->outq_len());
+        _producer->purge(RdKafka::Producer::PURGE_QUEUE | RdKafka::Producer::PURGE_INFLIGHT);
+        // Purged messages fail with ERR__PURGE_QUEUE/ERR__PURGE_INFLIGHT, flush() polls their delivery reports to dr_cb
+        _producer->flush(POLL_TIMEOUT_MS);
+    }
 
-        if (msg.empty())
+    bool kafka_producer_worker::send(const std::string &msg)
+    {
+        if (!_run || msg.empty())
+            return false;
+        return produce(msg.c_str(), msg.size(), RdKafka::Producer::RK_MSG_COPY, nullptr, nullptr, nullptr);
+    }
+
+    bool kafka_producer_worker::send(std::string &&msg)
+    {
+        if (!_run || msg.empty())
+            return false;
+        auto owned_msg = new std::string(std::move(msg));
+        if (!produce(owned_msg->c_str(), owned_msg->size(), 0, nullptr, nullptr, owned_msg))
         {
-            _producer->poll(0);
-            return;
+            delete owned_msg;
+            return false;
+        }
+        return true;
+    }
+
+    bool kafka_producer_worker::send(const std::string &msg, const std::string &key)
+    {
+        if (!_run || msg.empty())
+            return false;
+        return produce(msg.c_str(), msg.size(), RdKafka::Producer::RK_MSG_COPY, &key, nullptr, nullptr);
+    }
+
+    bool kafka_producer_worker::send(std::string &&msg, const std::string &key)
+    {
+        if (!_run || msg.empty())
+            return false;
+        auto owned_msg = new std::string(std::move(msg));
+        if (!produce(owned_msg->c_str(), owned_msg->size(), 0, &key, nullptr, owned_msg))
+        {
+            delete owned_msg;
+            return false;
         }
+        return true;
+    }
 
-        // produce messages
-        while (true)
+    bool kafka_producer_worker::send(std::string &&msg, const trace_context &trace)
+    {
+        if (!_run || msg.empty())
+            return false;
+        RdKafka::Headers *headers = RdKafka::Headers::create();
+        headers->add(TRACE_HEADER, trace.encode());
+        auto owned_msg = new std::string(std::move(msg));
+        if (!produce(owned_msg->c_str(), owned_msg->size(), 0, nullptr, headers, owned_msg))
         {
-            RdKafka::ErrorCode resp = _producer->produce(_topic,
-                                                         _partition,
-                                                         RdKafka::Producer::RK_MSG_COPY,
-                                                         const_cast<char *>(msg.c_str()),
-                                                         msg.size(),
-                                                         NULL,
-                                                         NULL);
-            if (resp != RdKafka::ERR_NO_ERROR)
-            {
-                SPDLOG_CRITICAL(" {0} Produce failed:  {1} ", _producer->name(), RdKafka::err2str(resp));
-                if (resp == RdKafka::ERR__QUEUE_FULL)
-                {
-                    /* If the internal queue is full, wait for
-                     * messages to be delivered and then retry.
-                     * The internal queue represents both
-                     * messages to be sent and messages that have
-                     * been sent or failed, awaiting their
-                     * delivery report callback to be called.
-                     *
-                     * The internal queue is limited by the
-                     * configuration property
-                     * queue.buffering.max.messages */
-                    _producer->poll(1000 /*block for max 1000ms*/);
-                    continue;
-                }
-            }
-            else
-            {
-                SPDLOG_TRACE(" {0} Produced message ( {1}  bytes ) , message content:  {2}", _producer->name(), msg.size(), msg.c_str());
-            }
+            delete owned_msg;
+            return false;
+        }
+        return true;
+    }
 
-            // break the loop regardless of sucessfully sent or failed
-            break;
+    bool kafka_producer_worker::produce(const char *payload, size_t len, int msgflags, const std::string *key, RdKafka::Headers *headers, void *msg_opaque)
+    {
+        // Keyed messages are spread over partitions by the partitioner, others go to the configured partition.
+        RdKafka::ErrorCode resp;
+        if (headers)
+        {
+            // Headers are only accepted by the produce call taking the topic name. librdkafka owns them once produced.
+            resp = _producer->produce(_topic->name(),
+                                      key ? RdKafka::Topic::PARTITION_UA : _partition,
+                                      msgflags,
+                                      const_cast<char *>(payload),
+                                      len,
+                                      key ? key->data() : nullptr,
+                                      key ? key->size() : 0,
+                                      0,
+                                      headers,
+                                      msg_opaque);
+        }
+        else
+        {
+            resp = _producer->produce(_topic,
+                                      key ? RdKafka::Topic::PARTITION_UA : _partition,
+                                      msgflags,
+                                      const_cast<char *>(payload),
+                                      len,
+                                      key ? key->data() : nullptr,
+                                      key ? key->size() : 0,
+                                      msg_opaque);
+        }
+        if (resp != RdKafka::ERR_NO_ERROR)
+        {
+            delete headers;
+            /* A full queue (queue.buffering.max.messages) is not retried here so callers never block on
+             * the broker. The background poll thread keeps draining the queue. */
+            SPDLOG_CRITICAL(" {0} Produce failed:  {1} ", _producer->name(), RdKafka::err2str(resp));
+            _metrics.record_produce(false);
+            return false;
         }
+        _metrics.record_produce(true);
+        SPDLOG_TRACE(" {0} Produced message ( {1}  bytes ) , message content:  {2}", _producer->name(), len, spdlog::string_view_t(payload, len));
+        return true;
+    }
 
-        /* A producer application should continually serve
-         * the delivery report queue by calling poll()
-         * at frequent intervals.
-         * Either put the poll call in your main loop, or in a
-         * dedicated thread, or call it after every produce() call.
-         * Just make sure that poll() is still called
-         * during periods where you are not producing any messages
-         * to make sure previously produced messages have their
-         * delivery report callback served (and any other callbacks
-         * you register). */
-        _producer->poll(0);
+    producer_stats kafka_producer_worker::get_stats() const
+    {
+        producer_stats stats;
+        stats.queued = _metrics.get_queued();
+        stats.delivered = _metrics.get_delivered();
+        stats.failed = _metrics.get_failed();
+        stats.p99_delivery_latency_us = _metrics.get_delivery_latency().percentile(0.99);
+        return stats;
+    }
+
+    const kafka_client_metrics &kafka_producer_worker::get_metrics() const
+    {
+        return _metrics;
     }
 
     void kafka_producer_worker::stop()
@@ -133,6 +249,10 @@ namespace kafka_clients
          * flush() is an abstraction over poll() which
          * waits for all messages to be delivered. */
         _run = false;
+        if (_poll_thread.joinable())
+        {
+            _poll_thread.join();
+        }
         SPDLOG_CRITICAL("Stopping producer client.. ");
         SPDLOG_CRITICAL("Flushing final messages... ");
         try
@@ -140,9 +260,7 @@ namespace kafka_clients
             if (_producer)
             {
                 _producer->flush(10 * 1000 /* wait for max 10 seconds */);
-
-                if (_producer->outq_len() > 0)
-                    SPDLOG_INFO("  {0} {1} message(s) were not delivered  ", _producer->name(), _producer->outq_len());
+                purge_undelivered();
             }
         }
         catch (...)
@@ -0,0 +1,103 @@
+#include "kafka_tuning_profile.h"
+
+#include <boost/algorithm/string.hpp>
+#include <vector>
+
+namespace kafka_clients
+{
+    kafka_properties get_producer_profile(const std::string &profile)
+    {
+        if (profile == LOW_LATENCY_PROFILE)
+        {
+            return {
+                {"linger.ms", "0"},
+                {"compression.type", "none"},
+                {"socket.nagle.disable", "true"}};
+        }
+        if (profile == HIGH_THROUGHPUT_PROFILE)
+        {
+            return {
+                {"linger.ms", "20"},
+                {"compression.type", "lz4"},
+                {"batch.num.messages", "10000"},
+                {"batch.size", "1000000"},
+                {"queue.buffering.max.messages", "500000"}};
+        }
+        if (profile != DEFAULT_PROFILE && !profile.empty())
+        {
+            SPDLOG_ERROR("Unknown kafka producer tuning profile {0}, using librdkafka defaults!", profile);
+        }
+        return {};
+    }
+
+    kafka_properties get_consumer_profile(const std::string &profile)
+    {
+        if (profile == LOW_LATENCY_PROFILE)
+        {
+            return {
+                {"fetch.min.bytes", "1"},
+                {"fetch.wait.max.ms", "10"},
+                {"socket.nagle.disable", "true"}};
+        }
+        if (profile == HIGH_THROUGHPUT_PROFILE)
+        {
+            return {
+                {"fetch.min.bytes", "16384"},
+                {"fetch.wait.max.ms", "100"},
+                {"queued.min.messages", "100000"}};
+        }
+        if (profile != DEFAULT_PROFILE && !profile.empty())
+        {
+            SPDLOG_ERROR("Unknown kafka consumer tuning profile {0}, using librdkafka defaults!", profile);
+        }
+        return {};
+    }
+
+    kafka_properties parse_properties(const std::string &properties)
+    {
+        kafka_properties parsed;
+        std::vector<std::string> entries;
+        boost::split(entries, properties, boost::is_any_of(";"));
+        for (const auto &entry : entries)
+        {
+            auto separator = entry.find('=');
+            if (separator == std::string::npos)
+            {
+                if (!boost::trim_copy(entry).empty())
+                {
+                    SPDLOG_WARN("Ignoring malformed kafka property {0}, expected name=value", entry);
+                }
+                continue;
+            }
+            auto name = boost::trim_copy(entry.substr(0, separator));
+            auto value = boost::trim_copy(entry.substr(separator + 1));
+            if (name.empty())
+            {
+                SPDLOG_WARN("Ignoring kafka property with empty name {0}", entry);
+                continue;
+            }
+            parsed[name] = value;
+        }
+        return parsed;
+    }
+
+    kafka_properties get_producer_properties(const std::string &profile, const std::string &overrides)
+    {
+        auto properties = get_producer_profile(profile);
+        for (const auto &property : parse_properties(overrides))
+        {
+            properties[property.first] = property.second;
+        }
+        return properties;
+    }
+
+    kafka_properties get_consumer_properties(const std::string &profile, const std::string &overrides)
+    {
+        auto properties = get_consumer_profile(profile);
+        for (const auto &property : parse_properties(overrides))
+        {
+            properties[property.first] = property.second;
+        }
+        return properties;
+    }
+}
@@ -0,0 +1,78 @@
+#include "latency_histogram.h"
+
+#include <cmath>
+
+namespace kafka_clients
+{
+    latency_histogram::latency_histogram()
+    {
+        reset();
+    }
+
+    size_t latency_histogram::bucket_index(uint64_t value_us)
+    {
+        if (value_us == 0)
+        {
+            return 0;
+        }
+        size_t bit_length = 64 - static_cast<size_t>(__builtin_clzll(value_us));
+        return bit_length < BUCKET_COUNT ? bit_length : BUCKET_COUNT - 1;
+    }
+
+    void latency_histogram::record(uint64_t value_us)
+    {
+        _buckets[bucket_index(value_us)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t latency_histogram::count() const
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t latency_histogram::percentile(double percentile) const
+    {
+        uint64_t total = count();
+        if (total == 0)
+        {
+            return 0;
+        }
+        auto target = static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(total)));
+        if (target == 0)
+        {
+            target = 1;
+        }
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            cumulative += _buckets[i].load(std::memory_order_relaxed);
+            if (cumulative >= target)
+            {
+                return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+            }
+        }
+        return (uint64_t(1) << (BUCKET_COUNT - 1)) - 1;
+    }
+
+    void latency_histogram::add(const latency_histogram &other)
+    {
+        uint64_t added = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            uint64_t bucket = other._buckets[i].load(std::memory_order_relaxed);
+            _buckets[i].fetch_add(bucket, std::memory_order_relaxed);
+            added += bucket;
+        }
+        // Count the copied buckets rather than other._count, so that percentile() never looks for more samples than the buckets hold
+        _count.fetch_add(added, std::memory_order_relaxed);
+    }
+
+    void latency_histogram::reset()
+    {
+        for (auto &bucket : _buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        _count.store(0, std::memory_order_relaxed);
+    }
+}
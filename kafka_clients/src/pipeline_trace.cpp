@@ -0,0 +1,275 @@
+#include "pipeline_trace.h"
+
+#include <chrono>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        const char *STAGE_NAMES[TRACE_STAGE_COUNT] = {
+            "ingest",
+            "join",
+            "lanelet_lookup",
+            "serialize",
+            "produce",
+            "schedule_ingest",
+            "schedule",
+            "schedule_serialize",
+            "schedule_produce",
+            "tsc_ingest",
+            "tsc_update",
+        };
+
+        /**
+         * @brief Parse a decimal integer of [pos, end) up to the delimiter, advancing pos past the delimiter.
+         *
+         * @return false if there are no digits, the digits are not followed by the delimiter or the value does not fit int64_t.
+         */
+        bool parse_int(const char *&pos, const char *end, char delimiter, int64_t &value)
+        {
+            bool negative = pos < end && *pos == '-';
+            if (negative)
+            {
+                pos++;
+            }
+            const char *digits = pos;
+            value = 0;
+            while (pos < end && *pos >= '0' && *pos <= '9')
+            {
+                int digit = *pos - '0';
+                if (value > (std::numeric_limits<int64_t>::max() - digit) / 10)
+                {
+                    return false;
+                }
+                value = value * 10 + digit;
+                pos++;
+            }
+            if (pos == digits || (pos < end && *pos != delimiter))
+            {
+                return false;
+            }
+            if (pos < end)
+            {
+                pos++;
+            }
+            value = negative ? -value : value;
+            return true;
+        }
+    }
+
+    const char *trace_stage_name(trace_stage stage)
+    {
+        auto index = static_cast<size_t>(stage);
+        return index < TRACE_STAGE_COUNT ? STAGE_NAMES[index] : "unknown";
+    }
+
+    int64_t trace_now_us()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void trace_context::mark(trace_stage stage)
+    {
+        stage_us[static_cast<size_t>(stage)] = trace_now_us();
+    }
+
+    bool trace_context::reached(trace_stage stage) const
+    {
+        return stage_us[static_cast<size_t>(stage)] != 0;
+    }
+
+    std::string trace_context::encode() const
+    {
+        std::string value = std::to_string(origin_us);
+        for (size_t i = 0; i < TRACE_STAGE_COUNT; i++)
+        {
+            if (stage_us[i] != 0)
+            {
+                value += ',';
+                value += std::to_string(i);
+                value += ':';
+                value += std::to_string(stage_us[i]);
+            }
+        }
+        return value;
+    }
+
+    bool trace_context::decode(const char *value, size_t length)
+    {
+        origin_us = 0;
+        stage_us.fill(0);
+        const char *pos = value;
+        const char *end = value + length;
+        int64_t origin = 0;
+        if (!value || !parse_int(pos, end, ',', origin))
+        {
+            return false;
+        }
+        std::array<int64_t, TRACE_STAGE_COUNT> stages{};
+        while (pos < end)
+        {
+            int64_t index = 0;
+            int64_t timestamp_us = 0;
+            if (!parse_int(pos, end, ':', index) || !parse_int(pos, end, ',', timestamp_us))
+            {
+                return false;
+            }
+            // Stages added by newer services are skipped
+            if (index >= 0 && static_cast<size_t>(index) < TRACE_STAGE_COUNT)
+            {
+                stages[static_cast<size_t>(index)] = timestamp_us;
+            }
+        }
+        origin_us = origin;
+        stage_us = stages;
+        return true;
+    }
+
+    trace_context read_trace_context(const kafka_message &msg)
+    {
+        trace_context trace;
+        std::string header = msg.trace();
+        if (!header.empty() && trace.decode(header.data(), header.size()))
+        {
+            return trace;
+        }
+        int64_t timestamp_ms = msg.timestamp();
+        trace.origin_us = timestamp_ms > 0 ? timestamp_ms * 1000 : 0;
+        return trace;
+    }
+
+    pipeline_trace_metrics &pipeline_trace_metrics::instance()
+    {
+        static pipeline_trace_metrics metrics;
+        return metrics;
+    }
+
+    pipeline_trace_metrics::thread_histograms &pipeline_trace_metrics::local()
+    {
+        // Kept registered after the thread exits, so its samples stay in the reports
+        static thread_local std::shared_ptr<thread_histograms> histograms;
+        if (!histograms)
+        {
+            histograms = std::make_shared<thread_histograms>();
+            std::lock_guard<std::mutex> lck(_threads_mtx);
+            _threads.push_back(histograms);
+        }
+        return *histograms;
+    }
+
+    void pipeline_trace_metrics::record(const trace_context &trace, trace_stage first, trace_stage last)
+    {
+        thread_histograms &histograms = local();
+        int64_t previous_us = trace.origin_us;
+        // The stages before first are only used as the start of the first recorded stage
+        for (size_t i = 0; i < static_cast<size_t>(first); i++)
+        {
+            if (trace.stage_us[i] != 0)
+            {
+                previous_us = trace.stage_us[i];
+            }
+        }
+        for (size_t i = static_cast<size_t>(first); i <= static_cast<size_t>(last) && i < TRACE_STAGE_COUNT; i++)
+        {
+            if (trace.stage_us[i] == 0)
+            {
+                continue;
+            }
+            // Clock differences between hosts can make a stage start before the previous one ended
+            if (previous_us != 0)
+            {
+                histograms.stages[i].record(trace.stage_us[i] > previous_us ? static_cast<uint64_t>(trace.stage_us[i] - previous_us) : 0);
+            }
+            if (trace.origin_us != 0)
+            {
+                histograms.since_origin[i].record(trace.stage_us[i] > trace.origin_us ? static_cast<uint64_t>(trace.stage_us[i] - trace.origin_us) : 0);
+            }
+            previous_us = trace.stage_us[i];
+        }
+
+        int64_t interval_us = _log_interval_us.load(std::memory_order_relaxed);
+        if (interval_us > 0)
+        {
+            int64_t now_us = trace_now_us();
+            int64_t next_log_us = _next_log_us.load(std::memory_order_relaxed);
+            // Only the thread advancing the next log time logs
+            if (now_us >= next_log_us && _next_log_us.compare_exchange_strong(next_log_us, now_us + interval_us, std::memory_order_relaxed))
+            {
+                SPDLOG_INFO("Pipeline trace: {0}", to_string());
+            }
+        }
+    }
+
+    void pipeline_trace_metrics::set_log_interval_ms(int64_t interval_ms)
+    {
+        _log_interval_us.store(interval_ms > 0 ? interval_ms * 1000 : 0, std::memory_order_relaxed);
+        _next_log_us.store(trace_now_us() + interval_ms * 1000, std::memory_order_relaxed);
+    }
+
+    void pipeline_trace_metrics::merge(trace_stage stage, bool since_origin, latency_histogram &merged) const
+    {
+        std::lock_guard<std::mutex> lck(_threads_mtx);
+        for (const auto &histograms : _threads)
+        {
+            merged.add(since_origin ? histograms->since_origin[static_cast<size_t>(stage)] : histograms->stages[static_cast<size_t>(stage)]);
+        }
+    }
+
+    uint64_t pipeline_trace_metrics::count(trace_stage stage) const
+    {
+        latency_histogram merged;
+        merge(stage, false, merged);
+        return merged.count();
+    }
+
+    uint64_t pipeline_trace_metrics::percentile(trace_stage stage, double percentile) const
+    {
+        latency_histogram merged;
+        merge(stage, false, merged);
+        return merged.percentile(percentile);
+    }
+
+    uint64_t pipeline_trace_metrics::since_origin_percentile(trace_stage stage, double percentile) const
+    {
+        latency_histogram merged;
+        merge(stage, true, merged);
+        return merged.percentile(percentile);
+    }
+
+    std::string pipeline_trace_metrics::to_string() const
+    {
+        std::string summary;
+        for (size_t i = 0; i < TRACE_STAGE_COUNT; i++)
+        {
+            latency_histogram stage;
+            latency_histogram since_origin;
+            merge(static_cast<trace_stage>(i), false, stage);
+            merge(static_cast<trace_stage>(i), true, since_origin);
+            if (stage.count() == 0 && since_origin.count() == 0)
+            {
+                continue;
+            }
+            summary += fmt::format("{0}{1} {2} msgs p50 {3} us p99 {4} us (p99 since origin {5} us)", summary.empty() ? "" : ", ", STAGE_NAMES[i],
+                                   stage.count(), stage.percentile(0.5), stage.percentile(0.99), since_origin.percentile(0.99));
+        }
+        return summary.empty() ? "no traced messages" : summary;
+    }
+
+    void pipeline_trace_metrics::reset()
+    {
+        std::lock_guard<std::mutex> lck(_threads_mtx);
+        for (const auto &histograms : _threads)
+        {
+            for (auto &stage : histograms->stages)
+            {
+                stage.reset();
+            }
+            for (auto &stage : histograms->since_origin)
+            {
+                stage.reset();
+            }
+        }
+    }
+}
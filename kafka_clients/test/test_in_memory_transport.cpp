@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+#include "in_memory_transport.h"
+#include "bounded_mpmc_queue.h"
+
+#include <chrono>
+#include <thread>
+
+TEST(test_in_memory_transport, bounded_mpmc_queue)
+{
+    kafka_clients::bounded_mpmc_queue<int> queue(3);
+    // Capacity is rounded up to a power of two
+    EXPECT_EQ(4, queue.capacity());
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop(value));
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(queue.try_push(int(i)));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(test_in_memory_transport, publish_consume)
+{
+    auto bus = std::make_shared<kafka_clients::in_memory_topic_bus>();
+    kafka_clients::in_memory_consumer_worker consumer(bus, {"bsm", "spat"}, "group");
+    kafka_clients::in_memory_producer_worker bsm_producer(bus, "bsm");
+    kafka_clients::in_memory_producer_worker spat_producer(bus, "spat");
+    ASSERT_TRUE(consumer.init());
+    ASSERT_TRUE(bsm_producer.init());
+    ASSERT_TRUE(spat_producer.init());
+
+    // Messages published before subscribing are not delivered
+    EXPECT_TRUE(bsm_producer.send("dropped"));
+    consumer.subscribe();
+    EXPECT_TRUE(consumer.is_running());
+    EXPECT_TRUE(consumer.consume_message(0).empty());
+
+    EXPECT_TRUE(bsm_producer.send(std::string("bsm 1"), "vehicle_1"));
+    EXPECT_TRUE(spat_producer.send("spat 1"));
+    EXPECT_FALSE(spat_producer.send(""));
+
+    auto msg = consumer.consume_message(100);
+    ASSERT_FALSE(msg.empty());
+    EXPECT_EQ("bsm", msg.topic());
+    EXPECT_EQ("bsm 1", msg.to_string());
+    EXPECT_EQ("vehicle_1", std::string(msg.key(), msg.key_length()));
+    EXPECT_EQ(1, msg.offset());
+    EXPECT_LT(0, msg.timestamp());
+    EXPECT_EQ(nullptr, msg.headers());
+    EXPECT_EQ("spat 1", consumer.consume(100));
+    EXPECT_EQ("", consumer.consume(10));
+    EXPECT_EQ(2, consumer.get_metrics().get_consumed());
+    EXPECT_EQ(2, bsm_producer.get_stats().delivered);
+    EXPECT_EQ(0, bsm_producer.get_stats().failed);
+
+    consumer.stop();
+    EXPECT_FALSE(consumer.is_running());
+    bsm_producer.stop();
+    EXPECT_FALSE(bsm_producer.send("stopped"));
+}
+
+TEST(test_in_memory_transport, fan_out_and_batch)
+{
+    auto bus = std::make_shared<kafka_clients::in_memory_topic_bus>();
+    kafka_clients::in_memory_consumer_worker consumer_1(bus, {"vsi"}, "group_1");
+    kafka_clients::in_memory_consumer_worker consumer_2(bus, {"vsi"}, "group_2");
+    kafka_clients::in_memory_producer_worker producer(bus, "vsi");
+    ASSERT_TRUE(consumer_1.init());
+    ASSERT_TRUE(consumer_2.init());
+    ASSERT_TRUE(producer.init());
+    consumer_1.subscribe();
+    consumer_2.subscribe();
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_TRUE(producer.send("vsi " + std::to_string(i)));
+    }
+    std::vector<kafka_clients::kafka_message> batch;
+    EXPECT_EQ(8, consumer_1.consume_batch(batch, 8, 100));
+    EXPECT_EQ("vsi 0", batch.front().to_string());
+    EXPECT_EQ(2, consumer_1.consume_batch(batch, 8, 100));
+    EXPECT_EQ("vsi 9", batch.back().to_string());
+    EXPECT_EQ(0, consumer_1.consume_batch(batch, 8, 10));
+    // Every subscription receives every message
+    EXPECT_EQ(10, consumer_2.consume_batch(batch, 16, 100));
+}
+
+TEST(test_in_memory_transport, full_subscriber_queue)
+{
+    auto bus = std::make_shared<kafka_clients::in_memory_topic_bus>();
+    auto subscription = bus->subscribe({"spat"}, 2);
+    kafka_clients::in_memory_producer_worker producer(bus, "spat");
+    ASSERT_TRUE(producer.init());
+    EXPECT_TRUE(producer.send("1"));
+    EXPECT_TRUE(producer.send("2"));
+    EXPECT_FALSE(producer.send("3"));
+    EXPECT_EQ(2, producer.get_stats().queued);
+    EXPECT_EQ(1, producer.get_stats().failed);
+    bus->unsubscribe(subscription);
+    // Without subscribers nothing is dropped
+    EXPECT_TRUE(producer.send("4"));
+}
+
+TEST(test_in_memory_transport, messages_per_second)
+{
+    const int message_count = 200000;
+    auto bus = std::make_shared<kafka_clients::in_memory_topic_bus>();
+    kafka_clients::in_memory_consumer_worker consumer(bus, {"benchmark"}, "group");
+    kafka_clients::in_memory_producer_worker producer(bus, "benchmark");
+    ASSERT_TRUE(consumer.init());
+    ASSERT_TRUE(producer.init());
+    consumer.subscribe();
+    const std::string payload(200, 'x');
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer_thread([&producer, &payload, message_count]()
+                                {
+                                    for (int i = 0; i < message_count; i++)
+                                    {
+                                        // Retry while the consumer catches up with a full queue
+                                        while (!producer.send(payload))
+                                            std::this_thread::yield();
+                                    } });
+    int consumed = 0;
+    std::vector<kafka_clients::kafka_message> batch;
+    while (consumed < message_count)
+    {
+        size_t n = consumer.consume_batch(batch, 128, 1000);
+        if (n == 0)
+            break;
+        consumed += static_cast<int>(n);
+    }
+    producer_thread.join();
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(message_count, consumed);
+    SPDLOG_INFO("In memory transport: consumed {0} messages in {1:.3f} s ({2:.0f} messages/sec)", consumed, elapsed, consumed / elapsed);
+}
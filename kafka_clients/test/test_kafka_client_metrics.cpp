@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include "kafka_client_metrics.h"
+
+#include <chrono>
+
+namespace
+{
+    // Trimmed librdkafka statistics JSON of a consumer with one assigned partition
+    const std::string STATISTICS_JSON = R"({
+        "name": "rdkafka#consumer-1", "type": "consumer", "ts": 5016483227792, "time": 1527060869,
+        "replyq": 3, "msg_cnt": 0, "msg_size": 0, "tx": 120, "tx_bytes": 3000, "rx": 130, "rx_bytes": 520000,
+        "txmsgs": 0, "txmsg_bytes": 0, "rxmsgs": 1200, "rxmsg_bytes": 480000,
+        "topics": {
+            "v2xhub_bsm_in": {
+                "topic": "v2xhub_bsm_in", "age": 9000, "metadata_age": 9000,
+                "partitions": {
+                    "0": { "partition": 0, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "fetchq_cnt": 17, "consumer_lag": 42 },
+                    "-1": { "partition": -1, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "fetchq_cnt": 0, "consumer_lag": -1 }
+                }
+            }
+        }
+    })";
+}
+
+TEST(test_kafka_client_metrics, update_statistics)
+{
+    kafka_clients::kafka_client_metrics metrics;
+    EXPECT_EQ(-1, metrics.get_max_consumer_lag());
+    ASSERT_TRUE(metrics.update_statistics(STATISTICS_JSON));
+    auto statistics = metrics.get_statistics();
+    EXPECT_EQ(5016483227792, statistics.timestamp_us);
+    EXPECT_EQ(1200, statistics.messages_in);
+    EXPECT_EQ(480000, statistics.bytes_in);
+    EXPECT_EQ(0, statistics.messages_out);
+    EXPECT_EQ(3, statistics.reply_queue_depth);
+    // The internal unassigned partition -1 is skipped
+    ASSERT_EQ(1, statistics.partitions.size());
+    EXPECT_EQ("v2xhub_bsm_in", statistics.partitions.front().topic);
+    EXPECT_EQ(0, statistics.partitions.front().partition);
+    EXPECT_EQ(17, statistics.partitions.front().fetch_queue_depth);
+    EXPECT_EQ(42, metrics.get_max_consumer_lag());
+    EXPECT_NE(std::string::npos, metrics.to_string().find("rdkafka#consumer-1"));
+}
+
+TEST(test_kafka_client_metrics, invalid_statistics)
+{
+    kafka_clients::kafka_client_metrics metrics;
+    ASSERT_TRUE(metrics.update_statistics(STATISTICS_JSON));
+    EXPECT_FALSE(metrics.update_statistics("{ invalid"));
+    // Last valid statistics are kept
+    EXPECT_EQ(1200, metrics.get_statistics().messages_in);
+}
+
+TEST(test_kafka_client_metrics, record_produce_and_delivery)
+{
+    kafka_clients::kafka_client_metrics metrics;
+    metrics.record_produce(true);
+    metrics.record_produce(true);
+    metrics.record_produce(false);
+    metrics.record_delivery(true, 500);
+    metrics.record_delivery(false, -1);
+    EXPECT_EQ(2, metrics.get_queued());
+    EXPECT_EQ(1, metrics.get_delivered());
+    EXPECT_EQ(2, metrics.get_failed());
+    EXPECT_EQ(1, metrics.get_delivery_latency().count());
+    EXPECT_EQ(511, metrics.get_delivery_latency().percentile(0.99));
+}
+
+TEST(test_kafka_client_metrics, record_consume)
+{
+    kafka_clients::kafka_client_metrics metrics;
+    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    metrics.record_consume(100, now_ms - 5);
+    // Messages without timestamp or from a skewed clock only count towards the totals
+    metrics.record_consume(50, -1);
+    metrics.record_consume(50, now_ms + 60000);
+    EXPECT_EQ(3, metrics.get_consumed());
+    EXPECT_EQ(200, metrics.get_consumed_bytes());
+    EXPECT_EQ(1, metrics.get_end_to_end_latency().count());
+    EXPECT_LE(4095, metrics.get_end_to_end_latency().percentile(0.99));
+}
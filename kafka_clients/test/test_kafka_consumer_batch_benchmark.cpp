@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "kafka_client.h"
+
+#include <chrono>
+#include <thread>
+#include <librdkafka/rdkafka.h>
+#include <librdkafka/rdkafka_mock.h>
+
+namespace
+{
+    /**
+     * @brief Test fixture creating an in-process librdkafka mock cluster so the consumer throughput
+     * benchmark does not require an external broker.
+     */
+    class kafka_consumer_batch_benchmark : public ::testing::Test
+    {
+    protected:
+        rd_kafka_t *mock_handle = nullptr;
+        rd_kafka_mock_cluster_t *mock_cluster = nullptr;
+        std::string bootstrap_servers;
+        const int message_count = 20000;
+
+        void SetUp() override
+        {
+            char errstr[512];
+            rd_kafka_conf_t *conf = rd_kafka_conf_new();
+            mock_handle = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errstr, sizeof(errstr));
+            ASSERT_NE(nullptr, mock_handle) << errstr;
+            mock_cluster = rd_kafka_mock_cluster_new(mock_handle, 1);
+            ASSERT_NE(nullptr, mock_cluster);
+            bootstrap_servers = rd_kafka_mock_cluster_bootstraps(mock_cluster);
+        }
+
+        void TearDown() override
+        {
+            if (mock_cluster)
+                rd_kafka_mock_cluster_destroy(mock_cluster);
+            if (mock_handle)
+                rd_kafka_destroy(mock_handle);
+        }
+
+        /**
+         * @brief Subscribe a consumer to a fresh topic, wait until it is assigned and then produce
+         * message_count messages to the topic.
+         */
+        std::shared_ptr<kafka_clients::kafka_consumer_worker> prepare_topic(const std::string &topic)
+        {
+            rd_kafka_mock_topic_create(mock_cluster, topic.c_str(), 1, 1);
+            kafka_clients::kafka_client client;
+            std::string group_id = "group_" + topic;
+            auto consumer = client.create_consumer(bootstrap_servers, topic, group_id);
+            auto producer = client.create_producer(bootstrap_servers, topic);
+            EXPECT_TRUE(consumer->init());
+            EXPECT_TRUE(producer->init());
+            consumer->subscribe();
+
+            // Consumer starts at the end of the topic, so wait for the group join before producing.
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                producer->send("warm up");
+                if (!consumer->consume_message(100).empty())
+                    break;
+            }
+            // Drain any remaining warm up messages
+            while (!consumer->consume_batch(1024, 500).empty())
+                ;
+
+            const std::string payload(200, 'x');
+            for (int i = 0; i < message_count; i++)
+            {
+                producer->send(payload);
+            }
+            producer->stop();
+            return consumer;
+        }
+    };
+}
+
+// Disabled by default since it is timing dependent and takes seconds per batch size against the mock cluster.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*consumer_batch_benchmark*
+TEST_F(kafka_consumer_batch_benchmark, DISABLED_messages_per_second_by_batch_size)
+{
+    for (size_t batch_size : {1, 16, 128})
+    {
+        auto consumer = prepare_topic("benchmark_batch_" + std::to_string(batch_size));
+        std::vector<kafka_clients::kafka_message> batch;
+        batch.reserve(batch_size);
+        int consumed = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (consumed < message_count)
+        {
+            size_t n = consumer->consume_batch(batch, batch_size, 1000);
+            if (n == 0)
+                break;
+            consumed += static_cast<int>(n);
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(message_count, consumed);
+        SPDLOG_INFO("Batch size {0}: consumed {1} messages in {2:.3f} s ({3:.0f} messages/sec)",
+                    batch_size, consumed, elapsed, consumed / elapsed);
+    }
+}
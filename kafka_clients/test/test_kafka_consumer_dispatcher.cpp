@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "kafka_client.h"
+
+#include <chrono>
+#include <librdkafka/rdkafka.h>
+#include <librdkafka/rdkafka_mock.h>
+
+namespace
+{
+    /**
+     * @brief Test fixture creating an in-process librdkafka mock cluster with two topics.
+     */
+    class kafka_consumer_dispatcher_test : public ::testing::Test
+    {
+    protected:
+        rd_kafka_t *mock_handle = nullptr;
+        rd_kafka_mock_cluster_t *mock_cluster = nullptr;
+        std::string bootstrap_servers;
+        const std::string bsm_topic = "dispatcher_bsm";
+        const std::string spat_topic = "dispatcher_spat";
+
+        void SetUp() override
+        {
+            char errstr[512];
+            rd_kafka_conf_t *conf = rd_kafka_conf_new();
+            mock_handle = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errstr, sizeof(errstr));
+            ASSERT_NE(nullptr, mock_handle) << errstr;
+            mock_cluster = rd_kafka_mock_cluster_new(mock_handle, 1);
+            ASSERT_NE(nullptr, mock_cluster);
+            bootstrap_servers = rd_kafka_mock_cluster_bootstraps(mock_cluster);
+            rd_kafka_mock_topic_create(mock_cluster, bsm_topic.c_str(), 1, 1);
+            rd_kafka_mock_topic_create(mock_cluster, spat_topic.c_str(), 1, 1);
+        }
+
+        void TearDown() override
+        {
+            if (mock_cluster)
+                rd_kafka_mock_cluster_destroy(mock_cluster);
+            if (mock_handle)
+                rd_kafka_destroy(mock_handle);
+        }
+    };
+}
+
+TEST_F(kafka_consumer_dispatcher_test, dispatch_by_topic)
+{
+    kafka_clients::kafka_client client;
+    auto consumer = client.create_consumer(bootstrap_servers, std::vector<std::string>{bsm_topic, spat_topic}, "dispatcher_group");
+    ASSERT_EQ(2, consumer->get_topics().size());
+    auto bsm_producer = client.create_producer(bootstrap_servers, bsm_topic);
+    auto spat_producer = client.create_producer(bootstrap_servers, spat_topic);
+    ASSERT_TRUE(consumer->init());
+    ASSERT_TRUE(bsm_producer->init());
+    ASSERT_TRUE(spat_producer->init());
+    consumer->subscribe();
+
+    int bsm_count = 0;
+    int spat_count = 0;
+    kafka_clients::kafka_consumer_dispatcher dispatcher(consumer);
+    dispatcher.register_handler(bsm_topic, [&bsm_count](const kafka_clients::kafka_message &msg)
+                                {
+                                    EXPECT_EQ("bsm", msg.to_string());
+                                    bsm_count++;
+                                });
+    dispatcher.register_handler(spat_topic, [&spat_count](const kafka_clients::kafka_message &msg)
+                                {
+                                    EXPECT_EQ("spat", msg.to_string());
+                                    spat_count++;
+                                    // Handler failures must not stop the dispatch of the remaining messages
+                                    throw std::runtime_error("spat handler failure");
+                                });
+
+    // Consumer starts at the end of the topics, so keep producing until the group join completed.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while ((bsm_count == 0 || spat_count == 0) && std::chrono::steady_clock::now() < deadline)
+    {
+        bsm_producer->send("bsm");
+        spat_producer->send("spat");
+        dispatcher.dispatch(16, 100);
+    }
+    EXPECT_LT(0, bsm_count);
+    EXPECT_LT(0, spat_count);
+    bsm_producer->stop();
+    spat_producer->stop();
+}
@@ -16,6 +16,8 @@ TEST(test_kafka_consumer_worker, create_consumer)
 
     // Run this unit test without launching kafka broker nor produce any messages to this topic.
     EXPECT_EQ(0, payload.length());
+    kafka_clients::kafka_message msg = worker->consume_message(1000);
+    EXPECT_TRUE(msg.empty());
     if (worker->is_running())
     {
         worker->stop();
@@ -0,0 +1,28 @@
+#include "gtest/gtest.h"
+#include "kafka_message.h"
+
+TEST(test_kafka_message, empty_message)
+{
+    kafka_clients::kafka_message msg;
+    EXPECT_TRUE(msg.empty());
+    EXPECT_EQ(nullptr, msg.payload());
+    EXPECT_EQ(0, msg.length());
+    EXPECT_EQ(nullptr, msg.key());
+    EXPECT_EQ(0, msg.key_length());
+    EXPECT_EQ("", msg.topic());
+    EXPECT_EQ(RdKafka::Topic::OFFSET_INVALID, msg.offset());
+    EXPECT_EQ(RdKafka::Topic::PARTITION_UA, msg.partition());
+    EXPECT_EQ(-1, msg.timestamp());
+    EXPECT_EQ(nullptr, msg.headers());
+    EXPECT_EQ("", msg.to_string());
+}
+
+TEST(test_kafka_message, move_empty_message)
+{
+    kafka_clients::kafka_message msg;
+    kafka_clients::kafka_message moved(std::move(msg));
+    EXPECT_TRUE(moved.empty());
+    kafka_clients::kafka_message assigned;
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.empty());
+}
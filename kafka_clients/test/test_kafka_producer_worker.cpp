@@ -13,5 +13,12 @@ TEST(test_kafka_producer_worker, create_producer)
     std::string msg = "test message";
     // // Run this unit test without launching kafka broker will throw connection refused error
     worker->send(msg);
+    worker->send(std::string("test message moved"));
+    worker->send(msg, "vehicle_id");
+    worker->send(std::string("test message moved"), "vehicle_id");
+    EXPECT_FALSE(worker->send(""));
+    auto stats = worker->get_stats();
+    EXPECT_LE(4, stats.queued + stats.failed);
     worker->stop();
+    EXPECT_FALSE(worker->send(msg));
 }
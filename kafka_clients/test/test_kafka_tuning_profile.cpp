@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "kafka_tuning_profile.h"
+
+TEST(test_kafka_tuning_profile, producer_profiles)
+{
+    EXPECT_TRUE(kafka_clients::get_producer_profile(kafka_clients::DEFAULT_PROFILE).empty());
+    EXPECT_TRUE(kafka_clients::get_producer_profile("unknown").empty());
+    auto low_latency = kafka_clients::get_producer_profile(kafka_clients::LOW_LATENCY_PROFILE);
+    EXPECT_EQ("0", low_latency["linger.ms"]);
+    EXPECT_EQ(0, low_latency.count("acks"));
+    EXPECT_EQ(0, low_latency.count("queue.buffering.max.messages"));
+    auto high_throughput = kafka_clients::get_producer_profile(kafka_clients::HIGH_THROUGHPUT_PROFILE);
+    EXPECT_EQ("lz4", high_throughput["compression.type"]);
+    EXPECT_EQ(0, high_throughput.count("acks"));
+}
+
+TEST(test_kafka_tuning_profile, consumer_profiles)
+{
+    EXPECT_TRUE(kafka_clients::get_consumer_profile(kafka_clients::DEFAULT_PROFILE).empty());
+    auto low_latency = kafka_clients::get_consumer_profile(kafka_clients::LOW_LATENCY_PROFILE);
+    EXPECT_EQ("10", low_latency["fetch.wait.max.ms"]);
+    auto high_throughput = kafka_clients::get_consumer_profile(kafka_clients::HIGH_THROUGHPUT_PROFILE);
+    EXPECT_EQ("16384", high_throughput["fetch.min.bytes"]);
+}
+
+TEST(test_kafka_tuning_profile, parse_properties)
+{
+    auto properties = kafka_clients::parse_properties(" linger.ms = 5 ;compression.type=zstd;;malformed;=empty_name");
+    EXPECT_EQ(2, properties.size());
+    EXPECT_EQ("5", properties["linger.ms"]);
+    EXPECT_EQ("zstd", properties["compression.type"]);
+    EXPECT_TRUE(kafka_clients::parse_properties("").empty());
+}
+
+TEST(test_kafka_tuning_profile, overrides)
+{
+    auto properties = kafka_clients::get_producer_properties(kafka_clients::HIGH_THROUGHPUT_PROFILE, "linger.ms=50;message.max.bytes=2000000");
+    EXPECT_EQ("50", properties["linger.ms"]);
+    EXPECT_EQ("2000000", properties["message.max.bytes"]);
+    EXPECT_EQ("lz4", properties["compression.type"]);
+    auto consumer_properties = kafka_clients::get_consumer_properties(kafka_clients::DEFAULT_PROFILE, "fetch.min.bytes=1024");
+    EXPECT_EQ(1, consumer_properties.size());
+    EXPECT_EQ("1024", consumer_properties["fetch.min.bytes"]);
+}
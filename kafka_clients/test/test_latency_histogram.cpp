@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include "latency_histogram.h"
+
+TEST(test_latency_histogram, empty_histogram)
+{
+    kafka_clients::latency_histogram histogram;
+    EXPECT_EQ(0, histogram.count());
+    EXPECT_EQ(0, histogram.percentile(0.99));
+}
+
+TEST(test_latency_histogram, percentile)
+{
+    kafka_clients::latency_histogram histogram;
+    // 99 samples of 100 us and one sample of 10000 us
+    for (int i = 0; i < 99; i++)
+    {
+        histogram.record(100);
+    }
+    histogram.record(10000);
+    EXPECT_EQ(100, histogram.count());
+    // 100 us falls in bucket [64, 128)
+    EXPECT_EQ(127, histogram.percentile(0.5));
+    EXPECT_EQ(127, histogram.percentile(0.99));
+    // 10000 us falls in bucket [8192, 16384)
+    EXPECT_EQ(16383, histogram.percentile(1.0));
+    histogram.record(0);
+    EXPECT_EQ(0, histogram.percentile(0.0));
+    histogram.reset();
+    EXPECT_EQ(0, histogram.count());
+}
+
+TEST(test_latency_histogram, add)
+{
+    kafka_clients::latency_histogram first;
+    kafka_clients::latency_histogram second;
+    kafka_clients::latency_histogram merged;
+    first.record(100);
+    second.record(100);
+    second.record(10000);
+    merged.add(first);
+    merged.add(second);
+    EXPECT_EQ(3, merged.count());
+    EXPECT_EQ(127, merged.percentile(0.5));
+    EXPECT_EQ(16383, merged.percentile(1.0));
+    // The added histograms are unchanged
+    EXPECT_EQ(1, first.count());
+    EXPECT_EQ(2, second.count());
+}
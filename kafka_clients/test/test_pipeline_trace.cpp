@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "pipeline_trace.h"
+#include "in_memory_transport.h"
+
+#include <thread>
+
+TEST(test_pipeline_trace, encode_decode)
+{
+    kafka_clients::trace_context trace;
+    trace.origin_us = 1000;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::INGEST)] = 1500;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::PRODUCE)] = 2500;
+    std::string value = trace.encode();
+    EXPECT_EQ("1000,0:1500,4:2500", value);
+
+    kafka_clients::trace_context decoded;
+    ASSERT_TRUE(decoded.decode(value.data(), value.size()));
+    EXPECT_EQ(1000, decoded.origin_us);
+    EXPECT_EQ(trace.stage_us, decoded.stage_us);
+    EXPECT_TRUE(decoded.reached(kafka_clients::trace_stage::INGEST));
+    EXPECT_FALSE(decoded.reached(kafka_clients::trace_stage::JOIN));
+
+    // Unknown stages are skipped, malformed values leave the trace empty
+    std::string newer = "1000,0:1500,99:3000";
+    ASSERT_TRUE(decoded.decode(newer.data(), newer.size()));
+    EXPECT_EQ(1500, decoded.stage_us[0]);
+    std::string malformed = "1000,0:x";
+    EXPECT_FALSE(decoded.decode(malformed.data(), malformed.size()));
+    EXPECT_EQ(0, decoded.origin_us);
+    EXPECT_FALSE(decoded.reached(kafka_clients::trace_stage::INGEST));
+
+    // Values that do not fit int64_t are malformed
+    std::string largest = "9223372036854775807,0:-9223372036854775807";
+    ASSERT_TRUE(decoded.decode(largest.data(), largest.size()));
+    EXPECT_EQ(INT64_MAX, decoded.origin_us);
+    EXPECT_EQ(-INT64_MAX, decoded.stage_us[0]);
+    std::string overflow = "9223372036854775808,0:1500";
+    EXPECT_FALSE(decoded.decode(overflow.data(), overflow.size()));
+    std::string long_stage = "1000,0:123456789012345678901234567890";
+    EXPECT_FALSE(decoded.decode(long_stage.data(), long_stage.size()));
+    EXPECT_EQ(0, decoded.origin_us);
+}
+
+TEST(test_pipeline_trace, in_memory_trace_header)
+{
+    auto bus = std::make_shared<kafka_clients::in_memory_topic_bus>();
+    kafka_clients::in_memory_consumer_worker consumer(bus, {"vsi"}, "group");
+    kafka_clients::in_memory_producer_worker producer(bus, "vsi");
+    ASSERT_TRUE(consumer.init());
+    ASSERT_TRUE(producer.init());
+    consumer.subscribe();
+
+    kafka_clients::trace_context trace;
+    trace.origin_us = 1000;
+    trace.mark(kafka_clients::trace_stage::PRODUCE);
+    EXPECT_TRUE(producer.send(std::string("traced"), trace));
+    EXPECT_TRUE(producer.send(std::string("untraced")));
+
+    auto traced = consumer.consume_message(100);
+    ASSERT_FALSE(traced.empty());
+    kafka_clients::trace_context consumed = kafka_clients::read_trace_context(traced);
+    EXPECT_EQ(trace.origin_us, consumed.origin_us);
+    EXPECT_EQ(trace.stage_us, consumed.stage_us);
+
+    // Messages without a trace start one from their timestamp
+    auto untraced = consumer.consume_message(100);
+    ASSERT_FALSE(untraced.empty());
+    EXPECT_EQ("", untraced.trace());
+    consumed = kafka_clients::read_trace_context(untraced);
+    EXPECT_EQ(untraced.timestamp() * 1000, consumed.origin_us);
+    EXPECT_FALSE(consumed.reached(kafka_clients::trace_stage::PRODUCE));
+    consumer.stop();
+    producer.stop();
+}
+
+TEST(test_pipeline_trace, record_stages)
+{
+    auto &metrics = kafka_clients::pipeline_trace_metrics::instance();
+    metrics.reset();
+
+    kafka_clients::trace_context trace;
+    trace.origin_us = 1000;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::INGEST)] = 1100;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::JOIN)] = 1300;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::PRODUCE)] = 2300;
+    trace.stage_us[static_cast<size_t>(kafka_clients::trace_stage::SCHEDULE_INGEST)] = 5300;
+
+    // Two threads record into their own histograms, merged when reported
+    std::thread other([&trace, &metrics]()
+                      { metrics.record(trace, kafka_clients::trace_stage::INGEST, kafka_clients::trace_stage::PRODUCE); });
+    other.join();
+    metrics.record(trace, kafka_clients::trace_stage::INGEST, kafka_clients::trace_stage::PRODUCE);
+
+    EXPECT_EQ(2, metrics.count(kafka_clients::trace_stage::INGEST));
+    // 100 us falls in bucket [64, 128)
+    EXPECT_EQ(127, metrics.percentile(kafka_clients::trace_stage::INGEST, 0.99));
+    EXPECT_EQ(255, metrics.percentile(kafka_clients::trace_stage::JOIN, 0.99));
+    // Stages not reached are skipped, the produce stage starts at the join
+    EXPECT_EQ(0, metrics.count(kafka_clients::trace_stage::LANELET_LOOKUP));
+    EXPECT_EQ(1023, metrics.percentile(kafka_clients::trace_stage::PRODUCE, 0.99));
+    EXPECT_EQ(2047, metrics.since_origin_percentile(kafka_clients::trace_stage::PRODUCE, 0.99));
+    // Stages after last belong to the downstream service
+    EXPECT_EQ(0, metrics.count(kafka_clients::trace_stage::SCHEDULE_INGEST));
+
+    // The downstream service records its stages from the last upstream stage
+    metrics.record(trace, kafka_clients::trace_stage::SCHEDULE_INGEST, kafka_clients::trace_stage::SCHEDULE_PRODUCE);
+    EXPECT_EQ(1, metrics.count(kafka_clients::trace_stage::SCHEDULE_INGEST));
+    EXPECT_EQ(4095, metrics.percentile(kafka_clients::trace_stage::SCHEDULE_INGEST, 0.99));
+    EXPECT_NE(std::string::npos, metrics.to_string().find("schedule_ingest 1 msgs"));
+    metrics.reset();
+    EXPECT_EQ(0, metrics.count(kafka_clients::trace_stage::INGEST));
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "message_lanelet2_translation.h"
+
+#include <chrono>
+#include <vector>
+
+namespace
+{
+    const std::string map_file = "../../sample_map/town01_vector_map_test.osm";
+    const int round_count = 20;
+}
+
+/**
+ * @brief Point to lanelet lookups per second for the centerline segment midpoints of the sample map: nearest lanelets search in the map R-tree
+ * compared with the lanelet grid.
+ */
+TEST(test_lanelet_lookup_benchmark, lookups_per_second)
+{
+    message_services::message_translations::message_lanelet2_translation clt;
+    ASSERT_TRUE(clt.read_lanelet2_map(map_file));
+
+    // Load the map again with the same projection to sample points in the map frame
+    int projector_type = 1;
+    std::string target_frame;
+    lanelet::ErrorMessages errors;
+    lanelet::io_handlers::AutowareOsmParser::parseMapParams(map_file, &projector_type, &target_frame);
+    lanelet::projection::LocalFrameProjector local_projector(target_frame.c_str());
+    lanelet::LaneletMapPtr map_ptr = lanelet::load(map_file, local_projector, &errors);
+    std::vector<lanelet::BasicPoint3d> points;
+    for (const auto &ll : map_ptr->laneletLayer)
+    {
+        // Midpoints of the centerline segments, the centerline end points are on the lanelet borders
+        lanelet::ConstLineString3d centerline = ll.centerline3d();
+        for (size_t i = 1; i < centerline.size(); i++)
+        {
+            points.push_back((centerline[i - 1].basicPoint() + centerline[i].basicPoint()) / 2);
+        }
+    }
+    ASSERT_FALSE(points.empty());
+
+    size_t rtree_found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < round_count; round++)
+    {
+        for (const auto &point : points)
+        {
+            rtree_found += clt.find_cur_lanelets_in_rtree(point).size();
+        }
+    }
+    double rtree_lookups_per_sec = points.size() * round_count / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t grid_found = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < round_count; round++)
+    {
+        for (const auto &point : points)
+        {
+            grid_found += clt.get_cur_lanelets_by_point(point).size();
+        }
+    }
+    double grid_lookups_per_sec = points.size() * round_count / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_GE(grid_found, rtree_found);
+    SPDLOG_INFO("Lanelet lookups per second for {0} points: R-tree {1:.0f}, lanelet grid {2:.0f} ({3:.1f}x)",
+                points.size(), rtree_lookups_per_sec, grid_lookups_per_sec, grid_lookups_per_sec / rtree_lookups_per_sec);
+}
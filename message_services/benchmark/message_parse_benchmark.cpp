@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "bsm.h"
+#include "mobilityoperation.h"
+#include "mobilitypath.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    std::atomic<uint64_t> allocation_count(0);
+
+    const int iteration_count = 20000;
+
+    std::vector<std::string> read_samples(const std::vector<std::string> &file_names)
+    {
+        std::vector<std::string> samples;
+        for (const auto &file_name : file_names)
+        {
+            std::ifstream file("../../scripts/" + file_name);
+            if (!file.is_open())
+            {
+                SPDLOG_ERROR("Sample {0} not found", file_name);
+                continue;
+            }
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            samples.push_back(buffer.str());
+        }
+        return samples;
+    }
+
+    template <class T>
+    bool parse_dom(const std::string &json_str, T &msg_obj)
+    {
+        rapidjson::Document doc;
+        if (doc.Parse(json_str.c_str(), json_str.size()).HasParseError())
+        {
+            return false;
+        }
+        msg_obj.fromJsonObject(doc);
+        return true;
+    }
+
+    template <class T>
+    bool parse_sax(const std::string &json_str, T &msg_obj)
+    {
+        return msg_obj.fromJson(json_str.data(), json_str.size());
+    }
+
+    /**
+     * @brief Parse every sample iteration_count times into a fresh model and log messages/sec and allocations/message
+     * of the DOM parser against the single pass SAX parser.
+     */
+    template <class T>
+    void benchmark(const std::string &msg_type, const std::vector<std::string> &samples)
+    {
+        ASSERT_FALSE(samples.empty());
+        uint64_t msg_count = static_cast<uint64_t>(iteration_count) * samples.size();
+        double msgs_per_sec[2] = {0, 0};
+        double allocations_per_msg[2] = {0, 0};
+        for (int is_sax = 0; is_sax < 2; is_sax++)
+        {
+            uint64_t start_allocation_count = allocation_count.load();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iteration_count; i++)
+            {
+                for (const auto &sample : samples)
+                {
+                    T msg_obj;
+                    ASSERT_TRUE(is_sax ? parse_sax(sample, msg_obj) : parse_dom(sample, msg_obj));
+                }
+            }
+            double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            msgs_per_sec[is_sax] = msg_count / sec;
+            allocations_per_msg[is_sax] = static_cast<double>(allocation_count.load() - start_allocation_count) / msg_count;
+        }
+        SPDLOG_INFO("Parse {0}: DOM {1:.0f} msg/s {2:.1f} allocations/msg, SAX {3:.0f} msg/s {4:.1f} allocations/msg ({5:.1f}x)",
+                    msg_type, msgs_per_sec[0], allocations_per_msg[0], msgs_per_sec[1], allocations_per_msg[1], msgs_per_sec[1] / msgs_per_sec[0]);
+    }
+}
+
+// Count heap allocations of the benchmark binary, the model constructors included. Kept out of the unit test binary
+// so the other tests do not run on the counting allocator.
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(test_message_parse_benchmark, parse_throughput)
+{
+    benchmark<message_services::models::bsm>("BSM", read_samples({"bsm.json", "bsm_12_06.json", "bsm_12_8.json"}));
+    benchmark<message_services::models::mobilityoperation>("MobilityOperation", read_samples({"mobilityoperation.json", "mobilityoperation_12_06.json", "mobilityoperation_12_8.json"}));
+    benchmark<message_services::models::mobilitypath>("MobilityPath", read_samples({"mobilitypath.json", "mobilitypath_12_02.json", "mobilitypath_12_06.json", "mobilitypath_12_8.json"}));
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "message_lanelet2_translation.h"
+
+#include <chrono>
+
+namespace
+{
+    const int trajectory_count = 2000;
+    const int offset_count = 60;
+}
+
+/**
+ * @brief Map projection cost per MobilityPath trajectory of 60 offsets: one ecef_2_map_point call per point compared with a single
+ * trajectory_2_map_points call.
+ */
+TEST(test_trajectory_projection_benchmark, projection_cost_per_trajectory)
+{
+    message_services::message_translations::message_lanelet2_translation clt;
+    ASSERT_TRUE(clt.read_lanelet2_map("../vector_map.osm"));
+
+    message_services::models::trajectory trajectory;
+    trajectory.location.ecef_x = 110460730;
+    trajectory.location.ecef_y = -484214174;
+    trajectory.location.ecef_z = 398846417;
+    message_services::models::locationOffsetECEF_t offset;
+    for (int i = 0; i < offset_count; i++)
+    {
+        offset.offset_x = 20 + i % 7;
+        offset.offset_y = 11 - i % 5;
+        offset.offset_z = 8;
+        trajectory.offsets.push_back(offset);
+    }
+
+    double per_point_sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < trajectory_count; round++)
+    {
+        std::int32_t ecef_x = trajectory.location.ecef_x;
+        std::int32_t ecef_y = trajectory.location.ecef_y;
+        std::int32_t ecef_z = trajectory.location.ecef_z;
+        per_point_sum += clt.ecef_2_map_point(ecef_x, ecef_y, ecef_z).x();
+        for (const auto &trajectory_offset : trajectory.offsets)
+        {
+            ecef_x += trajectory_offset.offset_x;
+            ecef_y += trajectory_offset.offset_y;
+            ecef_z += trajectory_offset.offset_z;
+            per_point_sum += clt.ecef_2_map_point(ecef_x, ecef_y, ecef_z).x();
+        }
+    }
+    double per_point_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / trajectory_count;
+
+    double batch_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < trajectory_count; round++)
+    {
+        message_services::message_translations::trajectory_map_points_t points = clt.trajectory_2_map_points(trajectory);
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            batch_sum += points.x[i];
+        }
+    }
+    double batch_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / trajectory_count;
+
+    ASSERT_NEAR(per_point_sum / (trajectory_count * (offset_count + 1)), batch_sum / (trajectory_count * (offset_count + 1)), 0.01);
+    SPDLOG_INFO("Projection cost per trajectory of {0} offsets: ecef_2_map_point per point {1:.1f} us, trajectory_2_map_points {2:.1f} us ({3:.1f}x)",
+                offset_count, per_point_us, batch_us, per_point_us / batch_us);
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "bsm.h"
+#include "mobilityoperation.h"
+#include "packed_key_map.h"
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace
+{
+    const int vehicle_count = 200;
+    const int round_count = 500;
+    const uint64_t base_timestamp = 1632679657000;
+
+    long msg_count_of(int round)
+    {
+        return round % 128;
+    }
+
+    long sec_mark_of(int round)
+    {
+        return (round * 100) % 60000;
+    }
+
+    // One MobilityPath per vehicle and second
+    uint64_t timestamp_bucket_of(int round)
+    {
+        return (base_timestamp + round * 1000) / 1000;
+    }
+}
+
+/**
+ * @brief Join cost per vehicle status and intent message: build the BSM and MobilityPath keys on arrival and store the two messages,
+ * then build both keys again from the MobilityOperation of the previous round, look its messages up and remove them. The maps hold
+ * two rounds of messages of all vehicles. Compares string keys in std::map with packed keys in packed_key_map.
+ */
+TEST(test_vsi_join_benchmark, join_cost_per_vsi)
+{
+    std::vector<std::string> temporary_id;
+    std::vector<std::string> sender_id;
+    for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+    {
+        temporary_id.push_back("bsm" + std::to_string(10000 + vehicle));
+        sender_id.push_back("DOT-" + std::to_string(10000 + vehicle));
+    }
+
+    message_services::models::bsm bsm_obj;
+    message_services::models::mobilityoperation mo_obj;
+    std::map<std::string, int64_t> bsm_string_m;
+    std::map<std::string, int64_t> mp_string_m;
+    int64_t string_joined = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < round_count; round++)
+    {
+        for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+        {
+            bsm_string_m[bsm_obj.generate_hash_bsm_msg_id(temporary_id[vehicle], msg_count_of(round), sec_mark_of(round))] = round;
+            mp_string_m[mo_obj.generate_hash_sender_timestamp_id(sender_id[vehicle], timestamp_bucket_of(round))] = round;
+            if (round == 0)
+            {
+                continue;
+            }
+
+            std::string bsm_msg_id = mo_obj.generate_hash_bsm_msg_id(temporary_id[vehicle], msg_count_of(round - 1), sec_mark_of(round - 1));
+            std::string mp_msg_id = mo_obj.generate_hash_sender_timestamp_id(sender_id[vehicle], timestamp_bucket_of(round - 1));
+            if (bsm_string_m.find(bsm_msg_id) != bsm_string_m.end() && mp_string_m.find(mp_msg_id) != mp_string_m.end())
+            {
+                string_joined += bsm_string_m[bsm_msg_id] + mp_string_m[mp_msg_id] >= 0 ? 1 : 0;
+                bsm_string_m.erase(bsm_msg_id);
+                mp_string_m.erase(mp_msg_id);
+            }
+        }
+    }
+    double string_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / string_joined;
+
+    message_services::workers::packed_key_map<int64_t> bsm_packed_m;
+    message_services::workers::packed_key_map<int64_t> mp_packed_m;
+    int64_t packed_joined = 0;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < round_count; round++)
+    {
+        for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+        {
+            bsm_packed_m.insert_or_assign(message_services::models::generate_bsm_msg_key(temporary_id[vehicle], msg_count_of(round), sec_mark_of(round)), round);
+            mp_packed_m.insert_or_assign(message_services::models::generate_sender_timestamp_key(sender_id[vehicle], timestamp_bucket_of(round)), round);
+            if (round == 0)
+            {
+                continue;
+            }
+
+            auto bsm_msg_key = message_services::models::generate_bsm_msg_key(temporary_id[vehicle], msg_count_of(round - 1), sec_mark_of(round - 1));
+            auto mp_msg_key = message_services::models::generate_sender_timestamp_key(sender_id[vehicle], timestamp_bucket_of(round - 1));
+            const int64_t *bsm_round = bsm_packed_m.find(bsm_msg_key);
+            const int64_t *mp_round = mp_packed_m.find(mp_msg_key);
+            if (bsm_round != nullptr && mp_round != nullptr)
+            {
+                packed_joined += *bsm_round + *mp_round >= 0 ? 1 : 0;
+                bsm_packed_m.erase(bsm_msg_key);
+                mp_packed_m.erase(mp_msg_key);
+            }
+        }
+    }
+    double packed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / packed_joined;
+
+    ASSERT_EQ(vehicle_count * (round_count - 1), string_joined);
+    ASSERT_EQ(vehicle_count * (round_count - 1), packed_joined);
+    SPDLOG_INFO("Join cost per VSI with {0} vehicles: string keys in std::map {1:.0f} ns, packed keys in packed_key_map {2:.0f} ns ({3:.1f}x)",
+                vehicle_count, string_ns, packed_ns, string_ns / packed_ns);
+}
@@ -0,0 +1,64 @@
+#ifndef LANELET_MAP_SNAPSHOT_H
+#define LANELET_MAP_SNAPSHOT_H
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace message_services
+{
+    namespace message_translations
+    {
+        /**
+         * @brief Intersection facts of a lanelet stored in the map snapshot, derived from its regulatory elements and the routing graph.
+         * **/
+        typedef struct lanelet_snapshot_roles
+        {
+            bool is_all_way_stop = false;
+            // First lanelet preceding this lanelet in the routing graph
+            lanelet::Id previous = lanelet::InvalId;
+            // Lanelets following this lanelet in the routing graph, in routing graph order
+            std::vector<lanelet::Id> following;
+        } lanelet_snapshot_roles_t;
+
+        /**
+         * @brief Hash (64 bit FNV-1a) of the content of a file, used to check that a snapshot was built from the current map.
+         * @param filename path of the file.
+         * @param hash updated with the hash of the file content.
+         * @return true if the file could be read.
+         * **/
+        bool hash_lanelet_map_file(const std::string &filename, uint64_t &hash);
+
+        /**
+         * @brief Write a binary snapshot of the lanelets of a map: points, lanelet bounds, lanelet attributes, the intersection roles and the
+         * projection frame. The snapshot is written to a temporary file and renamed, so readers never see a partial snapshot.
+         * @param snapshot_filename path of the snapshot.
+         * @param source_hash hash of the osm map the lanelets were read from.
+         * @param target_frame projection frame of the map.
+         * @param map lanelets to store.
+         * @param roles intersection roles by lanelet id.
+         * @return true if the snapshot was written.
+         * **/
+        bool write_lanelet_map_snapshot(const std::string &snapshot_filename, uint64_t source_hash, const std::string &target_frame,
+                                        const lanelet::LaneletMap &map, const std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles);
+
+        /**
+         * @brief Read a binary snapshot written by write_lanelet_map_snapshot. The snapshot file is memory mapped and the lanelets are rebuilt
+         * from it without parsing the osm map. Regulatory elements are not stored, their intersection roles are returned instead.
+         * @param snapshot_filename path of the snapshot.
+         * @param source_hash hash of the current osm map. Snapshots of another map are rejected.
+         * @param target_frame updated with the projection frame of the map.
+         * @param map updated with a map of the stored lanelets.
+         * @param roles updated with the intersection roles by lanelet id.
+         * @return true if the snapshot exists, is valid and was built from the current osm map.
+         * **/
+        bool read_lanelet_map_snapshot(const std::string &snapshot_filename, uint64_t source_hash, std::string &target_frame,
+                                       lanelet::LaneletMapPtr &map, std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles);
+    }
+}
+
+#endif
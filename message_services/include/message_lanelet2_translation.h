@@ -46,18 +46,57 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <map>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <intersection_lanelet_type.h>
 #include <trajectory.h>
+#include "lanelet_map_snapshot.h"
 
 namespace message_services
 {
     namespace message_translations
     {
+        /**
+         * @brief Lanelet of a vehicle from its last position lookup.
+         * **/
+        typedef struct vehicle_lanelet_track
+        {
+            lanelet::Id lanelet_id = lanelet::InvalId;
+            // Time of the last update in unit of milliseconds
+            std::time_t updated_timestamp = 0;
+        } vehicle_lanelet_track_t;
+
+        /**
+         * @brief Map frame points of a trajectory stored as separate coordinate arrays. Point 0 is the trajectory location and point i
+         * is the location plus the first i offsets.
+         * **/
+        typedef struct trajectory_map_points
+        {
+            std::vector<double> x;
+            std::vector<double> y;
+            std::vector<double> z;
+
+            size_t size() const
+            {
+                return x.size();
+            }
+
+            lanelet::BasicPoint3d at(size_t index) const
+            {
+                return lanelet::BasicPoint3d(x[index], y[index], z[index]);
+            }
+        } trajectory_map_points_t;
+
         class message_lanelet2_translation
         {
         private:
             lanelet::LaneletMapPtr map_ptr;
             lanelet::projection::LocalFrameProjector *local_projector;
+            // The projector is not safe for concurrent projections from the composition threads
+            mutable std::mutex projector_mtx;
             double laneChangeCost = 2.;
             double participantHeight = 2.;
             double minLaneChangeLength = 0.;
@@ -69,13 +108,122 @@ namespace message_services
             // Routing graph is used to store the possible routing set
             lanelet::routing::RoutingGraphPtr vehicleGraph_ptr;
 
+            // Snapshot of the map lanelets and their roles, empty if the map is always read from the osm file
+            std::string map_snapshot_filename;
+            // Hash and projection frame of the osm file the map was read from, to write the snapshot once the roles are built
+            uint64_t map_source_hash = 0;
+            std::string map_target_frame;
+            // The routing graph neighbours of the cached lanelets are set, from the routing graph or from the map snapshot
+            bool lanelet_roles_ready = false;
+
+            /**
+             * @brief Lanelet geometry converted once when the map is read, for the point to lanelet lookups.
+             * **/
+            typedef struct cached_lanelet
+            {
+                lanelet::Lanelet lanelet;
+                lanelet::BasicPolygon2d polygon;
+                lanelet::BasicLineString2d centerline;
+                // Value of the turn_direction attribute, empty if the lanelet has none
+                std::string turn_direction;
+                bool has_turn_direction = false;
+                // The lanelet has an all_way_stop regulatory element, which makes it an intersection entry lanelet
+                bool is_all_way_stop = false;
+                // Routing graph neighbours as indexes in cached_lanelets, set by build_lanelet_roles
+                size_t previous = SIZE_MAX;
+                std::vector<size_t> following;
+            } cached_lanelet_t;
+
+            std::vector<cached_lanelet_t> cached_lanelets;
+            // Index in cached_lanelets by lanelet id - cached_lanelet_min_id, SIZE_MAX for ids without lanelet
+            std::vector<size_t> cached_lanelet_index_v;
+            lanelet::Id cached_lanelet_min_id = 0;
+            // Maximum span of lanelet ids indexed by cached_lanelet_index_v
+            const size_t _maximum_lanelet_id_span = 1 << 22;
+            // Index by lanelet id of maps with an id span too large for cached_lanelet_index_v
+            std::unordered_map<lanelet::Id, size_t> cached_lanelet_index_m;
+
+            // Side length of a grid cell in meters. The grid covers the bounding box of all lanelets in the map.
+            const double _lanelet_grid_cell_size = 5.0;
+            // Upper bound of the number of grid cells, the cell size is increased for large maps.
+            const size_t _maximum_num_lanelet_grid_cells = 1 << 20;
+            double grid_min_x = 0;
+            double grid_min_y = 0;
+            double grid_cell_size = 0;
+            size_t grid_cols = 0;
+            size_t grid_rows = 0;
+            // Candidate lanelets of cell c are grid_cell_lanelets[grid_cell_offsets[c]] to grid_cell_lanelets[grid_cell_offsets[c + 1] - 1],
+            // as indexes in cached_lanelets.
+            std::vector<uint32_t> grid_cell_offsets;
+            std::vector<uint32_t> grid_cell_lanelets;
+
+            // Tracks of vehicles not updated within the timeout are removed once the number of tracks exceeds the maximum.
+            const std::time_t _vehicle_lanelet_track_timeout_milli_sec = 10000;
+            const size_t _maximum_num_vehicle_lanelet_tracks = 1024;
+            std::unordered_map<std::string, vehicle_lanelet_track_t> vehicle_lanelet_tracks;
+            mutable std::mutex vehicle_lanelet_tracks_mtx;
+
+            /**
+             * @brief Build the lanelet geometry cache and the uniform grid of candidate lanelets per cell from the current map.
+             */
+            void build_lanelet_grid();
+
+            /**
+             * @brief Index of the lanelet in cached_lanelets.
+             * @return cached_lanelets size if the lanelet is not in the map.
+             */
+            size_t cached_lanelet_index(lanelet::Id lanelet_id) const;
+
+            /**
+             * @brief Fill the routing graph neighbours of the cached lanelets, once the routing graph is built.
+             */
+            void build_lanelet_roles();
+
+            /**
+             * @brief Set the all way stop flags and routing graph neighbours of the cached lanelets from the map snapshot.
+             */
+            void apply_lanelet_roles(const std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles);
+
+            /**
+             * @brief Write the map snapshot from the cached lanelets once their roles are built.
+             */
+            void write_map_snapshot() const;
+
+            /**
+             * @brief 2D distance between the point and the lanelet centerline, from the cached centerline when available.
+             */
+            double distance2_centerline(const lanelet::BasicPoint2d &subj_point2d, const lanelet::Lanelet &subj_lanelet) const;
+
+            /**
+             * @brief Identify the current lanelet of the point, using the trajectory start and destination points to choose between
+             * lanelets of the same turn direction.
+             * @param trajectory_ends callable bool(lanelet::BasicPoint3d &start, lanelet::BasicPoint3d &dest) returning false if the
+             * trajectory has no offsets.
+             */
+            template <typename TrajectoryEnds>
+            lanelet::Lanelet select_cur_lanelet(const lanelet::BasicPoint3d &subj_point3d, const std::string &turn_direction, TrajectoryEnds trajectory_ends) const;
+
+            /**
+             * @brief Find the lanelet of the point among the tracked lanelet and its successors in the routing graph. A tracked link lanelet
+             * whose turn direction differs from a known turn direction is not kept.
+             * @return Index of the lanelet in cached_lanelets; \n Return cached_lanelets size if the point is in none of them, the successor is ambiguous
+             * or the tracked link lanelet no longer matches the turn direction.
+             */
+            size_t find_tracked_lanelet(const lanelet::BasicPoint2d &subj_point2d, lanelet::Id tracked_lanelet_id, const std::string &turn_direction) const;
+
         public:
             message_lanelet2_translation(/* args */);
             message_lanelet2_translation(std::string filename);
+            /**
+             * @param filename path to lanelet2 osm map.
+             * @param snapshot_filename path to the map snapshot. The map is read from the snapshot when it was built from the same osm
+             * map, which skips the osm parsing and the routing graph build. Otherwise the snapshot is rebuilt from the osm map.
+             */
+            message_lanelet2_translation(std::string filename, std::string snapshot_filename);
             ~message_lanelet2_translation();
 
             /**
-             * @brief Read lanelet2 map.
+             * @brief Read lanelet2 map, from the map snapshot if one is set and was built from the same osm map.
              * @param filename path to lanelet2 osm map.
              * @return true if no exception and map pointer is updated.
              */
@@ -98,14 +246,51 @@ namespace message_services
              * @return Current Lanelet of the point; \n Return lanelet with id 0 if cannot find the current lanelet.
              **/
              lanelet::Lanelet get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory& trajectory) const;
+
+            /***
+             * @brief Identify the current lanelet with the given map point and vehicle turn direction, with the trajectory already
+             * converted into map points.
+             * @param BasicPoint3d 
+             * @param turn_direction (Optional if position is not in intersection bridge/link lanelet).
+             * @param trajectory_points the vehicle trajectory from trajectory_2_map_points.
+             * @return Current Lanelet of the point; \n Return lanelet with id 0 if cannot find the current lanelet.
+             **/
+            lanelet::Lanelet get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, const trajectory_map_points_t &trajectory_points) const;
+
+            /***
+             * @brief Identify the current lanelet of the vehicle from its previous lanelet. The previous lanelet and its successors are tested
+             * first, the current lanelet is searched with get_cur_lanelet_by_point_and_direction if the vehicle is in none of them.
+             * @param vehicle_id 
+             * @param BasicPoint3d 
+             * @param turn_direction (Optional if position is not in intersection bridge/link lanelet).
+             * @return Current Lanelet of the point; \n Return lanelet with id 0 if cannot find the current lanelet.
+             **/
+            lanelet::Lanelet get_cur_lanelet_by_vehicle_and_direction(const std::string &vehicle_id, lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory& trajectory);
+
+            /***
+             * @brief Get the lanelet track of the vehicle.
+             * @param vehicle_id 
+             * @param track updated with the vehicle lanelet track if found.
+             * @return true if the vehicle is tracked, otherwise false.
+             **/
+            bool get_vehicle_lanelet_track(const std::string &vehicle_id, vehicle_lanelet_track_t &track) const;
             
              /***
              * @brief Identify the current lanelet with the given vehicle geo-loc (convert into map point).
+             * Candidate lanelets are read from the grid cell of the point and tested against their cached polygons.
              * @param BasicPoint3d 
              * @return a vector of lanelets; \n Return empty vetor if cannot find the current lanelets.
              **/
             std::vector<lanelet::Lanelet> get_cur_lanelets_by_point(lanelet::BasicPoint3d subj_point3d) const;
 
+            /***
+             * @brief Identify the current lanelets of the point with the nearest lanelets search in the map R-tree.
+             * Used for points outside of the lanelet grid.
+             * @param BasicPoint3d 
+             * @return a vector of maximum three lanelets; \n Return empty vetor if cannot find the current lanelets.
+             **/
+            std::vector<lanelet::Lanelet> find_cur_lanelets_in_rtree(lanelet::BasicPoint3d subj_point3d) const;
+
             /***
              * @brief The distance between the vehicle’s current position and the end of its current lane with the given vehicle geo-loc and vehicle turn direction.
              * @param latitude 
@@ -147,6 +332,15 @@ namespace message_services
             */
             lanelet::BasicPoint3d ecef_2_map_point(std::int32_t ecef_x, std::int32_t ecef_y, std::int32_t ecef_z) const;
 
+            /**
+            * @brief Function to convert all points of a trajectory to the map frame in one call. The trajectory location is projected
+            * and the projection is linearized around it, the offsets are converted with the linearized projection. The error stays
+            * within millimeters for trajectories of a few hundred meters.
+            * @param trajectory ecef location and offsets
+            * @return map points of the location and of each offset
+            */
+            trajectory_map_points_t trajectory_2_map_points(const models::trajectory &trajectory) const;
+
             /**
             * @brief Function to convert GPS location to a 3d point in map frame
             * @param GPS location point
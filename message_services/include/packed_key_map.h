@@ -0,0 +1,209 @@
+#ifndef PACKED_KEY_MAP_H
+#define PACKED_KEY_MAP_H
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "msg_key.h"
+
+namespace message_services
+{
+    namespace workers
+    {
+        /**
+         * @brief Open addressing hash table from models::msg_key_t to V, with linear probing and backward shift deletion so
+         * that lookups never walk over tombstones. Slots are stored contiguously and the table doubles when it is more than
+         * 70% full. V must be default constructible and move assignable. Not thread safe.
+         * **/
+        template <class V>
+        class packed_key_map
+        {
+        private:
+            typedef struct slot
+            {
+                models::msg_key_t key;
+                V value;
+                bool occupied = false;
+            } slot_t;
+
+            std::vector<slot_t> slots;
+            std::size_t count = 0;
+            std::size_t mask = 0;
+
+            std::size_t home_of(const models::msg_key_t &key) const
+            {
+                return models::msg_key_hash()(key) & mask;
+            }
+
+            /**
+             * @brief Position of key, or of the empty slot ending its probe sequence.
+             * **/
+            std::size_t position_of(const models::msg_key_t &key) const
+            {
+                std::size_t pos = home_of(key);
+                while (slots[pos].occupied && slots[pos].key != key)
+                {
+                    pos = (pos + 1) & mask;
+                }
+                return pos;
+            }
+
+            void grow()
+            {
+                std::vector<slot_t> old_slots(slots.size() * 2);
+                old_slots.swap(slots);
+                mask = slots.size() - 1;
+                for (auto &old_slot : old_slots)
+                {
+                    if (old_slot.occupied)
+                    {
+                        slot_t &new_slot = slots[position_of(old_slot.key)];
+                        new_slot.key = old_slot.key;
+                        new_slot.value = std::move(old_slot.value);
+                        new_slot.occupied = true;
+                    }
+                }
+            }
+
+            /**
+             * @brief Empty the slot at pos and shift back the following entries of the cluster whose probe sequence passes through the emptied slot.
+             * **/
+            void erase_at(std::size_t pos)
+            {
+                std::size_t next = (pos + 1) & mask;
+                while (slots[next].occupied)
+                {
+                    // The entry at next may move to pos only if its home slot is not after pos in the probe order
+                    if (((next - home_of(slots[next].key)) & mask) >= ((next - pos) & mask))
+                    {
+                        slots[pos].key = slots[next].key;
+                        slots[pos].value = std::move(slots[next].value);
+                        pos = next;
+                    }
+                    next = (next + 1) & mask;
+                }
+                slots[pos].value = V();
+                slots[pos].occupied = false;
+                count--;
+            }
+
+        public:
+            /**
+             * @param initial_capacity number of slots allocated up front, rounded up to a power of two.
+             * **/
+            explicit packed_key_map(std::size_t initial_capacity = 64)
+            {
+                std::size_t capacity = 8;
+                while (capacity < initial_capacity)
+                {
+                    capacity <<= 1;
+                }
+                slots.resize(capacity);
+                mask = capacity - 1;
+            }
+
+            /**
+             * @return pointer to the value of key, nullptr if not found. Invalidated by insert_or_assign and erase.
+             * **/
+            V *find(const models::msg_key_t &key)
+            {
+                slot_t &found = slots[position_of(key)];
+                return found.occupied ? &found.value : nullptr;
+            }
+
+            const V *find(const models::msg_key_t &key) const
+            {
+                const slot_t &found = slots[position_of(key)];
+                return found.occupied ? &found.value : nullptr;
+            }
+
+            /**
+             * @brief Insert value, replacing the value already stored for key.
+             * @return reference to the stored value.
+             * **/
+            V &insert_or_assign(const models::msg_key_t &key, V value)
+            {
+                if ((count + 1) * 10 > slots.size() * 7)
+                {
+                    grow();
+                }
+                slot_t &found = slots[position_of(key)];
+                if (!found.occupied)
+                {
+                    found.key = key;
+                    found.occupied = true;
+                    count++;
+                }
+                found.value = std::move(value);
+                return found.value;
+            }
+
+            /**
+             * @return true if key was found and removed.
+             * **/
+            bool erase(const models::msg_key_t &key)
+            {
+                std::size_t pos = position_of(key);
+                if (!slots[pos].occupied)
+                {
+                    return false;
+                }
+                erase_at(pos);
+                return true;
+            }
+
+            /**
+             * @brief Remove all entries for which pred(key, value) returns true.
+             * @return number of removed entries.
+             * **/
+            template <class Predicate>
+            std::size_t erase_if(Predicate pred)
+            {
+                std::size_t removed = 0;
+                std::size_t pos = 0;
+                while (pos < slots.size())
+                {
+                    // erase_at may shift a following entry into pos, so pos is checked again after an erase
+                    if (slots[pos].occupied && pred(slots[pos].key, slots[pos].value))
+                    {
+                        erase_at(pos);
+                        removed++;
+                    }
+                    else
+                    {
+                        pos++;
+                    }
+                }
+                return removed;
+            }
+
+            void clear()
+            {
+                for (auto &s : slots)
+                {
+                    s.value = V();
+                    s.occupied = false;
+                }
+                count = 0;
+            }
+
+            std::size_t size() const
+            {
+                return count;
+            }
+
+            bool empty() const
+            {
+                return count == 0;
+            }
+
+            std::size_t capacity() const
+            {
+                return slots.size();
+            }
+        };
+    }
+}
+
+#endif
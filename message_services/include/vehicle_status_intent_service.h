@@ -11,6 +11,8 @@
 #include "mobilitypath_worker.h"
 #include "mobilityoperation_worker.h"
 #include "vehicle_status_intent_worker.h"
+#include "vsi_join_worker.h"
+#include "vsi_composition_pool.h"
 #include "vehicle_status_intent.h"
 #include "kafka_client.h"
 #include "message_lanelet2_translation.h"
@@ -22,28 +24,18 @@ namespace message_services
 {
     namespace services
     {
-        typedef struct vsi_message_bucket
-        {
-            models::mobilityoperation mo;
-            models::bsm bsm;
-            models::mobilitypath mp;
-        } vsi_message_bucket_t;
-
         class vehicle_status_intent_service
         {
         private:
             std::string bootstrap_server;
-            std::string bsm_group_id;
+            std::string consumer_group_id;
             std::string bsm_topic_name;
-            std::string mo_group_id;
             std::string mo_topic_name;
-            std::string mp_group_id;
             std::string mp_topic_name;
             std::string vsi_topic_name;
-            std::shared_ptr<kafka_clients::kafka_producer_worker> _vsi_producer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _mo_consumer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _mp_consumer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _bsm_consumer_worker;
+            std::shared_ptr<kafka_clients::producer_transport> _vsi_producer_worker;
+            // Single consumer subscribed to the BSM, MobilityOperation and MobilityPath topics
+            std::shared_ptr<kafka_clients::consumer_transport> _consumer_worker;
             std::int64_t vsi_est_path_point_count = 0;
             bool disable_est_path = false; // false: Show est path in the vsi message. true: Not show
             /***
@@ -55,23 +47,23 @@ namespace message_services
             //Mapping MobilityOperation and BSM msg_count maximum allowed differences.
             std::int32_t MOBILITY_OPERATION_BSM_MAX_COUNT_OFFSET = 0;
 
-            //Mapping MobilityOperation and MobilityPath timestamp duration within 1000 ms.
-            std::int32_t MOBILITY_OPERATION_PATH_MAX_DURATION = 1000; 
-
             //The duration between the offset points in mobilitypath message. Default duration is MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION * 100 (milliseconds)
             std::uint32_t MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION = 1;
 
-            //Publish vehicle status intent thread sleep time.
-            unsigned int VSI_TH_SLEEP_MILLI_SEC = 100; 
+            //Maximum time a BSM, MobilityPath or MobilityOperation message waits for its matching messages.
+            std::int64_t VSI_JOIN_WINDOW_MILLI_SEC = 1000;
 
-            //Expire BSM message from the queue after duration. Default value is 6 seconds
-            unsigned long BSM_MSG_EXPIRE_IN_SEC = 6; 
+            //Maximum number of MobilityOperation messages of one vehicle waiting for their BSM and MobilityPath.
+            std::int64_t VSI_JOIN_MAX_PENDING_PER_VEHICLE = 10;
 
-            //Clean the queue every CLEAN_QUEUE_IN_SECS; 
-            std::int32_t CLEAN_QUEUE_IN_SECS = 0;
+            //Number of threads composing and publishing vehicle status and intent messages.
+            std::int64_t VSI_COMPOSITION_WORKER_COUNT = 1;
 
-            //Tracking last message expired timestamp
-            std::time_t prev_msg_expired_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();                      
+            //Maximum number of joined messages waiting for each composition thread.
+            std::int64_t VSI_COMPOSITION_QUEUE_SIZE = 1024;
+
+            // Composition threads draining the joined messages, sharded by vehicle id
+            std::shared_ptr<workers::vsi_composition_pool> _composition_pool;
 
             //add lanelet2 translation object
             std::shared_ptr<message_translations::message_lanelet2_translation> _msg_lanelet2_translate_ptr;
@@ -95,12 +87,11 @@ namespace message_services
             void start();
 
             /**
-             * @brief Creating and running threads. Each thread is acting as consumer or producer to consume or produce messages to topics
-             * @param pointers to workers that will be used to work on messages that are consumed
+             * @brief Creating and running the consumer thread. Vehicle status and intent messages are composed and published by the composition
+             * pool as soon as the last of the matching BSM, MobilityOperation and MobilityPath messages is consumed.
+             * @param pointer to the worker joining the consumed messages
              * **/
-            void run(std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr,
-                     std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr,
-                     std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr);
+            void run(std::shared_ptr<message_services::workers::vsi_join_worker> join_w_ptr);
 
             /**
              * @brief Generate the vehicle status and intent message based on the latest bsm , MobilityOperation and MobilityPath objects.
@@ -109,18 +100,32 @@ namespace message_services
             models::vehicle_status_intent compose_vehicle_status_intent(models::bsm &bsm, models::mobilityoperation &mo, models::mobilitypath &mp);
 
             /**
-             * @brief Consume a message from particular topic and convert the message as an object. Then  append the message to its corresponding worker
-             * @param pointers to object that will store the message consumed. topic from which the message is from. The group id of the consumer
+             * @brief Consume the BSM, MobilityPath and MobilityOperation topics from one poll loop and join each message with the messages
+             * of the same vehicle. Queue each completed join to the composition pool.
+             * @param pointer to the worker joining the consumed messages
+             * **/
+            void msg_consumer(std::shared_ptr<workers::vsi_join_worker> join_w_ptr);
+
+            /**
+             * @brief Convert a consumed message as an object
+             * @param consumed message, and the object to fill
+             * @return true if the message payload was parsed
              * **/
             template <class T>
-            void msg_consumer(std::shared_ptr<T> msg_ptr,  std::shared_ptr<kafka_clients::kafka_consumer_worker>  consumer_worker);
+            static bool parse_msg(const kafka_clients::kafka_message &msg, T &msg_obj);
+
+            /**
+             * @brief Compose the vehicle status and intent message from joined messages and publish it
+             * @param the joined BSM, MobilityOperation and MobilityPath messages
+             * **/
+            void publish_vsi(workers::vsi_message_bucket_t &joined);
 
             /**
              * @brief Producer a message to a topic
              * @param pointer to object that will be published, and a topic name
              * **/
             template <typename T>
-            void publish_msg(T msg,  std::shared_ptr<kafka_clients::kafka_producer_worker>  producer_worker);
+            void publish_msg(T msg,  std::shared_ptr<kafka_clients::producer_transport>  producer_worker);
         };
     }
 }
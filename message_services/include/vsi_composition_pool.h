@@ -0,0 +1,91 @@
+#ifndef VSI_COMPOSITION_POOL_H
+#define VSI_COMPOSITION_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bounded_mpmc_queue.h"
+#include "vsi_join_worker.h"
+
+namespace message_services
+{
+    namespace workers
+    {
+        /**
+         * @brief Pool of threads composing and publishing vehicle status and intent messages from joined messages. Each worker drains
+         * its own lock free queue, and the joined messages of a vehicle always go to the same worker, so the messages of one vehicle
+         * are composed in the order they were joined.
+         * **/
+        class vsi_composition_pool
+        {
+        private:
+            /**
+             * @brief Wakes a worker blocked on its empty queue.
+             * **/
+            typedef struct worker_signal
+            {
+                std::mutex mtx;
+                std::condition_variable cv;
+                // Messages pushed and not yet popped. Can be briefly negative since a pop can complete before the count of its push
+                std::atomic<int64_t> pending{0};
+                // The worker is blocked, or about to block, on cv
+                std::atomic<bool> sleeping{false};
+            } worker_signal_t;
+
+            std::vector<std::unique_ptr<kafka_clients::bounded_mpmc_queue<vsi_message_bucket_t>>> queues;
+            std::vector<std::unique_ptr<worker_signal_t>> signals;
+            std::vector<std::thread> threads;
+            std::function<void(vsi_message_bucket_t &)> compose_handler;
+            std::atomic<bool> running{false};
+
+            /**
+             * @brief Compose the joined messages of one queue until the pool is stopped and the queue is drained. The worker blocks
+             * when its queue stays empty.
+             * **/
+            void run_worker(size_t index);
+
+        public:
+            /**
+             * @param worker_count number of composition threads, at least one.
+             * @param queue_size capacity of the queue of each worker.
+             * @param compose_handler called on a worker thread for each joined message bucket.
+             * **/
+            vsi_composition_pool(size_t worker_count, size_t queue_size, std::function<void(vsi_message_bucket_t &)> compose_handler);
+            vsi_composition_pool(const vsi_composition_pool &) = delete;
+            vsi_composition_pool &operator=(const vsi_composition_pool &) = delete;
+            ~vsi_composition_pool();
+
+            /**
+             * @brief Start the composition threads.
+             * **/
+            void start();
+
+            /**
+             * @brief Stop the composition threads once their queues are drained. Messages submitted while stopping may not be composed.
+             * **/
+            void stop();
+
+            /**
+             * @brief Queue joined messages to the worker of the vehicle. Waits while the worker queue is full, which throttles the
+             * consumer when composition falls behind.
+             * @param joined the joined BSM, MobilityOperation and MobilityPath messages.
+             * @return false if the pool is not running.
+             * **/
+            bool submit(vsi_message_bucket_t &&joined);
+
+            /**
+             * @brief Index of the worker composing the messages of a vehicle.
+             * **/
+            size_t worker_index(const std::string &vehicle_id) const;
+
+            size_t worker_count() const;
+        };
+    }
+}
+
+#endif
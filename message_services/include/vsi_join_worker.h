@@ -0,0 +1,173 @@
+#ifndef VSI_JOIN_WORKER_H
+#define VSI_JOIN_WORKER_H
+
+#include <iostream>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "bsm.h"
+#include "mobilityoperation.h"
+#include "mobilitypath.h"
+#include "msg_key.h"
+#include "packed_key_map.h"
+#include "pipeline_trace.h"
+
+namespace message_services
+{
+    namespace workers
+    {
+        /**
+         * @brief The BSM, MobilityOperation and MobilityPath messages of one vehicle used to compose a vehicle status and intent message.
+         * **/
+        typedef struct vsi_message_bucket
+        {
+            models::mobilityoperation mo;
+            models::bsm bsm;
+            models::mobilitypath mp;
+            // Pipeline trace of the message completing the join
+            kafka_clients::trace_context trace;
+        } vsi_message_bucket_t;
+
+        /**
+         * @brief Event driven join of BSM, MobilityOperation and MobilityPath messages. A MobilityOperation references its BSM by
+         * (BSM id, msg_count, sec_mark) and its MobilityPath by (sender id, timestamp in seconds). Each process_* call joins the
+         * incoming message with the messages already received, so the arrival of the last of the three matching messages completes
+         * the join immediately. Messages wait at most the join window for their matches, and at most max_pending_per_vehicle
+         * MobilityOperation messages wait per vehicle.
+         * **/
+        class vsi_join_worker
+        {
+        private:
+            /**
+             * @brief A MobilityOperation message waiting for its BSM and/or MobilityPath, with its join keys.
+             * **/
+            typedef struct pending_mobilityoperation
+            {
+                models::mobilityoperation mo;
+                models::msg_key_t bsm_msg_key;
+                models::msg_key_t mp_msg_key;
+            } pending_mobilityoperation_t;
+
+            enum class expiry_kind
+            {
+                bsm,
+                mobilitypath,
+                mobilityoperation
+            };
+
+            /**
+             * @brief A message to remove from the join window once it is older than the join window. Entries of messages that were
+             * joined or replaced in the meantime are skipped when they expire.
+             * **/
+            typedef struct expiry_entry
+            {
+                std::time_t timestamp;
+                expiry_kind kind;
+                models::msg_key_t key;
+                std::string sender_id;
+            } expiry_entry_t;
+
+            // BSM messages by bsm msg key (BSM id, msg_count, sec_mark)
+            packed_key_map<models::bsm> bsm_m;
+            // MobilityPath messages by sender timestamp key (sender id, timestamp in seconds)
+            packed_key_map<models::mobilitypath> mp_m;
+            // MobilityOperation messages waiting for their matches by sender id, in arrival order
+            std::unordered_map<std::string, std::deque<pending_mobilityoperation_t>> pending_mo_m;
+            // Sender id of the pending MobilityOperation messages by the bsm msg key they are waiting for
+            packed_key_map<std::string> pending_bsm_msg_key_m;
+            // Time ordered index of all stored messages, oldest first
+            std::deque<expiry_entry_t> expiry_q;
+
+            std::time_t join_window_milli_sec;
+            size_t max_pending_per_vehicle;
+            std::mutex worker_mtx;
+
+            /**
+             * @brief Complete the join of a MobilityOperation if both its BSM and MobilityPath are available. Matched BSM and
+             * MobilityPath are removed so that each of them is used for one vehicle status and intent message. Caller holds worker_mtx.
+             * @param pending MobilityOperation message with its join keys.
+             * @param cur_timestamp current time in milliseconds since epoch. Messages older than the join window do not match.
+             * @param joined bucket filled with the three messages if the join completed.
+             * @return true if the join completed.
+             * **/
+            bool try_join(pending_mobilityoperation_t &pending, std::time_t cur_timestamp, vsi_message_bucket_t &joined);
+
+            /**
+             * @brief Remove a pending MobilityOperation from the per vehicle queue and the bsm msg key index.
+             * @param sender_itr position of the vehicle queue in pending_mo_m.
+             * @param pending_itr position of the MobilityOperation in the vehicle queue.
+             * **/
+            void erase_pending(std::unordered_map<std::string, std::deque<pending_mobilityoperation_t>>::iterator sender_itr,
+                               std::deque<pending_mobilityoperation_t>::iterator pending_itr);
+
+            /**
+             * @brief Append a stored message to the time ordered index. A timestamp older than the newest entry is raised to it to keep the
+             * index sorted, so such a message expires at most that much later. Caller holds worker_mtx.
+             * @param timestamp message received timestamp in milliseconds since epoch.
+             * @param kind type of the message.
+             * @param key key of the BSM or MobilityPath.
+             * @param sender_id sender of the MobilityOperation.
+             * **/
+            void schedule_expiry(std::time_t timestamp, expiry_kind kind, const models::msg_key_t &key, const std::string &sender_id);
+
+            /**
+             * @brief Remove the messages received more than the join window before cur_timestamp by popping the front of the time
+             * ordered index, so the cost is proportional to the number of expired entries. Caller holds worker_mtx.
+             * @return number of messages removed.
+             * **/
+            size_t expire_locked(std::time_t cur_timestamp);
+
+        public:
+            /**
+             * @param join_window_milli_sec maximum time a message waits for its matching messages.
+             * @param max_pending_per_vehicle maximum number of MobilityOperation messages waiting per vehicle. The oldest is dropped when exceeded.
+             * **/
+            explicit vsi_join_worker(std::time_t join_window_milli_sec = 1000, size_t max_pending_per_vehicle = 10);
+            ~vsi_join_worker() = default;
+
+            //Mapping MobilityOperation and MobilityPath timestamp duration within 1000 ms.
+            static constexpr uint16_t MOBILITY_OPERATION_PATH_MAX_DURATION = 1000;
+
+            /**
+             * @brief Store an incoming BSM and join it with the pending MobilityOperation referencing it.
+             * @param bsm incoming BSM.
+             * @param joined bucket filled with the three messages if the join completed.
+             * @return true if a vehicle status and intent message can be composed from joined.
+             * **/
+            bool process_bsm(models::bsm bsm, vsi_message_bucket_t &joined);
+
+            /**
+             * @brief Store an incoming MobilityPath and join it with the oldest pending MobilityOperation of the same vehicle and second.
+             * @param mp incoming MobilityPath.
+             * @param joined bucket filled with the three messages if the join completed.
+             * @return true if a vehicle status and intent message can be composed from joined.
+             * **/
+            bool process_mobilitypath(models::mobilitypath mp, vsi_message_bucket_t &joined);
+
+            /**
+             * @brief Join an incoming MobilityOperation with its BSM and MobilityPath, or keep it pending until they arrive.
+             * @param mo incoming MobilityOperation.
+             * @param joined bucket filled with the three messages if the join completed.
+             * @return true if a vehicle status and intent message can be composed from joined.
+             * **/
+            bool process_mobilityoperation(models::mobilityoperation mo, vsi_message_bucket_t &joined);
+
+            /**
+             * @brief Remove all messages received more than the join window before cur_timestamp. Also done by each process_* call
+             * with the incoming message timestamp.
+             * @param cur_timestamp current time in milliseconds since epoch.
+             * @return number of messages removed.
+             * **/
+            size_t expire(std::time_t cur_timestamp);
+
+            size_t get_bsm_count();
+            size_t get_mobilitypath_count();
+            size_t get_pending_mobilityoperation_count();
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,399 @@
+#include "lanelet_map_snapshot.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace message_services
+{
+    namespace message_translations
+    {
+        namespace
+        {
+            const char SNAPSHOT_MAGIC[8] = {'C', 'S', 'L', 'L', 'S', 'N', 'A', 'P'};
+            // Increase when the snapshot layout changes, snapshots of another version are rebuilt
+            const uint32_t SNAPSHOT_VERSION = 1;
+            const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+            const uint64_t FNV_PRIME = 1099511628211ULL;
+
+            /**
+             * @brief Read only memory mapping of a file, unmapped on destruction.
+             * **/
+            class mapped_file
+            {
+            public:
+                const char *data = nullptr;
+                size_t size = 0;
+
+                explicit mapped_file(const std::string &filename)
+                {
+                    int fd = ::open(filename.c_str(), O_RDONLY);
+                    if (fd < 0)
+                    {
+                        return;
+                    }
+                    struct stat file_stat;
+                    if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+                    {
+                        void *addr = ::mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (addr != MAP_FAILED)
+                        {
+                            data = static_cast<const char *>(addr);
+                            size = static_cast<size_t>(file_stat.st_size);
+                        }
+                    }
+                    ::close(fd);
+                }
+                mapped_file(const mapped_file &) = delete;
+                mapped_file &operator=(const mapped_file &) = delete;
+                ~mapped_file()
+                {
+                    if (data)
+                    {
+                        ::munmap(const_cast<char *>(data), size);
+                    }
+                }
+            };
+
+            /**
+             * @brief Appends fixed width values in host byte order. Snapshots are only read on the host that wrote them.
+             * **/
+            class snapshot_writer
+            {
+            public:
+                std::string buffer;
+
+                template <typename T>
+                void put(const T &value)
+                {
+                    static_assert(std::is_trivially_copyable<T>::value, "Snapshot values are copied as bytes");
+                    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+                }
+
+                void put_string(const std::string &value)
+                {
+                    put(static_cast<uint32_t>(value.size()));
+                    buffer.append(value);
+                }
+            };
+
+            /**
+             * @brief Reads the values appended by snapshot_writer, failing instead of reading past the end of the snapshot.
+             * **/
+            class snapshot_reader
+            {
+            private:
+                const char *pos;
+                const char *end;
+
+            public:
+                snapshot_reader(const char *data, size_t size) : pos(data), end(data + size) {}
+
+                template <typename T>
+                bool get(T &value)
+                {
+                    if (static_cast<size_t>(end - pos) < sizeof(T))
+                    {
+                        return false;
+                    }
+                    std::memcpy(&value, pos, sizeof(T));
+                    pos += sizeof(T);
+                    return true;
+                }
+
+                bool get_string(std::string &value)
+                {
+                    uint32_t length = 0;
+                    if (!get(length) || static_cast<size_t>(end - pos) < length)
+                    {
+                        return false;
+                    }
+                    value.assign(pos, length);
+                    pos += length;
+                    return true;
+                }
+
+                // Guards the vector reservations against counts of a corrupt snapshot
+                bool has(uint64_t count, size_t element_size) const
+                {
+                    return count <= static_cast<size_t>(end - pos) / element_size;
+                }
+            };
+        }
+
+        bool hash_lanelet_map_file(const std::string &filename, uint64_t &hash)
+        {
+            mapped_file file(filename);
+            if (!file.data)
+            {
+                return false;
+            }
+            hash = FNV_OFFSET_BASIS;
+            for (size_t i = 0; i < file.size; i++)
+            {
+                hash ^= static_cast<unsigned char>(file.data[i]);
+                hash *= FNV_PRIME;
+            }
+            return true;
+        }
+
+        bool write_lanelet_map_snapshot(const std::string &snapshot_filename, uint64_t source_hash, const std::string &target_frame,
+                                        const lanelet::LaneletMap &map, const std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles)
+        {
+            // Lanelet bounds are stored by line string, in the line string point order, with an inverted flag per lanelet, so that
+            // the bounds shared by neighbouring lanelets are rebuilt as one line string.
+            std::vector<lanelet::ConstLineString3d> line_strings;
+            std::unordered_map<lanelet::Id, uint32_t> line_string_index;
+            std::vector<lanelet::ConstPoint3d> points;
+            std::unordered_map<lanelet::Id, uint32_t> point_index;
+            auto add_line_string = [&](const lanelet::ConstLineString3d &bound)
+            {
+                lanelet::ConstLineString3d line_string = bound.inverted() ? bound.invert() : bound;
+                auto inserted = line_string_index.emplace(line_string.id(), static_cast<uint32_t>(line_strings.size()));
+                if (inserted.second)
+                {
+                    line_strings.push_back(line_string);
+                    for (const auto &point : line_string)
+                    {
+                        if (point_index.emplace(point.id(), static_cast<uint32_t>(points.size())).second)
+                        {
+                            points.push_back(point);
+                        }
+                    }
+                }
+                return inserted.first->second;
+            };
+            std::vector<std::pair<uint32_t, uint32_t>> lanelet_bounds;
+            for (const auto &ll : map.laneletLayer)
+            {
+                lanelet_bounds.emplace_back(add_line_string(ll.leftBound3d()), add_line_string(ll.rightBound3d()));
+            }
+
+            snapshot_writer writer;
+            writer.buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+            writer.put(SNAPSHOT_VERSION);
+            writer.put(source_hash);
+            writer.put_string(target_frame);
+
+            writer.put(static_cast<uint64_t>(points.size()));
+            for (const auto &point : points)
+            {
+                writer.put(static_cast<int64_t>(point.id()));
+                writer.put(point.x());
+                writer.put(point.y());
+                writer.put(point.z());
+            }
+
+            writer.put(static_cast<uint64_t>(line_strings.size()));
+            for (const auto &line_string : line_strings)
+            {
+                writer.put(static_cast<int64_t>(line_string.id()));
+                writer.put(static_cast<uint32_t>(line_string.size()));
+                for (const auto &point : line_string)
+                {
+                    writer.put(point_index[point.id()]);
+                }
+            }
+
+            writer.put(static_cast<uint64_t>(map.laneletLayer.size()));
+            size_t lanelet_count = 0;
+            for (const auto &ll : map.laneletLayer)
+            {
+                writer.put(static_cast<int64_t>(ll.id()));
+                writer.put(lanelet_bounds[lanelet_count].first);
+                writer.put(static_cast<uint8_t>(ll.leftBound3d().inverted()));
+                writer.put(lanelet_bounds[lanelet_count].second);
+                writer.put(static_cast<uint8_t>(ll.rightBound3d().inverted()));
+                lanelet_count++;
+
+                writer.put(static_cast<uint32_t>(ll.attributes().size()));
+                for (const auto &attribute : ll.attributes())
+                {
+                    writer.put_string(attribute.first);
+                    writer.put_string(attribute.second.value());
+                }
+
+                lanelet_snapshot_roles_t lanelet_roles;
+                auto roles_itr = roles.find(ll.id());
+                if (roles_itr != roles.end())
+                {
+                    lanelet_roles = roles_itr->second;
+                }
+                writer.put(static_cast<uint8_t>(lanelet_roles.is_all_way_stop));
+                writer.put(static_cast<int64_t>(lanelet_roles.previous));
+                writer.put(static_cast<uint32_t>(lanelet_roles.following.size()));
+                for (auto following_id : lanelet_roles.following)
+                {
+                    writer.put(static_cast<int64_t>(following_id));
+                }
+            }
+
+            std::string tmp_filename = snapshot_filename + ".tmp";
+            {
+                std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+                out.write(writer.buffer.data(), static_cast<std::streamsize>(writer.buffer.size()));
+                if (!out)
+                {
+                    SPDLOG_ERROR("Cannot write map snapshot {0}. ", tmp_filename);
+                    std::remove(tmp_filename.c_str());
+                    return false;
+                }
+            }
+            if (std::rename(tmp_filename.c_str(), snapshot_filename.c_str()) != 0)
+            {
+                SPDLOG_ERROR("Cannot rename map snapshot {0} to {1}. ", tmp_filename, snapshot_filename);
+                std::remove(tmp_filename.c_str());
+                return false;
+            }
+            SPDLOG_INFO("Wrote map snapshot {0} of {1} lanelets ({2} bytes). ", snapshot_filename, lanelet_count, writer.buffer.size());
+            return true;
+        }
+
+        bool read_lanelet_map_snapshot(const std::string &snapshot_filename, uint64_t source_hash, std::string &target_frame,
+                                       lanelet::LaneletMapPtr &map, std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles)
+        {
+            mapped_file file(snapshot_filename);
+            if (!file.data)
+            {
+                SPDLOG_INFO("No map snapshot {0}. ", snapshot_filename);
+                return false;
+            }
+            if (file.size < sizeof(SNAPSHOT_MAGIC) || std::memcmp(file.data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+            {
+                SPDLOG_WARN("Map snapshot {0} is not a map snapshot. ", snapshot_filename);
+                return false;
+            }
+            snapshot_reader reader(file.data + sizeof(SNAPSHOT_MAGIC), file.size - sizeof(SNAPSHOT_MAGIC));
+            uint32_t version = 0;
+            uint64_t snapshot_source_hash = 0;
+            if (!reader.get(version) || version != SNAPSHOT_VERSION || !reader.get(snapshot_source_hash) || snapshot_source_hash != source_hash)
+            {
+                SPDLOG_INFO("Map snapshot {0} is out of date. ", snapshot_filename);
+                return false;
+            }
+
+            std::string frame;
+            uint64_t point_count = 0;
+            if (!reader.get_string(frame) || !reader.get(point_count) || !reader.has(point_count, sizeof(int64_t) + 3 * sizeof(double)))
+            {
+                SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                return false;
+            }
+            lanelet::Points3d points;
+            points.reserve(point_count);
+            for (uint64_t i = 0; i < point_count; i++)
+            {
+                int64_t id = 0;
+                double x = 0, y = 0, z = 0;
+                reader.get(id);
+                reader.get(x);
+                reader.get(y);
+                reader.get(z);
+                points.emplace_back(id, x, y, z);
+            }
+
+            uint64_t line_string_count = 0;
+            if (!reader.get(line_string_count) || !reader.has(line_string_count, sizeof(int64_t) + sizeof(uint32_t)))
+            {
+                SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                return false;
+            }
+            lanelet::LineStrings3d line_strings;
+            line_strings.reserve(line_string_count);
+            for (uint64_t i = 0; i < line_string_count; i++)
+            {
+                int64_t id = 0;
+                uint32_t size = 0;
+                if (!reader.get(id) || !reader.get(size) || !reader.has(size, sizeof(uint32_t)))
+                {
+                    SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                    return false;
+                }
+                lanelet::Points3d line_string_points;
+                line_string_points.reserve(size);
+                for (uint32_t j = 0; j < size; j++)
+                {
+                    uint32_t index = 0;
+                    reader.get(index);
+                    if (index >= points.size())
+                    {
+                        SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                        return false;
+                    }
+                    line_string_points.push_back(points[index]);
+                }
+                line_strings.emplace_back(id, line_string_points);
+            }
+
+            uint64_t lanelet_count = 0;
+            if (!reader.get(lanelet_count))
+            {
+                SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                return false;
+            }
+            lanelet::Lanelets lanelets;
+            std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> lanelet_roles;
+            for (uint64_t i = 0; i < lanelet_count; i++)
+            {
+                int64_t id = 0;
+                uint32_t left = 0, right = 0, attribute_count = 0;
+                uint8_t left_inverted = 0, right_inverted = 0;
+                if (!reader.get(id) || !reader.get(left) || !reader.get(left_inverted) || !reader.get(right) || !reader.get(right_inverted) ||
+                    left >= line_strings.size() || right >= line_strings.size() || !reader.get(attribute_count))
+                {
+                    SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                    return false;
+                }
+                lanelet::AttributeMap attributes;
+                for (uint32_t j = 0; j < attribute_count; j++)
+                {
+                    std::string key, value;
+                    if (!reader.get_string(key) || !reader.get_string(value))
+                    {
+                        SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                        return false;
+                    }
+                    attributes[key] = value;
+                }
+
+                lanelet_snapshot_roles_t ll_roles;
+                uint8_t is_all_way_stop = 0;
+                int64_t previous = 0;
+                uint32_t following_count = 0;
+                if (!reader.get(is_all_way_stop) || !reader.get(previous) || !reader.get(following_count) || !reader.has(following_count, sizeof(int64_t)))
+                {
+                    SPDLOG_ERROR("Map snapshot {0} is corrupt. ", snapshot_filename);
+                    return false;
+                }
+                ll_roles.is_all_way_stop = is_all_way_stop != 0;
+                ll_roles.previous = previous;
+                ll_roles.following.resize(following_count);
+                for (uint32_t j = 0; j < following_count; j++)
+                {
+                    int64_t following_id = 0;
+                    reader.get(following_id);
+                    ll_roles.following[j] = following_id;
+                }
+                lanelet_roles.emplace(id, std::move(ll_roles));
+
+                lanelet::LineString3d left_bound = left_inverted ? line_strings[left].invert() : line_strings[left];
+                lanelet::LineString3d right_bound = right_inverted ? line_strings[right].invert() : line_strings[right];
+                lanelets.emplace_back(id, left_bound, right_bound, attributes);
+            }
+
+            target_frame = std::move(frame);
+            map = lanelet::utils::createMap(lanelets);
+            roles = std::move(lanelet_roles);
+            SPDLOG_INFO("Read map snapshot {0} of {1} lanelets. ", snapshot_filename, lanelets.size());
+            return true;
+        }
+    }
+}
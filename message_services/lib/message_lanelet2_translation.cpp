@@ -6,12 +6,16 @@ namespace message_services
     {
         message_lanelet2_translation::message_lanelet2_translation(/* args */) {}
 
-        message_lanelet2_translation::message_lanelet2_translation(std::string filename)
+        message_lanelet2_translation::message_lanelet2_translation(std::string filename) : message_lanelet2_translation(filename, "") {}
+
+        message_lanelet2_translation::message_lanelet2_translation(std::string filename, std::string snapshot_filename)
+            : map_snapshot_filename(std::move(snapshot_filename))
         {
             if (read_lanelet2_map(filename))
             {
                 SPDLOG_INFO("Map is initialied. ");
-                if (!this->vehicleGraph_ptr)
+                // Roles read from the map snapshot make the routing graph unnecessary
+                if (!this->lanelet_roles_ready)
                 {
                     SPDLOG_INFO("Updating vehicle routing graph ... ");
                     if (this->update_vehicle_routing_graph())
@@ -44,12 +48,32 @@ namespace message_services
                 std::string target_frame;
                 lanelet::ErrorMessages errors;
 
+                uint64_t source_hash = 0;
+                if (!this->map_snapshot_filename.empty() && hash_lanelet_map_file(filename, source_hash))
+                {
+                    lanelet::LaneletMapPtr snapshot_map_ptr;
+                    std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> roles;
+                    if (read_lanelet_map_snapshot(this->map_snapshot_filename, source_hash, target_frame, snapshot_map_ptr, roles) && !snapshot_map_ptr->empty())
+                    {
+                        local_projector = new lanelet::projection::LocalFrameProjector(target_frame.c_str());
+                        this->map_ptr = snapshot_map_ptr;
+                        this->map_source_hash = 0;
+                        build_lanelet_grid();
+                        apply_lanelet_roles(roles);
+                        return true;
+                    }
+                }
+
                 // Parse geo reference info from the lanelet map (.osm)
                 lanelet::io_handlers::AutowareOsmParser::parseMapParams(filename, &projector_type, &target_frame);
                 local_projector = new lanelet::projection::LocalFrameProjector(target_frame.c_str());
                 this->map_ptr = lanelet::load(filename, *local_projector, &errors);
                 if (!this->map_ptr->empty())
                 {
+                    // The snapshot is written once the routing graph roles are built
+                    this->map_source_hash = source_hash;
+                    this->map_target_frame = target_frame;
+                    build_lanelet_grid();
                     return true;
                 }
             }
@@ -77,6 +101,7 @@ namespace message_services
             {
                 return false;
             }
+            build_lanelet_roles();
             return true;
         }
 
@@ -86,7 +111,261 @@ namespace message_services
             return get_cur_lanelet_by_point_and_direction(subj_point3d, turn_direction, trajectory);
         }
 
+        void message_lanelet2_translation::build_lanelet_grid()
+        {
+            this->cached_lanelets.clear();
+            this->cached_lanelet_index_v.clear();
+            this->cached_lanelet_index_m.clear();
+            this->grid_cell_offsets.clear();
+            this->grid_cell_lanelets.clear();
+            this->grid_cols = 0;
+            this->grid_rows = 0;
+            this->lanelet_roles_ready = false;
+
+            std::vector<lanelet::BoundingBox2d> bounding_boxes;
+            lanelet::BoundingBox2d map_box;
+            for (auto ll_itr = this->map_ptr->laneletLayer.begin(); ll_itr != this->map_ptr->laneletLayer.end(); ll_itr++)
+            {
+                cached_lanelet_t cached;
+                cached.lanelet = *ll_itr;
+                cached.polygon = ll_itr->polygon2d().basicPolygon();
+                cached.centerline = ll_itr->centerline2d().basicLineString();
+                if (ll_itr->hasAttribute("turn_direction"))
+                {
+                    cached.turn_direction = ll_itr->attribute("turn_direction").value();
+                    cached.has_turn_direction = true;
+                }
+                lanelet::RegulatoryElementConstPtrs reg_ptrs = ll_itr->regulatoryElements();
+                for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
+                {
+                    if ((*reg_ptrs_itr)->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
+                    {
+                        cached.is_all_way_stop = true;
+                        break;
+                    }
+                }
+                this->cached_lanelets.push_back(std::move(cached));
+                bounding_boxes.push_back(lanelet::geometry::boundingBox2d(*ll_itr));
+                map_box.extend(bounding_boxes.back());
+            }
+
+            if (this->cached_lanelets.empty())
+            {
+                return;
+            }
+
+            // Flat index by lanelet id when the ids are dense enough, a hash map otherwise
+            auto id_range = std::minmax_element(this->cached_lanelets.begin(), this->cached_lanelets.end(), [](const cached_lanelet_t &a, const cached_lanelet_t &b)
+                                                { return a.lanelet.id() < b.lanelet.id(); });
+            this->cached_lanelet_min_id = id_range.first->lanelet.id();
+            size_t id_span = static_cast<size_t>(id_range.second->lanelet.id() - this->cached_lanelet_min_id) + 1;
+            if (id_span <= this->_maximum_lanelet_id_span)
+            {
+                this->cached_lanelet_index_v.assign(id_span, SIZE_MAX);
+            }
+            for (size_t index = 0; index < this->cached_lanelets.size(); index++)
+            {
+                lanelet::Id id = this->cached_lanelets[index].lanelet.id();
+                if (this->cached_lanelet_index_v.empty())
+                {
+                    this->cached_lanelet_index_m[id] = index;
+                }
+                else
+                {
+                    this->cached_lanelet_index_v[id - this->cached_lanelet_min_id] = index;
+                }
+            }
+
+            this->grid_min_x = map_box.min().x();
+            this->grid_min_y = map_box.min().y();
+            this->grid_cell_size = this->_lanelet_grid_cell_size;
+            double width = map_box.max().x() - this->grid_min_x;
+            double height = map_box.max().y() - this->grid_min_y;
+            while ((static_cast<size_t>(width / this->grid_cell_size) + 1) * (static_cast<size_t>(height / this->grid_cell_size) + 1) > this->_maximum_num_lanelet_grid_cells)
+            {
+                this->grid_cell_size *= 2;
+            }
+            this->grid_cols = static_cast<size_t>(width / this->grid_cell_size) + 1;
+            this->grid_rows = static_cast<size_t>(height / this->grid_cell_size) + 1;
+
+            // Count the candidate lanelets per cell first, then fill the cells in place
+            auto cell_range = [this](const lanelet::BoundingBox2d &box, size_t &col_begin, size_t &col_end, size_t &row_begin, size_t &row_end)
+            {
+                col_begin = static_cast<size_t>((box.min().x() - this->grid_min_x) / this->grid_cell_size);
+                col_end = std::min(static_cast<size_t>((box.max().x() - this->grid_min_x) / this->grid_cell_size) + 1, this->grid_cols);
+                row_begin = static_cast<size_t>((box.min().y() - this->grid_min_y) / this->grid_cell_size);
+                row_end = std::min(static_cast<size_t>((box.max().y() - this->grid_min_y) / this->grid_cell_size) + 1, this->grid_rows);
+            };
+            this->grid_cell_offsets.assign(this->grid_cols * this->grid_rows + 1, 0);
+            size_t col_begin, col_end, row_begin, row_end;
+            for (const auto &box : bounding_boxes)
+            {
+                cell_range(box, col_begin, col_end, row_begin, row_end);
+                for (size_t row = row_begin; row < row_end; row++)
+                {
+                    for (size_t col = col_begin; col < col_end; col++)
+                    {
+                        this->grid_cell_offsets[row * this->grid_cols + col + 1]++;
+                    }
+                }
+            }
+            for (size_t cell = 1; cell < this->grid_cell_offsets.size(); cell++)
+            {
+                this->grid_cell_offsets[cell] += this->grid_cell_offsets[cell - 1];
+            }
+
+            std::vector<uint32_t> cell_fill(this->grid_cell_offsets.begin(), this->grid_cell_offsets.end() - 1);
+            this->grid_cell_lanelets.resize(this->grid_cell_offsets.back());
+            for (size_t index = 0; index < bounding_boxes.size(); index++)
+            {
+                cell_range(bounding_boxes[index], col_begin, col_end, row_begin, row_end);
+                for (size_t row = row_begin; row < row_end; row++)
+                {
+                    for (size_t col = col_begin; col < col_end; col++)
+                    {
+                        this->grid_cell_lanelets[cell_fill[row * this->grid_cols + col]++] = static_cast<uint32_t>(index);
+                    }
+                }
+            }
+            SPDLOG_INFO("Built lanelet grid of {0} x {1} cells of {2} m for {3} lanelets. ", this->grid_cols, this->grid_rows, this->grid_cell_size, this->cached_lanelets.size());
+        }
+
+        size_t message_lanelet2_translation::cached_lanelet_index(lanelet::Id lanelet_id) const
+        {
+            if (!this->cached_lanelet_index_v.empty())
+            {
+                if (lanelet_id < this->cached_lanelet_min_id || static_cast<size_t>(lanelet_id - this->cached_lanelet_min_id) >= this->cached_lanelet_index_v.size())
+                {
+                    return this->cached_lanelets.size();
+                }
+                size_t index = this->cached_lanelet_index_v[lanelet_id - this->cached_lanelet_min_id];
+                return index == SIZE_MAX ? this->cached_lanelets.size() : index;
+            }
+            auto index_itr = this->cached_lanelet_index_m.find(lanelet_id);
+            return index_itr == this->cached_lanelet_index_m.end() ? this->cached_lanelets.size() : index_itr->second;
+        }
+
+        void message_lanelet2_translation::build_lanelet_roles()
+        {
+            for (auto &cached : this->cached_lanelets)
+            {
+                cached.previous = SIZE_MAX;
+                cached.following.clear();
+                lanelet::ConstLanelets previous = this->vehicleGraph_ptr->previous(cached.lanelet);
+                if (!previous.empty())
+                {
+                    cached.previous = cached_lanelet_index(previous.front().id());
+                }
+                lanelet::ConstLanelets following = this->vehicleGraph_ptr->following(cached.lanelet);
+                for (auto itr = following.begin(); itr != following.end(); itr++)
+                {
+                    size_t index = cached_lanelet_index(itr->id());
+                    if (index < this->cached_lanelets.size())
+                    {
+                        cached.following.push_back(index);
+                    }
+                }
+            }
+            this->lanelet_roles_ready = true;
+            write_map_snapshot();
+        }
+
+        void message_lanelet2_translation::apply_lanelet_roles(const std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> &roles)
+        {
+            for (auto &cached : this->cached_lanelets)
+            {
+                auto roles_itr = roles.find(cached.lanelet.id());
+                if (roles_itr == roles.end())
+                {
+                    continue;
+                }
+                cached.is_all_way_stop = roles_itr->second.is_all_way_stop;
+                cached.previous = SIZE_MAX;
+                if (roles_itr->second.previous != lanelet::InvalId)
+                {
+                    size_t index = cached_lanelet_index(roles_itr->second.previous);
+                    cached.previous = index < this->cached_lanelets.size() ? index : SIZE_MAX;
+                }
+                cached.following.clear();
+                for (auto following_id : roles_itr->second.following)
+                {
+                    size_t index = cached_lanelet_index(following_id);
+                    if (index < this->cached_lanelets.size())
+                    {
+                        cached.following.push_back(index);
+                    }
+                }
+            }
+            this->lanelet_roles_ready = true;
+        }
+
+        void message_lanelet2_translation::write_map_snapshot() const
+        {
+            if (this->map_snapshot_filename.empty() || this->map_source_hash == 0)
+            {
+                return;
+            }
+            std::unordered_map<lanelet::Id, lanelet_snapshot_roles_t> roles;
+            for (const auto &cached : this->cached_lanelets)
+            {
+                lanelet_snapshot_roles_t &ll_roles = roles[cached.lanelet.id()];
+                ll_roles.is_all_way_stop = cached.is_all_way_stop;
+                if (cached.previous < this->cached_lanelets.size())
+                {
+                    ll_roles.previous = this->cached_lanelets[cached.previous].lanelet.id();
+                }
+                for (auto index : cached.following)
+                {
+                    ll_roles.following.push_back(this->cached_lanelets[index].lanelet.id());
+                }
+            }
+            write_lanelet_map_snapshot(this->map_snapshot_filename, this->map_source_hash, this->map_target_frame, *this->map_ptr, roles);
+        }
+
+        double message_lanelet2_translation::distance2_centerline(const lanelet::BasicPoint2d &subj_point2d, const lanelet::Lanelet &subj_lanelet) const
+        {
+            size_t index = cached_lanelet_index(subj_lanelet.id());
+            if (index < this->cached_lanelets.size())
+            {
+                return boost::geometry::distance(subj_point2d, this->cached_lanelets[index].centerline);
+            }
+            return lanelet::geometry::distance2d(subj_point2d, lanelet::utils::toHybrid(subj_lanelet.centerline2d()));
+        }
+
         std::vector<lanelet::Lanelet> message_lanelet2_translation::get_cur_lanelets_by_point(lanelet::BasicPoint3d subj_point3d) const
+        {
+            if (this->grid_cols == 0)
+            {
+                return find_cur_lanelets_in_rtree(subj_point3d);
+            }
+
+            lanelet::BasicPoint2d subj_point2d = lanelet::utils::to2D(subj_point3d);
+            double grid_x = (subj_point2d.x() - this->grid_min_x) / this->grid_cell_size;
+            double grid_y = (subj_point2d.y() - this->grid_min_y) / this->grid_cell_size;
+            if (grid_x < 0 || grid_y < 0 || grid_x >= this->grid_cols || grid_y >= this->grid_rows)
+            {
+                return find_cur_lanelets_in_rtree(subj_point3d);
+            }
+
+            std::vector<lanelet::Lanelet> current_total_lanelets;
+            size_t cell = static_cast<size_t>(grid_y) * this->grid_cols + static_cast<size_t>(grid_x);
+            for (uint32_t offset = this->grid_cell_offsets[cell]; offset < this->grid_cell_offsets[cell + 1]; offset++)
+            {
+                const cached_lanelet_t &cached = this->cached_lanelets[this->grid_cell_lanelets[offset]];
+                if (boost::geometry::covered_by(subj_point2d, cached.polygon))
+                {
+                    current_total_lanelets.push_back(cached.lanelet);
+                }
+            }
+
+            if (current_total_lanelets.empty())
+            {
+                SPDLOG_ERROR("No nearest lanelet to the vehicle in map point: x = {0} y = {1}, z = {2}", subj_point3d.x(), subj_point3d.y(), subj_point3d.z());
+            }
+            return current_total_lanelets;
+        }
+
+        std::vector<lanelet::Lanelet> message_lanelet2_translation::find_cur_lanelets_in_rtree(lanelet::BasicPoint3d subj_point3d) const
         {
             std::vector<lanelet::Lanelet> current_total_lanelets;           
             lanelet::BasicPoint2d subj_point2d = lanelet::utils::to2D(subj_point3d);
@@ -113,7 +392,8 @@ namespace message_services
             return current_total_lanelets;
         }
 
-        lanelet::Lanelet message_lanelet2_translation::get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory &trajectory) const
+        template <typename TrajectoryEnds>
+        lanelet::Lanelet message_lanelet2_translation::select_cur_lanelet(const lanelet::BasicPoint3d &subj_point3d, const std::string &turn_direction, TrajectoryEnds trajectory_ends) const
         {                  
             std::vector<lanelet::Lanelet> current_total_lanelets = get_cur_lanelets_by_point(subj_point3d);   
             std::vector<lanelet::Lanelet> result_lanelets;
@@ -132,14 +412,18 @@ namespace message_services
                 for (auto itr = current_total_lanelets.begin(); itr != current_total_lanelets.end(); itr++)
                 {
                     const lanelet::Lanelet cur_lanelet = *itr;
-                    if (cur_lanelet.hasAttribute("turn_direction"))
+                    size_t index = cached_lanelet_index(cur_lanelet.id());
+                    if (index < this->cached_lanelets.size())
                     {
-                        const lanelet::Attribute attr = cur_lanelet.attribute("turn_direction");
-                        if (attr.value() == turn_direction)
+                        if (this->cached_lanelets[index].has_turn_direction && this->cached_lanelets[index].turn_direction == turn_direction)
                         {
                             result_lanelets.push_back(cur_lanelet);
                         }
                     }
+                    else if (cur_lanelet.hasAttribute("turn_direction") && cur_lanelet.attribute("turn_direction").value() == turn_direction)
+                    {
+                        result_lanelets.push_back(cur_lanelet);
+                    }
                 }
 
                 if (result_lanelets.size() == 1)
@@ -150,35 +434,23 @@ namespace message_services
                 // If there are more than two current lanelets return, check the trajectory
                 if (result_lanelets.size() > 1)
                 {
-                    lanelet::BasicPoint3d basic_point3d_start = this->ecef_2_map_point(trajectory.location.ecef_x, trajectory.location.ecef_y, trajectory.location.ecef_z);
-                    if (trajectory.offsets.empty())
+                    lanelet::BasicPoint3d basic_point3d_start;
+                    lanelet::BasicPoint3d basic_point3d_dest;
+                    if (!trajectory_ends(basic_point3d_start, basic_point3d_dest))
                     {
                         SPDLOG_ERROR("Cannot determine current lanelet and ids with vehicle trajectory offset size = 0. ");
                         return lanelet::Lanelet();
                     }
 
-                    std::int32_t dest_x = trajectory.location.ecef_x;
-                    std::int32_t dest_y = trajectory.location.ecef_y;
-                    std::int32_t dest_z = trajectory.location.ecef_z;
-                    for (auto offset_itr = trajectory.offsets.begin(); offset_itr != trajectory.offsets.end(); offset_itr++)
-                    {
-                        dest_x += offset_itr->offset_x;
-                        dest_y += offset_itr->offset_y;
-                        dest_z += offset_itr->offset_z;
-                        SPDLOG_DEBUG("offset_x = {0},offset_y = {1},offset_z = {2}", offset_itr->offset_x, offset_itr->offset_y, offset_itr->offset_z);
-                        SPDLOG_DEBUG("dest_x = {0},dest_y = {1},dest_z = {2}", dest_x, dest_y, dest_z);
-                    }
-
-                    lanelet::BasicPoint3d basic_point3d_dest = ecef_2_map_point(dest_x, dest_y, dest_z);
                     lanelet::Lanelet result_lanelet = lanelet::Lanelet();
                     double smaller_distance_sum = 0;
                     for (auto itr = result_lanelets.begin(); itr != result_lanelets.end(); itr++)
                     {
                         const lanelet::Lanelet cur_lanelet = *itr;
-                        double start_distance2_ctl = lanelet::geometry::distance2d(lanelet::utils::to2D(basic_point3d_start), lanelet::utils::toHybrid(cur_lanelet.centerline2d()));
+                        double start_distance2_ctl = distance2_centerline(lanelet::utils::to2D(basic_point3d_start), cur_lanelet);
                         SPDLOG_INFO("cur_lanelet = {0} to trajectory start point distance = {1}", cur_lanelet.id(), start_distance2_ctl);
 
-                        double dest_distance2_ctl = lanelet::geometry::distance2d(lanelet::utils::to2D(basic_point3d_dest), lanelet::utils::toHybrid(cur_lanelet.centerline2d()));
+                        double dest_distance2_ctl = distance2_centerline(lanelet::utils::to2D(basic_point3d_dest), cur_lanelet);
                         SPDLOG_INFO("cur_lanelet = {0} to trajectory dest point distance = {1}", cur_lanelet.id(), dest_distance2_ctl);
 
                         double cur_distance_sum = start_distance2_ctl + dest_distance2_ctl;
@@ -201,6 +473,153 @@ namespace message_services
           return lanelet::Lanelet();
         }
 
+        lanelet::Lanelet message_lanelet2_translation::get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory &trajectory) const
+        {
+            return select_cur_lanelet(subj_point3d, turn_direction, [this, &trajectory](lanelet::BasicPoint3d &start, lanelet::BasicPoint3d &dest)
+                                      {
+                                          if (trajectory.offsets.empty())
+                                          {
+                                              return false;
+                                          }
+                                          start = this->ecef_2_map_point(trajectory.location.ecef_x, trajectory.location.ecef_y, trajectory.location.ecef_z);
+
+                                          std::int32_t dest_x = trajectory.location.ecef_x;
+                                          std::int32_t dest_y = trajectory.location.ecef_y;
+                                          std::int32_t dest_z = trajectory.location.ecef_z;
+                                          for (auto offset_itr = trajectory.offsets.begin(); offset_itr != trajectory.offsets.end(); offset_itr++)
+                                          {
+                                              dest_x += offset_itr->offset_x;
+                                              dest_y += offset_itr->offset_y;
+                                              dest_z += offset_itr->offset_z;
+                                          }
+                                          SPDLOG_DEBUG("dest_x = {0},dest_y = {1},dest_z = {2}", dest_x, dest_y, dest_z);
+                                          dest = this->ecef_2_map_point(dest_x, dest_y, dest_z);
+                                          return true; });
+        }
+
+        lanelet::Lanelet message_lanelet2_translation::get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, const trajectory_map_points_t &trajectory_points) const
+        {
+            return select_cur_lanelet(subj_point3d, turn_direction, [&trajectory_points](lanelet::BasicPoint3d &start, lanelet::BasicPoint3d &dest)
+                                      {
+                                          if (trajectory_points.size() < 2)
+                                          {
+                                              return false;
+                                          }
+                                          start = trajectory_points.at(0);
+                                          dest = trajectory_points.at(trajectory_points.size() - 1);
+                                          return true; });
+        }
+
+        size_t message_lanelet2_translation::find_tracked_lanelet(const lanelet::BasicPoint2d &subj_point2d, lanelet::Id tracked_lanelet_id, const std::string &turn_direction) const
+        {
+            size_t tracked_index = cached_lanelet_index(tracked_lanelet_id);
+            if (tracked_index >= this->cached_lanelets.size())
+            {
+                return this->cached_lanelets.size();
+            }
+
+            const cached_lanelet_t &tracked = this->cached_lanelets[tracked_index];
+            // Link lanelets overlap inside the intersection box, a tracked link lanelet is only kept while it matches a known turn direction
+            bool is_turn_direction_known = !turn_direction.empty() && turn_direction != "NA";
+            if (tracked.has_turn_direction && is_turn_direction_known && tracked.turn_direction != turn_direction)
+            {
+                return this->cached_lanelets.size();
+            }
+            if (boost::geometry::covered_by(subj_point2d, tracked.polygon))
+            {
+                return tracked_index;
+            }
+
+            // The vehicle left its lanelet, check the lanelets it can move to. Successor link lanelets overlap, keep the one of the turn direction.
+            std::vector<size_t> result_indexes;
+            std::vector<size_t> turn_direction_indexes;
+            for (size_t successor_index : tracked.following)
+            {
+                const cached_lanelet_t &successor = this->cached_lanelets[successor_index];
+                if (boost::geometry::covered_by(subj_point2d, successor.polygon))
+                {
+                    result_indexes.push_back(successor_index);
+                    if (successor.has_turn_direction && successor.turn_direction == turn_direction)
+                    {
+                        turn_direction_indexes.push_back(successor_index);
+                    }
+                }
+            }
+
+            if (result_indexes.size() == 1)
+            {
+                return result_indexes.front();
+            }
+            if (turn_direction_indexes.size() == 1)
+            {
+                return turn_direction_indexes.front();
+            }
+            return this->cached_lanelets.size();
+        }
+
+        lanelet::Lanelet message_lanelet2_translation::get_cur_lanelet_by_vehicle_and_direction(const std::string &vehicle_id, lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory &trajectory)
+        {
+            std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            lanelet::BasicPoint2d subj_point2d = lanelet::utils::to2D(subj_point3d);
+            // The lookups run without the tracks lock, the lookups of one vehicle come from one composition thread
+            size_t index = this->cached_lanelets.size();
+            vehicle_lanelet_track_t track;
+            if (get_vehicle_lanelet_track(vehicle_id, track) && this->lanelet_roles_ready)
+            {
+                index = find_tracked_lanelet(subj_point2d, track.lanelet_id, turn_direction);
+            }
+
+            lanelet::Lanelet cur_lanelet;
+            if (index < this->cached_lanelets.size())
+            {
+                cur_lanelet = this->cached_lanelets[index].lanelet;
+            }
+            else
+            {
+                SPDLOG_DEBUG("Vehicle {0} is not in its tracked lanelet or successors, searching the current lanelet. ", vehicle_id);
+                cur_lanelet = get_cur_lanelet_by_point_and_direction(subj_point3d, turn_direction, trajectory);
+                index = cached_lanelet_index(cur_lanelet.id());
+            }
+
+            std::unique_lock<std::mutex> lck(this->vehicle_lanelet_tracks_mtx);
+            if (index >= this->cached_lanelets.size())
+            {
+                this->vehicle_lanelet_tracks.erase(vehicle_id);
+                return cur_lanelet;
+            }
+
+            if (this->vehicle_lanelet_tracks.size() >= this->_maximum_num_vehicle_lanelet_tracks && this->vehicle_lanelet_tracks.find(vehicle_id) == this->vehicle_lanelet_tracks.end())
+            {
+                for (auto itr = this->vehicle_lanelet_tracks.begin(); itr != this->vehicle_lanelet_tracks.end();)
+                {
+                    if (cur_timestamp - itr->second.updated_timestamp > this->_vehicle_lanelet_track_timeout_milli_sec)
+                    {
+                        itr = this->vehicle_lanelet_tracks.erase(itr);
+                    }
+                    else
+                    {
+                        itr++;
+                    }
+                }
+            }
+            vehicle_lanelet_track_t &cur_track = this->vehicle_lanelet_tracks[vehicle_id];
+            cur_track.lanelet_id = cur_lanelet.id();
+            cur_track.updated_timestamp = cur_timestamp;
+            return cur_lanelet;
+        }
+
+        bool message_lanelet2_translation::get_vehicle_lanelet_track(const std::string &vehicle_id, vehicle_lanelet_track_t &track) const
+        {
+            std::unique_lock<std::mutex> lck(this->vehicle_lanelet_tracks_mtx);
+            auto track_itr = this->vehicle_lanelet_tracks.find(vehicle_id);
+            if (track_itr == this->vehicle_lanelet_tracks.end())
+            {
+                return false;
+            }
+            track = track_itr->second;
+            return true;
+        }
+
         double message_lanelet2_translation::distance2_cur_lanelet_end(double lat, double lon, double elev, lanelet::Lanelet subj_lanelet, std::string turn_direction, models::trajectory &trajectory) const
         {   
             lanelet::BasicPoint3d subj_point3d = gps_2_map_point(lat, lon, elev);
@@ -248,10 +667,58 @@ namespace message_services
 
         lanelet::BasicPoint3d message_lanelet2_translation::ecef_2_map_point(std::int32_t ecef_x, std::int32_t ecef_y, std::int32_t ecef_z) const
         {
+            std::unique_lock<std::mutex> lck(this->projector_mtx);
             lanelet::BasicPoint3d basic_point3d = this->local_projector->projectECEF({((double)ecef_x) / 100, ((double)ecef_y) / 100, ((double)ecef_z) / 100}, -1);
             return basic_point3d;
         }
 
+        trajectory_map_points_t message_lanelet2_translation::trajectory_2_map_points(const models::trajectory &trajectory) const
+        {
+            trajectory_map_points_t points;
+            size_t size = trajectory.offsets.size() + 1;
+            points.x.resize(size);
+            points.y.resize(size);
+            points.z.resize(size);
+
+            // Project the location and one meter steps along each ECEF axis, the differences are the columns of the projection Jacobian
+            std::int32_t ecef_x = trajectory.location.ecef_x;
+            std::int32_t ecef_y = trajectory.location.ecef_y;
+            std::int32_t ecef_z = trajectory.location.ecef_z;
+            lanelet::BasicPoint3d origin = ecef_2_map_point(ecef_x, ecef_y, ecef_z);
+            lanelet::BasicPoint3d d_ecef_x = (ecef_2_map_point(ecef_x + 100, ecef_y, ecef_z) - origin) / 100;
+            lanelet::BasicPoint3d d_ecef_y = (ecef_2_map_point(ecef_x, ecef_y + 100, ecef_z) - origin) / 100;
+            lanelet::BasicPoint3d d_ecef_z = (ecef_2_map_point(ecef_x, ecef_y, ecef_z + 100) - origin) / 100;
+
+            // Cumulative offsets from the location in centimeters
+            std::int64_t sum_x = 0;
+            std::int64_t sum_y = 0;
+            std::int64_t sum_z = 0;
+            points.x[0] = 0;
+            points.y[0] = 0;
+            points.z[0] = 0;
+            for (size_t i = 1; i < size; i++)
+            {
+                sum_x += trajectory.offsets[i - 1].offset_x;
+                sum_y += trajectory.offsets[i - 1].offset_y;
+                sum_z += trajectory.offsets[i - 1].offset_z;
+                points.x[i] = static_cast<double>(sum_x);
+                points.y[i] = static_cast<double>(sum_y);
+                points.z[i] = static_cast<double>(sum_z);
+            }
+
+            // Each map coordinate is a linear combination of the cumulative offsets, computed in place over the coordinate arrays
+            for (size_t i = 0; i < size; i++)
+            {
+                double offset_x = points.x[i];
+                double offset_y = points.y[i];
+                double offset_z = points.z[i];
+                points.x[i] = origin.x() + d_ecef_x.x() * offset_x + d_ecef_y.x() * offset_y + d_ecef_z.x() * offset_z;
+                points.y[i] = origin.y() + d_ecef_x.y() * offset_x + d_ecef_y.y() * offset_y + d_ecef_z.y() * offset_z;
+                points.z[i] = origin.z() + d_ecef_x.z() * offset_x + d_ecef_y.z() * offset_y + d_ecef_z.z() * offset_z;
+            }
+            return points;
+        }
+
         lanelet::BasicPoint3d message_lanelet2_translation::gps_2_map_point(double lat, double lon, double elev) const
         {
             lanelet::BasicPoint3d basic_point3d;
@@ -264,6 +731,7 @@ namespace message_services
                 subj_gps_pos.ele = elev;
 
                 // project the GPS point to (x,y,z)
+                std::unique_lock<std::mutex> lck(this->projector_mtx);
                 basic_point3d = local_projector->forward(subj_gps_pos);
             }
             catch (...)
@@ -282,86 +750,78 @@ namespace message_services
                 return lanelet_id_type_m;
             }
 
-                lanelet::ConstLanelet entry_lanelet;
-                lanelet::ConstLanelet link_lanelet;
-                lanelet::ConstLanelet departure_lanelet;
-                lanelet::Lanelet* ll_itr = &subj_lanelet;
-            try
+            // Roles are read from the lanelet neighbours and regulatory elements cached when the routing graph was built
+            size_t subj_index = cached_lanelet_index(subj_lanelet.id());
+            if (subj_index >= this->cached_lanelets.size())
             {
-                    /** Checking whether the current lanelet is link lanelet.
-                     * The link lanelet's previous lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
-                     * **/
-                    lanelet::ConstLanelet local_ll = vehicleGraph_ptr->previous(*ll_itr).front();
-                    if (local_ll.regulatoryElements().size() > 0)
-                    {
-                        lanelet::RegulatoryElementConstPtrs reg_ptrs = local_ll.regulatoryElements();
-                        for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
-                        {
-                            const lanelet::RegulatoryElement *reg = reg_ptrs_itr->get();
-                            if (reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
-                            {
-                                SPDLOG_DEBUG("Found link lanelet id :{0}  ", ll_itr->id());
-                                entry_lanelet = local_ll;
-                                link_lanelet = *ll_itr;
-                                departure_lanelet = vehicleGraph_ptr->following(link_lanelet).front();
-                                break;
-                            }
-                        }
-                    }
+                SPDLOG_ERROR("Cannot determine lanelet type and ids with vehicle current lanelet. ");
+                return lanelet_id_type_m;
+            }
+            const cached_lanelet_t &subj = this->cached_lanelets[subj_index];
 
-                    /***
-                     * Checking whether the current lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
-                     * **/
-                    if (!ll_itr->regulatoryElements().empty())
-                    {
-                        lanelet::RegulatoryElementPtrs reg_ptrs = ll_itr->regulatoryElements();
-                        for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
-                        {
-                            const lanelet::RegulatoryElement *reg = reg_ptrs_itr->get();
-                            if (reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
-                            {
-                                SPDLOG_DEBUG("Found entry lanelet id :{0}  ", ll_itr->id());
-                                entry_lanelet = *ll_itr;
-                                lanelet::ConstLanelets possible_link_lanelets = vehicleGraph_ptr->following(*ll_itr);
-                                // Check turn_direction to determine the link lanelet for subject vehicle
-                                // If turn direction is "NA" or empty, it cannot determine which link lanelet inside the intersection
-                                for (auto itr = possible_link_lanelets.begin(); itr != possible_link_lanelets.end(); itr++)
-                                {
-                                    if (itr->hasAttribute("turn_direction") && itr->attribute("turn_direction").value() == turn_direction)
-                                    {
-                                        link_lanelet = *itr;
-                                        SPDLOG_DEBUG("Found link lanelet id :{0}  ", itr->id());
-                                        departure_lanelet = vehicleGraph_ptr->following(link_lanelet).front();
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
+            size_t entry_index = SIZE_MAX;
+            size_t link_index = SIZE_MAX;
+            size_t departure_index = SIZE_MAX;
 
-                // insert the type for each lanelet id in the list of lanelet ids
-                if (entry_lanelet.id() != lanelet::InvalId)
+            /** Checking whether the current lanelet is link lanelet.
+             * The link lanelet's previous lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
+             * **/
+            if (subj.previous != SIZE_MAX && this->cached_lanelets[subj.previous].is_all_way_stop)
+            {
+                if (subj.following.empty())
                 {
-                    lanelet_id_type_m.insert(std::make_pair(entry_lanelet.id(), models::intersection_lanelet_type::entry));
+                    SPDLOG_ERROR("Cannot determine lanelet type and ids with vehicle current lanelet. ");
+                    return lanelet_id_type_m;
                 }
+                SPDLOG_DEBUG("Found link lanelet id :{0}  ", subj.lanelet.id());
+                entry_index = subj.previous;
+                link_index = subj_index;
+                departure_index = subj.following.front();
+            }
 
-                if (link_lanelet.id() != lanelet::InvalId)
+            /***
+             * Checking whether the current lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
+             * Check turn_direction to determine the link lanelet for subject vehicle
+             * If turn direction is "NA" or empty, it cannot determine which link lanelet inside the intersection
+             * **/
+            if (subj.is_all_way_stop)
+            {
+                SPDLOG_DEBUG("Found entry lanelet id :{0}  ", subj.lanelet.id());
+                entry_index = subj_index;
+                for (size_t following_index : subj.following)
                 {
-                    lanelet_id_type_m.insert(std::make_pair(link_lanelet.id(), models::intersection_lanelet_type::link));
+                    const cached_lanelet_t &possible_link = this->cached_lanelets[following_index];
+                    if (possible_link.has_turn_direction && possible_link.turn_direction == turn_direction)
+                    {
+                        if (possible_link.following.empty())
+                        {
+                            SPDLOG_ERROR("Cannot determine lanelet type and ids with vehicle current lanelet. ");
+                            return lanelet_id_type_m;
+                        }
+                        SPDLOG_DEBUG("Found link lanelet id :{0}  ", possible_link.lanelet.id());
+                        link_index = following_index;
+                        departure_index = possible_link.following.front();
+                        break;
+                    }
                 }
+            }
 
-                if (departure_lanelet.id() != lanelet::InvalId)
-                {
-                    lanelet_id_type_m.insert(std::make_pair(departure_lanelet.id(), models::intersection_lanelet_type::departure));
-                }
-            return lanelet_id_type_m;
+            // insert the type for each lanelet id in the list of lanelet ids
+            if (entry_index != SIZE_MAX)
+            {
+                lanelet_id_type_m.insert(std::make_pair(this->cached_lanelets[entry_index].lanelet.id(), models::intersection_lanelet_type::entry));
             }
-            catch(...)
+
+            if (link_index != SIZE_MAX)
             {
-                SPDLOG_ERROR("Cannot determine lanelet type and ids with vehicle current lanelet. ");
-                lanelet_id_type_m.clear();
-                return lanelet_id_type_m;
+                lanelet_id_type_m.insert(std::make_pair(this->cached_lanelets[link_index].lanelet.id(), models::intersection_lanelet_type::link));
+            }
+
+            if (departure_index != SIZE_MAX)
+            {
+                lanelet_id_type_m.insert(std::make_pair(this->cached_lanelets[departure_index].lanelet.id(), models::intersection_lanelet_type::departure));
             }
+            return lanelet_id_type_m;
         }
     }
 }
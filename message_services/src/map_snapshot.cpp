@@ -0,0 +1,26 @@
+#include "message_lanelet2_translation.h"
+
+#include <cstdio>
+
+/**
+ * @brief Build the map snapshot of an osm map ahead of the service startup.
+ * Usage: map_snapshot <osm map> <snapshot>
+ */
+int main(int argc, const char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <osm map> <snapshot>" << std::endl;
+        return 1;
+    }
+    // Remove the current snapshot so that it is rebuilt from the osm map
+    std::remove(argv[2]);
+    message_services::message_translations::message_lanelet2_translation translation(argv[1], argv[2]);
+    std::ifstream snapshot(argv[2], std::ios::binary);
+    if (!snapshot.good())
+    {
+        SPDLOG_ERROR("Failed to write map snapshot {0}. ", argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -15,9 +15,11 @@ void vehicle_status_intent_service_call(std::shared_ptr<message_services::messag
 int main(int argc, const char **argv)
 {
     const std::string OSM_FILE_PATH = "../vector_map.osm";
+    // Rebuilt from the osm map when missing or out of date
+    const std::string MAP_SNAPSHOT_FILE_PATH = "../vector_map.snapshot";
     streets_service::streets_configuration::initialize_logger();
     //initialize lanelet2 message translation object
-    auto msg_translate_ptr = std::make_shared<message_services::message_translations::message_lanelet2_translation>(OSM_FILE_PATH);
+    auto msg_translate_ptr = std::make_shared<message_services::message_translations::message_lanelet2_translation>(OSM_FILE_PATH, MAP_SNAPSHOT_FILE_PATH);
 
     std::thread vehicle_status_intent_service_t(vehicle_status_intent_service_call, std::ref(msg_translate_ptr));
     vehicle_status_intent_service_t.join();
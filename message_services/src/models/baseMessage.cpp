@@ -1,4 +1,5 @@
 #include "baseMessage.h"
+#include "json_writer.h"
 namespace message_services
 {
     namespace models
@@ -6,17 +7,23 @@ namespace message_services
 
         std::string baseMessage::asJson() const
         {
-            rapidjson::StringBuffer ss;
-            rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
-            if (this->asJsonObject(&writer))
-                return ss.GetString();
-            return "";
+            return streets_service::write_json([this](rapidjson::Writer<rapidjson::StringBuffer> &writer)
+                                               { return this->asJsonObject(&writer); });
         }
 
         bool baseMessage::fromJson(const std::string &jsonString)
         {
+            return this->fromJson(jsonString.c_str(), jsonString.size());
+        }
+
+        bool baseMessage::fromJson(const char *json, size_t length)
+        {
+            if (json == nullptr)
+            {
+                return false;
+            }
             rapidjson::Document doc;
-            bool has_parse_error = doc.Parse(jsonString.c_str()).HasParseError() ? true : false;
+            bool has_parse_error = doc.Parse(json, length).HasParseError() ? true : false;
 
             if (has_parse_error)
             {
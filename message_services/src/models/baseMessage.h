@@ -29,6 +29,15 @@ namespace message_services
 
             virtual bool fromJson(const std::string &jsonString);
 
+            /**
+             * @brief Parse a json document that is not necessarily NUL terminated, such as a Kafka message payload.
+             * The default builds a DOM and calls fromJsonObject.
+             * @param json document bytes.
+             * @param length document size in bytes.
+             * @return true if the document is valid json.
+             * **/
+            virtual bool fromJson(const char *json, size_t length);
+
             virtual void fromJsonObject(const rapidjson::Value &obj) = 0;
         };
 
@@ -4,12 +4,225 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 #include "bsm.h"
+#include "json_sax.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            /**
+             * @brief SAX handler decoding a BSM json document straight into bsmCoreData_t.
+             * **/
+            class bsm_sax_handler : public model_sax_handler<bsm_sax_handler>
+            {
+            private:
+                bsmCoreData_t &core_data;
+                bool &has_core_data;
+
+            public:
+                enum member_id
+                {
+                    CORE_DATA = 1,
+                    VEHICLE_SIZE,
+                    ACCURACY,
+                    ACCEL_SET,
+                    BRAKES,
+                    ID,
+                    ANGLE,
+                    SEC_MARK,
+                    LAT,
+                    MSG_COUNT,
+                    LONG,
+                    ELEV,
+                    HEADING,
+                    TRANSMISSION,
+                    SPEED,
+                    VEHICLE_LENGTH,
+                    VEHICLE_WIDTH,
+                    ACCURACY_ORIENTATION,
+                    ACCURACY_SEMI_MAJOR,
+                    ACCURACY_SEMI_MINOR,
+                    ACCEL_SET_LAT,
+                    ACCEL_SET_LONG,
+                    ACCEL_SET_VERT,
+                    ACCEL_SET_YAW,
+                    BRAKES_ABS,
+                    BRAKES_AUX_BRAKES,
+                    BRAKES_BRAKE_BOOST,
+                    BRAKES_SCS,
+                    BRAKES_TRACTION
+                };
+
+                bsm_sax_handler(bsmCoreData_t &core_data, bool &has_core_data) : core_data(core_data), has_core_data(has_core_data) {}
+
+                int on_key(int context, const char *name, rapidjson::SizeType length)
+                {
+                    switch (context)
+                    {
+                    case ROOT:
+                        return key_iequals(name, length, "core_data") ? CORE_DATA : UNKNOWN;
+                    case CORE_DATA:
+                        switch (length)
+                        {
+                        case 2:
+                            return key_equals(name, length, "id") ? ID : UNKNOWN;
+                        case 3:
+                            return key_equals(name, length, "lat") ? LAT : UNKNOWN;
+                        case 4:
+                            return key_equals(name, length, "long") ? LONG : key_equals(name, length, "elev") ? ELEV
+                                                                           : key_equals(name, length, "size") ? VEHICLE_SIZE
+                                                                                                              : UNKNOWN;
+                        case 5:
+                            return key_equals(name, length, "angle") ? ANGLE : key_equals(name, length, "speed") ? SPEED
+                                                                                                                 : UNKNOWN;
+                        case 6:
+                            return key_equals(name, length, "brakes") ? BRAKES : UNKNOWN;
+                        case 7:
+                            return key_equals(name, length, "heading") ? HEADING : UNKNOWN;
+                        case 8:
+                            return key_equals(name, length, "sec_mark") ? SEC_MARK : key_equals(name, length, "accuracy") ? ACCURACY
+                                                                                                                          : UNKNOWN;
+                        case 9:
+                            return key_equals(name, length, "msg_count") ? MSG_COUNT : key_equals(name, length, "accel_set") ? ACCEL_SET
+                                                                                                                             : UNKNOWN;
+                        case 12:
+                            return key_equals(name, length, "transmission") ? TRANSMISSION : UNKNOWN;
+                        default:
+                            return UNKNOWN;
+                        }
+                    case VEHICLE_SIZE:
+                        return key_iequals(name, length, "length") ? VEHICLE_LENGTH : key_iequals(name, length, "width") ? VEHICLE_WIDTH
+                                                                                                                      : UNKNOWN;
+                    case ACCURACY:
+                        return key_iequals(name, length, "orientation") ? ACCURACY_ORIENTATION : key_iequals(name, length, "semi_major") ? ACCURACY_SEMI_MAJOR
+                                                                                             : key_iequals(name, length, "semi_minor")   ? ACCURACY_SEMI_MINOR
+                                                                                                                                         : UNKNOWN;
+                    case ACCEL_SET:
+                        return key_iequals(name, length, "lat") ? ACCEL_SET_LAT : key_iequals(name, length, "long") ? ACCEL_SET_LONG
+                                                                              : key_iequals(name, length, "vert")   ? ACCEL_SET_VERT
+                                                                              : key_iequals(name, length, "yaw")    ? ACCEL_SET_YAW
+                                                                                                                    : UNKNOWN;
+                    case BRAKES:
+                        return key_iequals(name, length, "abs") ? BRAKES_ABS : key_iequals(name, length, "aux_brakes") ? BRAKES_AUX_BRAKES
+                                                                           : key_iequals(name, length, "brake_boost")  ? BRAKES_BRAKE_BOOST
+                                                                           : key_iequals(name, length, "scs")          ? BRAKES_SCS
+                                                                           : key_iequals(name, length, "traction")     ? BRAKES_TRACTION
+                                                                                                                       : UNKNOWN;
+                    default:
+                        return UNKNOWN;
+                    }
+                }
+
+                int on_start_object(int context, int member)
+                {
+                    if ((context == ROOT && member == CORE_DATA) || (context == CORE_DATA && (member == VEHICLE_SIZE || member == ACCURACY || member == ACCEL_SET || member == BRAKES)))
+                    {
+                        has_core_data = true;
+                        return member;
+                    }
+                    return UNKNOWN;
+                }
+
+                bool on_string(int context, int field, const char *str, rapidjson::SizeType length)
+                {
+                    if (context == CORE_DATA && field == ID)
+                    {
+                        core_data.temprary_id.assign(str, length);
+                        return true;
+                    }
+                    if (context == CORE_DATA && field == TRANSMISSION)
+                    {
+                        core_data.transmission.assign(str, length);
+                        return true;
+                    }
+                    if (field < ID)
+                    {
+                        // An object member given as a string
+                        return true;
+                    }
+                    return model_sax_handler<bsm_sax_handler>::on_string(context, field, str, length);
+                }
+
+                bool on_number(int, int field, const json_number_t &number)
+                {
+                    switch (field)
+                    {
+                    case ANGLE:
+                        core_data.angle = static_cast<float>(number.as_double());
+                        break;
+                    case SEC_MARK:
+                        core_data.sec_mark = static_cast<long>(number.as_int64());
+                        break;
+                    case LAT:
+                        core_data.latitude = number.as_double();
+                        break;
+                    case MSG_COUNT:
+                        core_data.msg_count = static_cast<long>(number.as_int64());
+                        break;
+                    case LONG:
+                        core_data.longitude = number.as_double();
+                        break;
+                    case ELEV:
+                        core_data.elev = static_cast<float>(number.as_double());
+                        break;
+                    case HEADING:
+                        core_data.heading = static_cast<float>(number.as_double());
+                        break;
+                    case SPEED:
+                        core_data.speed = static_cast<float>(number.as_double());
+                        break;
+                    case VEHICLE_LENGTH:
+                        core_data.size.length = static_cast<long>(number.as_int64());
+                        break;
+                    case VEHICLE_WIDTH:
+                        core_data.size.width = static_cast<long>(number.as_int64());
+                        break;
+                    case ACCURACY_ORIENTATION:
+                        core_data.accuracy.orientation = static_cast<float>(number.as_double());
+                        break;
+                    case ACCURACY_SEMI_MAJOR:
+                        core_data.accuracy.semiMajor = static_cast<float>(number.as_double());
+                        break;
+                    case ACCURACY_SEMI_MINOR:
+                        core_data.accuracy.semiMinor = static_cast<float>(number.as_double());
+                        break;
+                    case ACCEL_SET_LAT:
+                        core_data.accelSet.lat = static_cast<float>(number.as_double());
+                        break;
+                    case ACCEL_SET_LONG:
+                        core_data.accelSet.Long = static_cast<float>(number.as_double());
+                        break;
+                    case ACCEL_SET_VERT:
+                        core_data.accelSet.vert = static_cast<float>(number.as_double());
+                        break;
+                    case ACCEL_SET_YAW:
+                        core_data.accelSet.yaw = static_cast<float>(number.as_double());
+                        break;
+                    case BRAKES_ABS:
+                        core_data.brakes.abs = static_cast<long>(number.as_int64());
+                        break;
+                    case BRAKES_AUX_BRAKES:
+                        core_data.brakes.auxBrakes = static_cast<long>(number.as_int64());
+                        break;
+                    case BRAKES_BRAKE_BOOST:
+                        core_data.brakes.brakeBoost = static_cast<long>(number.as_int64());
+                        break;
+                    case BRAKES_SCS:
+                        core_data.brakes.scs = static_cast<long>(number.as_int64());
+                        break;
+                    case BRAKES_TRACTION:
+                        core_data.brakes.traction = static_cast<long>(number.as_int64());
+                        break;
+                    default:
+                        break;
+                    }
+                    return true;
+                }
+            };
+        }
 
         bsm::bsm() : core_data()
         {
@@ -173,6 +386,22 @@ namespace message_services
             }
         }
 
+        bool bsm::fromJson(const char *json, size_t length)
+        {
+            bsmCoreData_t parsed_core_data;
+            bool has_core_data = false;
+            bsm_sax_handler handler(parsed_core_data, has_core_data);
+            if (!parse_json_sax(json, length, handler))
+            {
+                return false;
+            }
+            if (has_core_data)
+            {
+                this->core_data = std::move(parsed_core_data);
+            }
+            return true;
+        }
+
         bool bsm::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
         {
             try
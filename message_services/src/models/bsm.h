@@ -34,6 +34,9 @@ namespace message_services
 
             //json string object converter with rapidjson
             virtual void fromJsonObject(const rapidjson::Value &obj);
+            using baseMessage::fromJson;
+            // Single pass SAX parse straight into the model, without building a DOM
+            bool fromJson(const char *json, size_t length) override;
             virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
         };
     }
@@ -0,0 +1,267 @@
+#ifndef JSON_SAX_H
+#define JSON_SAX_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "rapidjson/rapidjson.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/encodedstream.h"
+
+namespace message_services
+{
+    namespace models
+    {
+        /**
+         * @brief Numeric value of a JSON member. Message fields are sent either as JSON numbers or as numeric strings.
+         * **/
+        typedef struct json_number
+        {
+            bool is_integer = true;
+            std::int64_t integer = 0;
+            double real = 0.0;
+
+            std::int64_t as_int64() const
+            {
+                return is_integer ? integer : static_cast<std::int64_t>(real);
+            }
+            double as_double() const
+            {
+                return is_integer ? static_cast<double>(integer) : real;
+            }
+        } json_number_t;
+
+        /**
+         * @brief Compare a member name with a key literal, without building strings.
+         * **/
+        template <std::size_t N>
+        inline bool key_equals(const char *name, rapidjson::SizeType length, const char (&key)[N])
+        {
+            return length == N - 1 && std::memcmp(name, key, N - 1) == 0;
+        }
+
+        /**
+         * @brief Compare a member name with a lower case key literal, ignoring the case of the name.
+         * **/
+        template <std::size_t N>
+        inline bool key_iequals(const char *name, rapidjson::SizeType length, const char (&key)[N])
+        {
+            if (length != N - 1)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < N - 1; i++)
+            {
+                char c = name[i];
+                if (c >= 'A' && c <= 'Z')
+                {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+                if (c != key[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Convert a numeric string value. Like std::stol, leading digits are converted and trailing characters ignored.
+         * @param str NUL terminated string, as passed to SAX handlers by rapidjson::Reader.
+         * @return false if str does not start with a number.
+         * **/
+        inline bool parse_json_number(const char *str, json_number_t &number)
+        {
+            char *integer_end = nullptr;
+            long long integer = std::strtoll(str, &integer_end, 10);
+            if (integer_end == str)
+            {
+                return false;
+            }
+            char *real_end = nullptr;
+            double real = std::strtod(str, &real_end);
+            number.is_integer = real_end <= integer_end;
+            number.integer = integer;
+            number.real = real;
+            return true;
+        }
+
+        /**
+         * @brief Base of the SAX handlers decoding messages straight into models. Tracks the object nesting: derived handlers
+         * map each member name to a context id in on_key() and receive values with the context of their enclosing object.
+         * Events outside the known contexts are ignored.
+         * **/
+        template <class Derived>
+        class model_sax_handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived>
+        {
+        protected:
+            static constexpr int MAX_DEPTH = 16;
+            static constexpr int UNKNOWN = -1;
+            // Context of each enclosing object or array, ROOT for the document object
+            int context_stack[MAX_DEPTH] = {};
+            int depth = 0;
+            // Context the next object or array opens, or the field the next value is stored in
+            int member = UNKNOWN;
+
+            int current_context() const
+            {
+                return depth > 0 ? context_stack[depth - 1] : UNKNOWN;
+            }
+
+            bool push_context(int context)
+            {
+                if (depth >= MAX_DEPTH)
+                {
+                    return false;
+                }
+                context_stack[depth++] = context;
+                member = UNKNOWN;
+                return true;
+            }
+
+            bool number_value(const json_number_t &number)
+            {
+                int field = member;
+                member = UNKNOWN;
+                return field == UNKNOWN || static_cast<Derived *>(this)->on_number(current_context(), field, number);
+            }
+
+        public:
+            static constexpr int ROOT = 0;
+
+            bool Key(const char *name, rapidjson::SizeType length, bool)
+            {
+                member = static_cast<Derived *>(this)->on_key(current_context(), name, length);
+                return true;
+            }
+
+            bool StartObject()
+            {
+                // The document object, an object member with a known context or an element of a known array
+                int context = depth == 0 ? ROOT : static_cast<Derived *>(this)->on_start_object(current_context(), member);
+                return push_context(context);
+            }
+
+            bool EndObject(rapidjson::SizeType)
+            {
+                static_cast<Derived *>(this)->on_end_object(current_context());
+                depth--;
+                member = UNKNOWN;
+                return true;
+            }
+
+            bool StartArray()
+            {
+                return push_context(static_cast<Derived *>(this)->on_start_array(current_context(), member));
+            }
+
+            bool EndArray(rapidjson::SizeType)
+            {
+                depth--;
+                member = UNKNOWN;
+                return true;
+            }
+
+            bool String(const char *str, rapidjson::SizeType length, bool)
+            {
+                int field = member;
+                member = UNKNOWN;
+                if (field == UNKNOWN)
+                {
+                    return true;
+                }
+                return static_cast<Derived *>(this)->on_string(current_context(), field, str, length);
+            }
+
+            bool Int(int i)
+            {
+                return Int64(i);
+            }
+
+            bool Uint(unsigned u)
+            {
+                return Int64(u);
+            }
+
+            bool Int64(std::int64_t i)
+            {
+                json_number_t number;
+                number.integer = i;
+                return number_value(number);
+            }
+
+            bool Uint64(std::uint64_t u)
+            {
+                return Int64(static_cast<std::int64_t>(u));
+            }
+
+            bool Double(double d)
+            {
+                json_number_t number;
+                number.is_integer = false;
+                number.real = d;
+                return number_value(number);
+            }
+
+            bool Null()
+            {
+                member = UNKNOWN;
+                return true;
+            }
+
+            bool Bool(bool)
+            {
+                member = UNKNOWN;
+                return true;
+            }
+
+            // Defaults for derived handlers: no nested contexts, numbers given as strings are converted with parse_json_number
+            int on_start_object(int, int)
+            {
+                return UNKNOWN;
+            }
+
+            void on_end_object(int)
+            {
+            }
+
+            int on_start_array(int, int)
+            {
+                return UNKNOWN;
+            }
+
+            bool on_string(int context, int field, const char *str, rapidjson::SizeType)
+            {
+                json_number_t number;
+                if (!parse_json_number(str, number))
+                {
+                    return false;
+                }
+                return static_cast<Derived *>(this)->on_number(context, field, number);
+            }
+        };
+
+        /**
+         * @brief Parse a JSON document with a SAX handler, without building a DOM.
+         * @param json document bytes, not necessarily NUL terminated.
+         * @param length document size in bytes.
+         * @return true if the document is valid JSON and the handler accepted all values.
+         * **/
+        template <class Handler>
+        inline bool parse_json_sax(const char *json, std::size_t length, Handler &handler)
+        {
+            if (json == nullptr)
+            {
+                return false;
+            }
+            rapidjson::Reader reader;
+            rapidjson::MemoryStream ms(json, length);
+            rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is(ms);
+            return !reader.Parse(is, handler).IsError();
+        }
+    }
+}
+
+#endif
@@ -1,15 +1,281 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 #include <boost/algorithm/string.hpp>
 #include "mobilityoperation.h"
+#include "json_sax.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            const char *trim_begin(const char *begin, const char *end)
+            {
+                while (begin < end && std::isspace(static_cast<unsigned char>(*begin)))
+                {
+                    begin++;
+                }
+                return begin;
+            }
+
+            const char *trim_end(const char *begin, const char *end)
+            {
+                while (end > begin && std::isspace(static_cast<unsigned char>(*(end - 1))))
+                {
+                    end--;
+                }
+                return end;
+            }
+
+            bool parse_long_param(const char *value, long &result)
+            {
+                char *value_end = nullptr;
+                long converted = std::strtol(value, &value_end, 10);
+                if (value_end == value)
+                {
+                    return false;
+                }
+                result = converted;
+                return true;
+            }
+
+            bool parse_double_param(const char *value, double &result)
+            {
+                char *value_end = nullptr;
+                double converted = std::strtod(value, &value_end);
+                if (value_end == value)
+                {
+                    return false;
+                }
+                result = converted;
+                return true;
+            }
+
+            /**
+             * @brief Convert one strategy_params key:value pair. Values are converted like std::stol and std::stod, the first
+             * valid value of a key is kept.
+             * @param value trimmed value, followed by a delimiter or the end of the strategy_params string.
+             * **/
+            void parse_strategy_param(const char *key, rapidjson::SizeType key_length, const char *value, size_t value_length, strategy_params_t &params)
+            {
+                uint32_t param = 0;
+                bool is_valid = false;
+                switch (key_length)
+                {
+                case 6:
+                    if (key_equals(key, key_length, "access") && !params.has(access_param))
+                    {
+                        param = access_param;
+                        is_valid = parse_long_param(value, params.access);
+                    }
+                    break;
+                case 7:
+                    if (key_equals(key, key_length, "min_gap") && !params.has(min_gap_param))
+                    {
+                        param = min_gap_param;
+                        is_valid = parse_double_param(value, params.min_gap);
+                    }
+                    break;
+                case 8:
+                    if (key_equals(key, key_length, "sec_mark") && !params.has(sec_mark_param))
+                    {
+                        param = sec_mark_param;
+                        is_valid = parse_long_param(value, params.sec_mark);
+                    }
+                    break;
+                case 9:
+                    if (key_equals(key, key_length, "msg_count") && !params.has(msg_count_param))
+                    {
+                        param = msg_count_param;
+                        is_valid = parse_long_param(value, params.msg_count);
+                    }
+                    else if (key_equals(key, key_length, "max_accel") && !params.has(max_accel_param))
+                    {
+                        param = max_accel_param;
+                        is_valid = parse_double_param(value, params.max_accel);
+                    }
+                    else if (key_equals(key, key_length, "max_decel") && !params.has(max_decel_param))
+                    {
+                        param = max_decel_param;
+                        is_valid = parse_double_param(value, params.max_decel);
+                    }
+                    break;
+                case 10:
+                    if (key_equals(key, key_length, "react_time") && !params.has(react_time_param))
+                    {
+                        param = react_time_param;
+                        is_valid = parse_double_param(value, params.react_time);
+                    }
+                    else if (key_equals(key, key_length, "depart_pos") && !params.has(depart_pos_param))
+                    {
+                        param = depart_pos_param;
+                        is_valid = parse_long_param(value, params.depart_pos);
+                    }
+                    break;
+                case 14:
+                    if (key_equals(key, key_length, "turn_direction") && !params.has(turn_direction_param))
+                    {
+                        param = turn_direction_param;
+                        params.turn_direction.assign(value, value_length);
+                        is_valid = true;
+                    }
+                    break;
+                default:
+                    break;
+                }
+                if (is_valid)
+                {
+                    params.parsed |= param;
+                }
+            }
+        }
+
+        strategy_params_t parse_strategy_params(const std::string &strategy_params)
+        {
+            strategy_params_t params;
+            const char *pos = strategy_params.data();
+            const char *end = pos + strategy_params.size();
+            while (pos < end)
+            {
+                const char *pair_end = static_cast<const char *>(std::memchr(pos, ',', end - pos));
+                if (pair_end == nullptr)
+                {
+                    pair_end = end;
+                }
+                const char *separator = static_cast<const char *>(std::memchr(pos, ':', pair_end - pos));
+                if (separator != nullptr)
+                {
+                    const char *key = trim_begin(pos, separator);
+                    const char *key_end = trim_end(key, separator);
+                    const char *value = trim_begin(separator + 1, pair_end);
+                    const char *value_end = trim_end(value, pair_end);
+                    parse_strategy_param(key, static_cast<rapidjson::SizeType>(key_end - key), value, value_end - value, params);
+                }
+                pos = pair_end + 1;
+            }
+            return params;
+        }
+
+        namespace
+        {
+            /**
+             * @brief SAX handler decoding a MobilityOperation json document straight into the header and strategy strings.
+             * **/
+            class mobilityoperation_sax_handler : public model_sax_handler<mobilityoperation_sax_handler>
+            {
+            private:
+                mobility_header_t &header;
+                bool &has_header;
+                std::string &strategy;
+                std::string &strategy_params;
+
+            public:
+                enum member_id
+                {
+                    METADATA = 1,
+                    STRATEGY,
+                    STRATEGY_PARAMS,
+                    SENDER_ID,
+                    SENDER_BSM_ID,
+                    PLAN_ID,
+                    RECIPIENT_ID,
+                    TIMESTAMP
+                };
+
+                mobilityoperation_sax_handler(mobility_header_t &header, bool &has_header, std::string &strategy, std::string &strategy_params)
+                    : header(header), has_header(has_header), strategy(strategy), strategy_params(strategy_params) {}
+
+                int on_key(int context, const char *name, rapidjson::SizeType length)
+                {
+                    if (context == ROOT)
+                    {
+                        switch (length)
+                        {
+                        case 8:
+                            return key_iequals(name, length, "metadata") ? METADATA : key_iequals(name, length, "strategy") ? STRATEGY
+                                                                                                                            : UNKNOWN;
+                        case 15:
+                            return key_iequals(name, length, "strategy_params") ? STRATEGY_PARAMS : UNKNOWN;
+                        default:
+                            return UNKNOWN;
+                        }
+                    }
+                    if (context == METADATA)
+                    {
+                        switch (length)
+                        {
+                        case 6:
+                            return key_equals(name, length, "planId") ? PLAN_ID : UNKNOWN;
+                        case 9:
+                            return key_equals(name, length, "hostBSMId") ? SENDER_BSM_ID : key_equals(name, length, "timestamp") ? TIMESTAMP
+                                                                                                                                 : UNKNOWN;
+                        case 12:
+                            return key_equals(name, length, "hostStaticId") ? SENDER_ID : UNKNOWN;
+                        case 14:
+                            return key_equals(name, length, "targetStaticId") ? RECIPIENT_ID : UNKNOWN;
+                        default:
+                            return UNKNOWN;
+                        }
+                    }
+                    return UNKNOWN;
+                }
+
+                int on_start_object(int context, int member)
+                {
+                    if (context == ROOT && member == METADATA)
+                    {
+                        has_header = true;
+                        return METADATA;
+                    }
+                    return UNKNOWN;
+                }
+
+                bool on_string(int context, int field, const char *str, rapidjson::SizeType length)
+                {
+                    switch (field)
+                    {
+                    case STRATEGY:
+                        strategy.assign(str, length);
+                        return true;
+                    case STRATEGY_PARAMS:
+                        strategy_params.assign(str, length);
+                        return true;
+                    case SENDER_ID:
+                        header.sender_id.assign(str, length);
+                        return true;
+                    case SENDER_BSM_ID:
+                        header.sender_bsm_id.assign(str, length);
+                        return true;
+                    case PLAN_ID:
+                        header.plan_id.assign(str, length);
+                        return true;
+                    case RECIPIENT_ID:
+                        header.recipient_id.assign(str, length);
+                        return true;
+                    case TIMESTAMP:
+                        return model_sax_handler<mobilityoperation_sax_handler>::on_string(context, field, str, length);
+                    default:
+                        return true;
+                    }
+                }
+
+                bool on_number(int, int field, const json_number_t &number)
+                {
+                    if (field == TIMESTAMP)
+                    {
+                        header.timestamp = static_cast<uint64_t>(number.as_int64());
+                    }
+                    return true;
+                }
+            };
+        }
 
         mobilityoperation::mobilityoperation() : strategy(""), strategy_params(""), header()
         {
@@ -85,6 +351,23 @@ namespace message_services
             }
         }
 
+        bool mobilityoperation::fromJson(const char *json, size_t length)
+        {
+            mobility_header_t parsed_header;
+            bool has_header = false;
+            mobilityoperation_sax_handler handler(parsed_header, has_header, this->strategy, this->strategy_params);
+            if (!parse_json_sax(json, length, handler))
+            {
+                return false;
+            }
+            if (has_header)
+            {
+                this->header = std::move(parsed_header);
+            }
+            this->parsed_strategy_params = parse_strategy_params(this->strategy_params);
+            return true;
+        }
+
         bool mobilityoperation::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
         {
             try
@@ -175,6 +458,11 @@ namespace message_services
         void mobilityoperation::setStrategy_params(std::string strategy_params)
         {
             this->strategy_params = strategy_params;
+            this->parsed_strategy_params = parse_strategy_params(this->strategy_params);
+        }
+        const strategy_params_t &mobilityoperation::getParsed_strategy_params() const
+        {
+            return this->parsed_strategy_params;
         }
         std::string mobilityoperation::getStrategy() const
         {
@@ -7,12 +7,20 @@
 
 #include "baseMessage.h"
 #include "mobilityHeader.h"
+#include "strategyParams.h"
 namespace message_services
 {
 
     namespace models
     {
 
+        /**
+         * @brief Convert strategy_params in a single pass over the string.
+         * @param strategy_params comma separated key:value pairs.
+         * @return the known params, with a bit set in parsed for each param found with a valid value.
+         * **/
+        strategy_params_t parse_strategy_params(const std::string &strategy_params);
+
         class mobilityoperation : public baseMessage
         {
             friend std::ostream &operator<<(std::ostream &out, mobilityoperation &mobilityoperation_obj);
@@ -21,6 +29,8 @@ namespace message_services
             mobility_header_t header;
             std::string strategy = "";
             std::string strategy_params = "";
+            // strategy_params converted when they are set, for the composition of vehicle status and intent
+            strategy_params_t parsed_strategy_params;
 
         public:
             mobilityoperation(/* args */);
@@ -30,6 +40,9 @@ namespace message_services
             std::time_t msg_received_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
             virtual void fromJsonObject(const rapidjson::Value &obj);
+            using baseMessage::fromJson;
+            // Single pass SAX parse straight into the model, without building a DOM
+            bool fromJson(const char *json, size_t length) override;
             virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
 
             std::string get_value_from_strategy_params(std::string key) const;
@@ -40,6 +53,7 @@ namespace message_services
 
             std::string getStrategy_params() const;
             void setStrategy_params(std::string strategy_params);
+            const strategy_params_t &getParsed_strategy_params() const;
             std::string getStrategy() const;
             void setStrategy(std::string strategy);
 
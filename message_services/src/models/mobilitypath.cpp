@@ -3,12 +3,185 @@
 #include <boost/algorithm/string.hpp>
 
 #include "mobilitypath.h"
+#include "json_sax.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            /**
+             * @brief SAX handler decoding a MobilityPath json document straight into the header and trajectory.
+             * **/
+            class mobilitypath_sax_handler : public model_sax_handler<mobilitypath_sax_handler>
+            {
+            private:
+                mobility_header_t &header;
+                bool &has_header;
+                trajectory_t &trajectory;
+                locationOffsetECEF_t offset;
+
+            public:
+                enum member_id
+                {
+                    METADATA = 1,
+                    TRAJECTORY,
+                    LOCATION,
+                    OFFSETS,
+                    OFFSET,
+                    SENDER_ID,
+                    SENDER_BSM_ID,
+                    PLAN_ID,
+                    RECIPIENT_ID,
+                    TIMESTAMP,
+                    ECEF_X,
+                    ECEF_Y,
+                    ECEF_Z,
+                    LOCATION_TIMESTAMP,
+                    OFFSET_X,
+                    OFFSET_Y,
+                    OFFSET_Z
+                };
+
+                mobilitypath_sax_handler(mobility_header_t &header, bool &has_header, trajectory_t &trajectory)
+                    : header(header), has_header(has_header), trajectory(trajectory) {}
+
+                int on_key(int context, const char *name, rapidjson::SizeType length)
+                {
+                    switch (context)
+                    {
+                    case ROOT:
+                        return key_iequals(name, length, "metadata") ? METADATA : key_iequals(name, length, "trajectory") ? TRAJECTORY
+                                                                                                                          : UNKNOWN;
+                    case METADATA:
+                        switch (length)
+                        {
+                        case 6:
+                            return key_equals(name, length, "planId") ? PLAN_ID : UNKNOWN;
+                        case 9:
+                            return key_equals(name, length, "hostBSMId") ? SENDER_BSM_ID : key_equals(name, length, "timestamp") ? TIMESTAMP
+                                                                                                                                 : UNKNOWN;
+                        case 12:
+                            return key_equals(name, length, "hostStaticId") ? SENDER_ID : UNKNOWN;
+                        case 14:
+                            return key_equals(name, length, "targetStaticId") ? RECIPIENT_ID : UNKNOWN;
+                        default:
+                            return UNKNOWN;
+                        }
+                    case TRAJECTORY:
+                        return key_iequals(name, length, "location") ? LOCATION : key_iequals(name, length, "offsets") ? OFFSETS
+                                                                                                                       : UNKNOWN;
+                    case LOCATION:
+                        if (length == 5 && key_equals(name, 4, "ecef"))
+                        {
+                            return name[4] == 'X' ? ECEF_X : name[4] == 'Y' ? ECEF_Y
+                                                         : name[4] == 'Z'   ? ECEF_Z
+                                                                            : UNKNOWN;
+                        }
+                        return key_equals(name, length, "timestamp") ? LOCATION_TIMESTAMP : UNKNOWN;
+                    case OFFSET:
+                        if (length == 7 && key_equals(name, 6, "offset"))
+                        {
+                            return name[6] == 'X' ? OFFSET_X : name[6] == 'Y' ? OFFSET_Y
+                                                           : name[6] == 'Z'   ? OFFSET_Z
+                                                                              : UNKNOWN;
+                        }
+                        return UNKNOWN;
+                    default:
+                        return UNKNOWN;
+                    }
+                }
+
+                int on_start_object(int context, int member)
+                {
+                    if (context == ROOT && member == METADATA)
+                    {
+                        has_header = true;
+                        return METADATA;
+                    }
+                    if ((context == ROOT && member == TRAJECTORY) || (context == TRAJECTORY && member == LOCATION))
+                    {
+                        return member;
+                    }
+                    if (context == OFFSETS)
+                    {
+                        offset = locationOffsetECEF_t();
+                        return OFFSET;
+                    }
+                    return UNKNOWN;
+                }
+
+                void on_end_object(int context)
+                {
+                    if (context == OFFSET)
+                    {
+                        trajectory.offsets.push_back(offset);
+                    }
+                }
+
+                int on_start_array(int context, int member)
+                {
+                    return context == TRAJECTORY && member == OFFSETS ? OFFSETS : UNKNOWN;
+                }
+
+                bool on_string(int context, int field, const char *str, rapidjson::SizeType length)
+                {
+                    switch (field)
+                    {
+                    case SENDER_ID:
+                        header.sender_id.assign(str, length);
+                        return true;
+                    case SENDER_BSM_ID:
+                        header.sender_bsm_id.assign(str, length);
+                        return true;
+                    case PLAN_ID:
+                        header.plan_id.assign(str, length);
+                        return true;
+                    case RECIPIENT_ID:
+                        header.recipient_id.assign(str, length);
+                        return true;
+                    default:
+                        return field < SENDER_ID || model_sax_handler<mobilitypath_sax_handler>::on_string(context, field, str, length);
+                    }
+                }
+
+                bool on_number(int, int field, const json_number_t &number)
+                {
+                    switch (field)
+                    {
+                    case TIMESTAMP:
+                        header.timestamp = static_cast<uint64_t>(number.as_int64());
+                        break;
+                    case ECEF_X:
+                        trajectory.location.ecef_x = static_cast<std::int32_t>(number.as_int64());
+                        break;
+                    case ECEF_Y:
+                        trajectory.location.ecef_y = static_cast<std::int32_t>(number.as_int64());
+                        break;
+                    case ECEF_Z:
+                        trajectory.location.ecef_z = static_cast<std::int32_t>(number.as_int64());
+                        break;
+                    case LOCATION_TIMESTAMP:
+                        trajectory.location.timestamp = static_cast<std::uint64_t>(number.as_int64());
+                        break;
+                    case OFFSET_X:
+                        offset.offset_x = static_cast<std::int16_t>(number.as_int64());
+                        break;
+                    case OFFSET_Y:
+                        offset.offset_y = static_cast<std::int16_t>(number.as_int64());
+                        break;
+                    case OFFSET_Z:
+                        offset.offset_z = static_cast<std::int16_t>(number.as_int64());
+                        break;
+                    default:
+                        break;
+                    }
+                    return true;
+                }
+            };
+        }
 
         mobilitypath::mobilitypath() : header(), trajectory() {}
 
@@ -116,6 +289,22 @@ namespace message_services
             }
         }
 
+        bool mobilitypath::fromJson(const char *json, size_t length)
+        {
+            mobility_header_t parsed_header;
+            bool has_header = false;
+            mobilitypath_sax_handler handler(parsed_header, has_header, this->trajectory);
+            if (!parse_json_sax(json, length, handler))
+            {
+                return false;
+            }
+            if (has_header)
+            {
+                this->header = std::move(parsed_header);
+            }
+            return true;
+        }
+
         bool mobilitypath::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
         {
             try
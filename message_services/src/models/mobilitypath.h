@@ -30,6 +30,9 @@ namespace message_services
             std::time_t msg_received_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
             virtual void fromJsonObject(const rapidjson::Value &obj);
+            using baseMessage::fromJson;
+            // Single pass SAX parse straight into the model, without building a DOM
+            bool fromJson(const char *json, size_t length) override;
             virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
             std::string generate_hash_sender_timestamp_id( std::string sender_bsm_id, uint64_t timestamp );
 
@@ -0,0 +1,101 @@
+#ifndef MSG_KEY_H
+#define MSG_KEY_H
+
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace message_services
+{
+    namespace models
+    {
+        /**
+         * @brief Packed 128 bit key used to join BSM, MobilityOperation and MobilityPath messages without building strings.
+         * id is the packed BSM id or sender id, value is (msg_count, sec_mark) for BSM keys or the timestamp bucket for sender timestamp keys.
+         * **/
+        typedef struct msg_key
+        {
+            std::uint64_t id = 0;
+            std::uint64_t value = 0;
+
+            bool operator==(const msg_key &other) const
+            {
+                return id == other.id && value == other.value;
+            }
+            bool operator!=(const msg_key &other) const
+            {
+                return !(*this == other);
+            }
+        } msg_key_t;
+
+        /**
+         * @brief Hash of a msg_key spreading both halves over all bits, so that the low bits can be used as table index.
+         * **/
+        struct msg_key_hash
+        {
+            std::size_t operator()(const msg_key_t &key) const
+            {
+                std::uint64_t h = key.id * 0x9E3779B97F4A7C15ULL ^ key.value;
+                h ^= h >> 33;
+                h *= 0xFF51AFD7ED558CCDULL;
+                h ^= h >> 33;
+                h *= 0xC4CEB9FE1A85EC53ULL;
+                h ^= h >> 33;
+                return static_cast<std::size_t>(h);
+            }
+        };
+
+        /**
+         * @brief Pack an id string in 64 bits. Ids of up to 8 bytes (BSM temporary ids, license plates) are stored as is.
+         * Longer ids are hashed with FNV-1a and flagged with the top bit, so that they never equal a packed ASCII id.
+         * @param id BSM id or sender id
+         * @return packed id
+         * **/
+        inline std::uint64_t pack_msg_id(const std::string &id)
+        {
+            std::uint64_t packed = 0;
+            if (id.size() <= sizeof(packed))
+            {
+                std::memcpy(&packed, id.data(), id.size());
+                return packed;
+            }
+            packed = 14695981039346656037ULL;
+            for (unsigned char c : id)
+            {
+                packed ^= c;
+                packed *= 1099511628211ULL;
+            }
+            return packed | (1ULL << 63);
+        }
+
+        /**
+         * @brief Key of a BSM, and of the BSM referenced by a MobilityOperation.
+         * @param temprary_id BSM id
+         * @param msg_count BSM msg_count
+         * @param sec_mark BSM sec_mark
+         * **/
+        inline msg_key_t generate_bsm_msg_key(const std::string &temprary_id, long msg_count, long sec_mark)
+        {
+            msg_key_t key;
+            key.id = pack_msg_id(temprary_id);
+            key.value = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(msg_count)) << 32) | static_cast<std::uint32_t>(sec_mark);
+            return key;
+        }
+
+        /**
+         * @brief Key of a MobilityPath, and of the MobilityPath matching a MobilityOperation.
+         * @param sender_id static id of the sender
+         * @param timestamp_bucket message timestamp divided by the matching duration
+         * **/
+        inline msg_key_t generate_sender_timestamp_key(const std::string &sender_id, std::uint64_t timestamp_bucket)
+        {
+            msg_key_t key;
+            key.id = pack_msg_id(sender_id);
+            key.value = timestamp_bucket;
+            return key;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * MobilityOperation strategy_params are comma separated key:value pairs, for example
+ * "msg_count: 12, sec_mark: 16323, access: 0, max_accel: 1.500000, max_decel: -1.000000, react_time: 4.500000,
+ * min_gap: 5.000000, depart_pos: 9999, turn_direction: straight"
+ * **/
+
+#ifndef STRATEGY_PARAMS_H
+#define STRATEGY_PARAMS_H
+
+#include <cstdint>
+#include <string>
+
+namespace message_services
+{
+    namespace models
+    {
+        typedef enum strategy_param
+        {
+            msg_count_param = 1 << 0,
+            sec_mark_param = 1 << 1,
+            access_param = 1 << 2,
+            max_accel_param = 1 << 3,
+            max_decel_param = 1 << 4,
+            react_time_param = 1 << 5,
+            min_gap_param = 1 << 6,
+            depart_pos_param = 1 << 7,
+            turn_direction_param = 1 << 8
+        } strategy_param_t;
+
+        /**
+         * @brief strategy_params converted once when the MobilityOperation is received.
+         * **/
+        typedef struct strategy_params
+        {
+            long msg_count = 0;
+            long sec_mark = 0;
+            long access = 0;
+            double max_accel = 0.0;
+            double max_decel = 0.0;
+            double react_time = 0.0;
+            double min_gap = 0.0;
+            long depart_pos = 0;
+            std::string turn_direction = "";
+            // Bit mask of the strategy_param_t found with a valid value
+            uint32_t parsed = 0;
+
+            bool has(uint32_t params) const
+            {
+                return (parsed & params) == params;
+            }
+        } strategy_params_t;
+    }
+}
+
+#endif
@@ -94,7 +94,7 @@ namespace message_services
                 writer->String("payload");
                 writer->StartObject();
                 writer->String("v_id");
-                writer->String(this->getVehicle_id().c_str());
+                writer->String(this->vehicle_id.c_str(), static_cast<rapidjson::SizeType>(this->vehicle_id.size()));
                 writer->String("v_length");
                 writer->Uint64(this->getVehicle_length());
                 writer->String("cur_speed");
@@ -125,12 +125,13 @@ namespace message_services
                 writer->Int64(this->getLink_lanelet_id());
                 //Vehicle turn direction at the intersection
                 writer->String("direction");
-                writer->String(this->GetTurn_direction().c_str());
+                writer->String(this->turn_direction.c_str(), static_cast<rapidjson::SizeType>(this->turn_direction.size()));
                 if (this->est_path_v.size() > 0)
                 {
                     writer->String("est_paths");
                     writer->StartArray();
-                    for (auto est_path_item : this->getEst_path_v())
+                    // Written from the member, without copying the est_path list
+                    for (const auto &est_path_item : this->est_path_v)
                     {
                         writer->StartObject();
                         //Lanelet id
@@ -204,7 +205,7 @@ namespace message_services
         }
         void vehicle_status_intent::setEst_path_v(std::vector<est_path_t> est_path_v)
         {
-            this->est_path_v = est_path_v;
+            this->est_path_v = std::move(est_path_v);
         }
 
         long vehicle_status_intent::getActual_enter_timestamp() const
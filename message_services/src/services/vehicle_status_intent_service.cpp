@@ -7,7 +7,6 @@ namespace message_services
 
     namespace services
     {
-        std::mutex worker_mtx;
         vehicle_status_intent_service::vehicle_status_intent_service() {}
 
 
@@ -16,45 +15,47 @@ namespace message_services
         {
             try
             {               
-                auto client = std::make_shared<kafka_clients::kafka_client>();
+                auto client = std::make_shared<kafka_clients::kafka_client>(
+                    kafka_clients::parse_transport_type(streets_service::streets_configuration::get_string_config("message_transport")));
 
                 // kafka config
                 this->bootstrap_server = streets_service::streets_configuration::get_string_config("bootstrap_server");
 
                 // consumer topics
                 this->bsm_topic_name = streets_service::streets_configuration::get_string_config("bsm_consumer_topic");
-                this->bsm_group_id = streets_service::streets_configuration::get_string_config("bsm_group_id");
-
                 this->mp_topic_name = streets_service::streets_configuration::get_string_config("mp_consumer_topic");
-                this->mp_group_id = streets_service::streets_configuration::get_string_config("mp_group_id");
-
                 this->mo_topic_name = streets_service::streets_configuration::get_string_config("mo_consumer_topic");
-                this->mo_group_id = streets_service::streets_configuration::get_string_config("mo_group_id");
+                this->consumer_group_id = streets_service::streets_configuration::get_string_config("consumer_group_id");
 
                 // producer topics
                 this->vsi_topic_name = streets_service::streets_configuration::get_string_config("vsi_producer_topic");
 
-                _bsm_consumer_worker = client->create_consumer(this->bootstrap_server, this->bsm_topic_name, this->bsm_group_id);
-                _mp_consumer_worker = client->create_consumer(this->bootstrap_server, this->mp_topic_name, this->mp_group_id);
-                _mo_consumer_worker = client->create_consumer(this->bootstrap_server, this->mo_topic_name, this->mo_group_id);
+                auto consumer_properties = kafka_clients::get_consumer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_properties"));
+                auto producer_properties = kafka_clients::get_producer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_producer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_producer_properties"));
+
+                // Single consumer for the BSM, MobilityPath and MobilityOperation topics
+                _consumer_worker = client->create_consumer_transport(this->bootstrap_server, std::vector<std::string>{this->bsm_topic_name, this->mp_topic_name, this->mo_topic_name},
+                                                           this->consumer_group_id, consumer_properties);
 
-                if (!_bsm_consumer_worker->init() || !_mp_consumer_worker->init() || !_mo_consumer_worker->init())
+                if (!_consumer_worker->init())
                 {
-                    SPDLOG_CRITICAL("kafka consumers (_bsm_consumer_worker, _mp_consumer_worker or _mo_consumer_worker) initialize error");
+                    SPDLOG_CRITICAL("kafka consumer (_consumer_worker) initialize error");
                 }
                 else
                 {
-                    _bsm_consumer_worker->subscribe();
-                    _mp_consumer_worker->subscribe();
-                    _mo_consumer_worker->subscribe();
-                    if (!_bsm_consumer_worker->is_running() || !_mp_consumer_worker->is_running() || !_mo_consumer_worker->is_running())
+                    _consumer_worker->subscribe();
+                    if (!_consumer_worker->is_running())
                     {
-                        SPDLOG_CRITICAL("consumer_workers (_bsm_consumer_worker, _mp_consumer_worker or _mo_consumer_worker) is not running");
+                        SPDLOG_CRITICAL("consumer_worker (_consumer_worker) is not running");
                         exit(-1);
                     }
                 }
 
-                this->_vsi_producer_worker = client->create_producer(this->bootstrap_server, this->vsi_topic_name);
+                this->_vsi_producer_worker = client->create_producer_transport(this->bootstrap_server, this->vsi_topic_name, producer_properties);
                 if (!_vsi_producer_worker->init())
                 {
                     SPDLOG_CRITICAL("kafka producer (_vsi_producer_worker) initialize error");
@@ -63,11 +64,13 @@ namespace message_services
 
                 this->vsi_est_path_point_count = streets_service::streets_configuration::get_int_config("vsi_est_path_count");
                 this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION = streets_service::streets_configuration::get_int_config("mobility_path_trajectory_offset_duration");
-                this->VSI_TH_SLEEP_MILLI_SEC = streets_service::streets_configuration::get_int_config("vsi_th_sleep_milli_sec");
-                this->BSM_MSG_EXPIRE_IN_SEC = streets_service::streets_configuration::get_int_config("bsm_msg_expire_in_sec");
-                this->CLEAN_QUEUE_IN_SECS = streets_service::streets_configuration::get_int_config("clean_queue_in_secs");
+                this->VSI_JOIN_WINDOW_MILLI_SEC = streets_service::streets_configuration::get_int_config("vsi_join_window_milli_sec");
+                this->VSI_JOIN_MAX_PENDING_PER_VEHICLE = streets_service::streets_configuration::get_int_config("vsi_join_max_pending_per_vehicle");
+                this->VSI_COMPOSITION_WORKER_COUNT = streets_service::streets_configuration::get_int_config("vsi_composition_worker_count");
+                this->VSI_COMPOSITION_QUEUE_SIZE = streets_service::streets_configuration::get_int_config("vsi_composition_queue_size");
                 this->disable_est_path = streets_service::streets_configuration::get_boolean_config("disable_est_path");
                 this->is_est_path_p2p_distance_only = streets_service::streets_configuration::get_boolean_config("is_est_path_p2p_distance_only");
+                kafka_clients::pipeline_trace_metrics::instance().set_log_interval_ms(streets_service::streets_configuration::get_int_config("pipeline_trace_log_interval"));
 
                 this->_msg_lanelet2_translate_ptr = msg_lanelet2_translate_ptr;
 
@@ -81,162 +84,33 @@ namespace message_services
 
         vehicle_status_intent_service::~vehicle_status_intent_service()
         {
-            if (_bsm_consumer_worker)
+            if (_consumer_worker)
             {
-                _bsm_consumer_worker->stop();
+                _consumer_worker->stop();
             }
-
-            if (_mo_consumer_worker)
+            if (_composition_pool)
             {
-                _mo_consumer_worker->stop();
-            }
-
-            if (_mp_consumer_worker)
-            {
-                _mp_consumer_worker->stop();
+                _composition_pool->stop();
             }
         }
 
         void vehicle_status_intent_service::start()
         {
-            std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr = std::make_shared<message_services::workers::bsm_worker>();
-            std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr = std::make_shared<message_services::workers::mobilitypath_worker>();
-            std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr = std::make_shared<message_services::workers::mobilityoperation_worker>();
-            std::shared_ptr<message_services::workers::vehicle_status_intent_worker> vsi_w_ptr = std::make_shared<message_services::workers::vehicle_status_intent_worker>();
-            run(bsm_w_ptr, mp_w_ptr, mo_w_ptr);
+            std::shared_ptr<message_services::workers::vsi_join_worker> join_w_ptr = std::make_shared<message_services::workers::vsi_join_worker>(this->VSI_JOIN_WINDOW_MILLI_SEC, this->VSI_JOIN_MAX_PENDING_PER_VEHICLE);
+            this->_composition_pool = std::make_shared<message_services::workers::vsi_composition_pool>(std::max<std::int64_t>(this->VSI_COMPOSITION_WORKER_COUNT, 1),
+                                                                                                        std::max<std::int64_t>(this->VSI_COMPOSITION_QUEUE_SIZE, 1),
+                                                                                                        [this](workers::vsi_message_bucket_t &joined)
+                                                                                                        { publish_vsi(joined); });
+            this->_composition_pool->start();
+            run(join_w_ptr);
+            this->_composition_pool->stop();
         }
 
-        void vehicle_status_intent_service::run(std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr,
-                                                std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr,
-                                                std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr)
+        void vehicle_status_intent_service::run(std::shared_ptr<message_services::workers::vsi_join_worker> join_w_ptr)
         {
-            std::thread mp_t(&vehicle_status_intent_service::msg_consumer<workers::mobilitypath_worker>, this, std::ref(mp_w_ptr), this->_mp_consumer_worker);
-            std::thread bsm_t(&vehicle_status_intent_service::msg_consumer<workers::bsm_worker>, this, std::ref(bsm_w_ptr), this->_bsm_consumer_worker);
-            std::thread mo_t(&vehicle_status_intent_service::msg_consumer<workers::mobilityoperation_worker>, this, std::ref(mo_w_ptr), this->_mo_consumer_worker);
-
-            std::shared_ptr<models::vehicle_status_intent> vsi_ptr = std::make_shared<models::vehicle_status_intent>();
-
-            std::thread vsi_t{
-                [bsm_w_ptr, mo_w_ptr, mp_w_ptr, this, vsi_ptr]()
-                {
-                    while (true)
-                    {
-                        // Change spdlog from debug to info for printing output in terminal
-                        SPDLOG_DEBUG("Processing the BSM list size: {0}", bsm_w_ptr->get_curr_map().size());
-                        SPDLOG_DEBUG("Processing the MobilityOperation list size: {0}", mo_w_ptr->get_curr_list().size());
-                        SPDLOG_DEBUG("Processing the MobilityPath list size: {0}", mp_w_ptr->get_curr_map().size());
-                        if (mo_w_ptr && mo_w_ptr->get_curr_list().size() > 0 && bsm_w_ptr && bsm_w_ptr->get_curr_map().size() > 0 && mp_w_ptr && mp_w_ptr->get_curr_map().size() > 0)
-                        {
-                            SPDLOG_DEBUG("Processing the BSM, mobilityOperation and MP from list...");
-                            std::unique_lock<std::mutex> lck(worker_mtx);
-                            while (mo_w_ptr && !mo_w_ptr->get_curr_list().empty())
-                            {
-                                SPDLOG_INFO("MO list SIZE = {0}", mo_w_ptr->get_curr_list().size());
-                                SPDLOG_INFO("MP map SIZE = {0}", mp_w_ptr->get_curr_map().size());
-                                SPDLOG_INFO("BSM map SIZE = {0}", bsm_w_ptr->get_curr_map().size());
-                                message_services::models::mobilityoperation subj_mo = mo_w_ptr->get_curr_list().front();
-                                mo_w_ptr->get_curr_list().pop_front();
-
-                                message_services::models::mobilitypath subj_mp;
-                                message_services::models::bsm subj_bsm;
-                                bool is_bsm_msg_count_id_found = false;
-                                std::time_t cur_local_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                                std::string bsm_msg_id = subj_mo.generate_hash_bsm_msg_id(subj_mo.getHeader().sender_bsm_id, std::stol(subj_mo.get_value_from_strategy_params("msg_count")), std::stol(subj_mo.get_value_from_strategy_params("sec_mark")));
-                                if (bsm_w_ptr->get_curr_map().find(bsm_msg_id) != bsm_w_ptr->get_curr_map().end())
-                                {
-                                    subj_bsm = bsm_w_ptr->get_curr_map()[bsm_msg_id];
-
-                                    if (std::abs(cur_local_timestamp - subj_bsm.msg_received_timestamp_) > (this->BSM_MSG_EXPIRE_IN_SEC * 1000))
-                                    {
-                                        SPDLOG_INFO("BSM EXPIRED {0}", std::abs(cur_local_timestamp - subj_bsm.msg_received_timestamp_));
-                                        bsm_w_ptr->get_curr_map().erase(bsm_msg_id);
-                                        continue;
-                                    }
-                                    is_bsm_msg_count_id_found = true;
-                                }
-                                else
-                                {
-                                    continue;
-                                }
-
-                                std::string sender_timestamp_msg_id = subj_mo.generate_hash_sender_timestamp_id(subj_mo.getHeader().sender_id, subj_mo.getHeader().timestamp / this->MOBILITY_OPERATION_PATH_MAX_DURATION);
-
-                                if (is_bsm_msg_count_id_found && mp_w_ptr->get_curr_map().find(sender_timestamp_msg_id) != mp_w_ptr->get_curr_map().end())
-                                {
-                                    subj_mp = mp_w_ptr->get_curr_map()[sender_timestamp_msg_id];
-                                }
-                                else
-                                {
-                                    continue;
-                                }
-
-                                *vsi_ptr = compose_vehicle_status_intent(subj_bsm, subj_mo, subj_mp);
-                                if (vsi_ptr)
-                                {
-                                    SPDLOG_DEBUG("Done composing vehicle_status_intent");
-                                    std::string msg_to_pub = vsi_ptr->asJson();
-                                    this->publish_msg<const char *>(msg_to_pub.c_str(), this->_vsi_producer_worker);
-                                }
-                                mp_w_ptr->get_curr_map().erase(sender_timestamp_msg_id);
-                                bsm_w_ptr->get_curr_map().erase(bsm_msg_id);
-                            }
-                        }
-
-                        std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                        if (std::abs(cur_timestamp - this->prev_msg_expired_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                        {
-                            SPDLOG_DEBUG("Clean the BSM and MP...");
-                            SPDLOG_DEBUG("MO list SIZE = {0}", mo_w_ptr->get_curr_list().size());
-                            SPDLOG_DEBUG("MP map SIZE = {0}", mp_w_ptr->get_curr_map().size());
-                            SPDLOG_DEBUG("BSM map SIZE = {0}", bsm_w_ptr->get_curr_map().size());
-
-                            if (mp_w_ptr && !mp_w_ptr->get_curr_map().empty())
-                            {
-                                SPDLOG_DEBUG("Clean the MP...");
-                                for (auto itr = mp_w_ptr->get_curr_map().cbegin(); itr != mp_w_ptr->get_curr_map().cend();)
-                                {
-                                    if (mp_w_ptr && std::abs(cur_timestamp - itr->second.msg_received_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                                    {
-                                        std::unique_lock<std::mutex> lck(worker_mtx);
-                                        mp_w_ptr->get_curr_map().erase(itr++);
-                                    }
-                                    else
-                                    {
-                                        ++itr;
-                                    }
-                                }
-                                SPDLOG_DEBUG("Cleaned the MP.");
-                            }
-
-                            if (bsm_w_ptr && !bsm_w_ptr->get_curr_map().empty())
-                            {
-                                SPDLOG_DEBUG("Clean the BSM...");
-                                for (auto itr = bsm_w_ptr->get_curr_map().cbegin(); itr != bsm_w_ptr->get_curr_map().cend();)
-                                {
-                                    if (bsm_w_ptr && std::abs(cur_timestamp - itr->second.msg_received_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                                    {
-                                        std::unique_lock<std::mutex> lck(worker_mtx);
-                                        bsm_w_ptr->get_curr_map().erase(itr++);
-                                    }
-                                    else
-                                    {
-                                        ++itr;
-                                    }
-                                }
-                                SPDLOG_DEBUG("Cleaned the BSM.");
-                            }
-
-                            prev_msg_expired_timestamp_ = cur_timestamp;
-                        }
-                        std::this_thread::sleep_for(std::chrono::milliseconds(this->VSI_TH_SLEEP_MILLI_SEC));
-                    }
-                }};
-
-            vsi_t.join();
-            mp_t.join();
-            mo_t.join();
-            bsm_t.join();
-        }     
+            std::thread consumer_t(&vehicle_status_intent_service::msg_consumer, this, join_w_ptr);
+            consumer_t.join();
+        }
 
         models::vehicle_status_intent vehicle_status_intent_service::compose_vehicle_status_intent(models::bsm &bsm,
                                                                                                    models::mobilityoperation &mo,
@@ -245,21 +119,26 @@ namespace message_services
             models::vehicle_status_intent vsi;
             try
             {
+                const models::strategy_params_t &params = mo.getParsed_strategy_params();
+                if (!params.has(models::access_param | models::max_accel_param | models::max_decel_param | models::react_time_param | models::min_gap_param | models::depart_pos_param))
+                {
+                    SPDLOG_CRITICAL("MobilityOperation from {0} is missing strategy params: {1}", mo.getHeader().sender_id, mo.getStrategy_params());
+                    return vsi;
+                }
                 vsi.setVehicle_id(mo.getHeader().sender_id);
-                vsi.setDepart_position(std::stol(mo.get_value_from_strategy_params("depart_pos")));
                 vsi.setCur_timestamp(mo.getHeader().timestamp);
-                vsi.setIs_allowed(std::stol(mo.get_value_from_strategy_params("access")));
-                vsi.setMax_accel(std::stod(mo.get_value_from_strategy_params("max_accel")));
-                vsi.setMax_decel(std::stod(mo.get_value_from_strategy_params("max_decel")));
-                vsi.setReact_timestamp(std::stod(mo.get_value_from_strategy_params("react_time")));
-                vsi.setMinimum_gap(std::stod(mo.get_value_from_strategy_params("min_gap")));
-                vsi.setDepart_position(std::stol(mo.get_value_from_strategy_params("depart_pos")));
+                vsi.setIs_allowed(params.access);
+                vsi.setMax_accel(params.max_accel);
+                vsi.setMax_decel(params.max_decel);
+                vsi.setReact_timestamp(params.react_time);
+                vsi.setMinimum_gap(params.min_gap);
+                vsi.setDepart_position(params.depart_pos);
 
                 // Update vehicle status intent with BSM
                 vsi.setVehicle_length(bsm.getCore_data().size.length);
                 vsi.setCur_speed(bsm.getCore_data().speed);
                 vsi.setCur_accel(bsm.getCore_data().accelSet.Long);
-                std::string turn_direction = mo.get_value_from_strategy_params("turn_direction");
+                const std::string &turn_direction = params.turn_direction;
                 vsi.SetTurn_direction(turn_direction);
                 double cur_lat = bsm.getCore_data().latitude / 10000000;
                 double cur_lon = bsm.getCore_data().longitude / 10000000;
@@ -271,7 +150,7 @@ namespace message_services
                 SPDLOG_DEBUG("MobilityPath trajectory offset size: {0}", mp.getTrajectory().offsets.size());
                 message_services::models::trajectory trajectory = mp.getTrajectory();
                 lanelet::BasicPoint3d cur_basic_point3d = _msg_lanelet2_translate_ptr->gps_2_map_point(cur_lat, cur_lon, cur_elev);
-                lanelet::Lanelet cur_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(cur_basic_point3d, turn_direction, trajectory);         
+                lanelet::Lanelet cur_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_vehicle_and_direction(mo.getHeader().sender_id, cur_basic_point3d, turn_direction, trajectory);         
                 vsi.setCur_lanelet_id(cur_lanelet.id());
                 vsi.setCur_distance(_msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(cur_basic_point3d, cur_lanelet, turn_direction, trajectory));      
             
@@ -288,7 +167,8 @@ namespace message_services
                 SPDLOG_DEBUG("MobilityPath location ecef_x: {0}", ecef_x);
                 SPDLOG_DEBUG("MobilityPath location ecef_y: {0}", ecef_y);
                 SPDLOG_DEBUG("MobilityPath location ecef_z: {0}", ecef_z);
-                lanelet::BasicPoint3d mp_start_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
+                message_translations::trajectory_map_points_t trajectory_points = _msg_lanelet2_translate_ptr->trajectory_2_map_points(trajectory);
+                lanelet::BasicPoint3d mp_start_point = trajectory_points.at(0);
                 if(is_est_path_p2p_distance_only)
                 {
                     est_path.distance = lanelet::geometry::distance(lanelet::utils::to2D(cur_basic_point3d),lanelet::utils::to2D(mp_start_point));
@@ -296,7 +176,7 @@ namespace message_services
                 }
                 else
                 {
-                    lanelet::Lanelet mp_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(mp_start_point, turn_direction, trajectory);
+                    lanelet::Lanelet mp_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(mp_start_point, turn_direction, trajectory_points);
                     est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(mp_start_point,mp_point_lanelet, turn_direction, trajectory);
                     est_path.lanelet_id = mp_point_lanelet.id();
                 }
@@ -309,10 +189,6 @@ namespace message_services
                 lanelet::BasicPoint3d mp_cur_point = mp_start_point;
                 for (size_t offset_index = 0; offset_index < trajectory.offsets.size(); offset_index++)
                 {
-                    ecef_x += trajectory.offsets.at(offset_index).offset_x;
-                    ecef_y += trajectory.offsets.at(offset_index).offset_y;
-                    ecef_z += trajectory.offsets.at(offset_index).offset_z;
-
                     SPDLOG_DEBUG("MobilityPath location offset_x: {0}", trajectory.offsets.at(offset_index).offset_x);
                     SPDLOG_DEBUG("MobilityPath location offset_y: {0}", trajectory.offsets.at(offset_index).offset_y);
                     SPDLOG_DEBUG("MobilityPath location offset_z: {0}", trajectory.offsets.at(offset_index).offset_z);
@@ -322,7 +198,7 @@ namespace message_services
                     if(is_est_path_p2p_distance_only)
                     {   
                         lanelet::BasicPoint3d mp_previous_point = mp_cur_point;
-                        mp_cur_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
+                        mp_cur_point = trajectory_points.at(offset_index + 1);
                         accumulated_distance_to_previous_point += lanelet::geometry::distance2d(lanelet::utils::to2D(mp_cur_point),lanelet::utils::to2D(mp_previous_point));                        
                     }
 
@@ -349,8 +225,8 @@ namespace message_services
                     }
                     else
                     {
-                        lanelet::BasicPoint3d trajectory_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
-                        lanelet::Lanelet trajectory_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(trajectory_point, turn_direction, trajectory);            
+                        lanelet::BasicPoint3d trajectory_point = trajectory_points.at(offset_index + 1);
+                        lanelet::Lanelet trajectory_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(trajectory_point, turn_direction, trajectory_points);            
                         est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(trajectory_point, trajectory_point_lanelet, turn_direction, trajectory);
                         est_path.lanelet_id = trajectory_point_lanelet.id();
                     }
@@ -365,7 +241,7 @@ namespace message_services
                     }
                 }
 
-                vsi.setEst_path_v(est_path_v);
+                vsi.setEst_path_v(std::move(est_path_v));
             }
             
                 std::map<int64_t, models::intersection_lanelet_type> lanelet_id_type_m = _msg_lanelet2_translate_ptr->get_lanelet_types_ids(cur_lanelet, turn_direction);
@@ -393,28 +269,87 @@ namespace message_services
             }
         }
 
+        void vehicle_status_intent_service::msg_consumer(std::shared_ptr<workers::vsi_join_worker> join_w_ptr)
+        {
+            if (!join_w_ptr)
+            {
+                SPDLOG_CRITICAL("Join worker is not initialized");
+                return;
+            }
+            kafka_clients::kafka_consumer_dispatcher dispatcher(_consumer_worker);
+            dispatcher.register_handler(this->bsm_topic_name, [this, join_w_ptr](const kafka_clients::kafka_message &msg)
+                                        {
+                                            models::bsm bsm_obj;
+                                            workers::vsi_message_bucket_t joined;
+                                            kafka_clients::trace_context trace = kafka_clients::read_trace_context(msg);
+                                            trace.mark(kafka_clients::trace_stage::INGEST);
+                                            if (parse_msg(msg, bsm_obj) && join_w_ptr->process_bsm(std::move(bsm_obj), joined))
+                                            {
+                                                joined.trace = trace;
+                                                joined.trace.mark(kafka_clients::trace_stage::JOIN);
+                                                _composition_pool->submit(std::move(joined));
+                                            } });
+            dispatcher.register_handler(this->mp_topic_name, [this, join_w_ptr](const kafka_clients::kafka_message &msg)
+                                        {
+                                            models::mobilitypath mp_obj;
+                                            workers::vsi_message_bucket_t joined;
+                                            kafka_clients::trace_context trace = kafka_clients::read_trace_context(msg);
+                                            trace.mark(kafka_clients::trace_stage::INGEST);
+                                            if (parse_msg(msg, mp_obj) && join_w_ptr->process_mobilitypath(std::move(mp_obj), joined))
+                                            {
+                                                joined.trace = trace;
+                                                joined.trace.mark(kafka_clients::trace_stage::JOIN);
+                                                _composition_pool->submit(std::move(joined));
+                                            } });
+            dispatcher.register_handler(this->mo_topic_name, [this, join_w_ptr](const kafka_clients::kafka_message &msg)
+                                        {
+                                            models::mobilityoperation mo_obj;
+                                            workers::vsi_message_bucket_t joined;
+                                            kafka_clients::trace_context trace = kafka_clients::read_trace_context(msg);
+                                            trace.mark(kafka_clients::trace_stage::INGEST);
+                                            if (parse_msg(msg, mo_obj) && join_w_ptr->process_mobilityoperation(std::move(mo_obj), joined))
+                                            {
+                                                joined.trace = trace;
+                                                joined.trace.mark(kafka_clients::trace_stage::JOIN);
+                                                _composition_pool->submit(std::move(joined));
+                                            } });
+            dispatcher.run();
+        }
+
         template <typename T>
-        void vehicle_status_intent_service::msg_consumer(std::shared_ptr<T> msg_w_ptr, std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer_worker)
+        bool vehicle_status_intent_service::parse_msg(const kafka_clients::kafka_message &msg, T &msg_obj)
         {
-            while (consumer_worker->is_running())
+            if (msg.empty())
             {
-                const std::string payload = consumer_worker->consume(1000);
-                if (payload.length() != 0 && msg_w_ptr)
-                {
-                    std::unique_lock<std::mutex> lck(worker_mtx);
-                    msg_w_ptr->process_incoming_msg(payload);
-                }
+                return false;
+            }
+            // Parse the payload in place, without copying it into a string
+            if (!msg_obj.fromJson(msg.payload(), msg.length()))
+            {
+                SPDLOG_CRITICAL("Document parse error on topic {0}", msg.topic());
+                return false;
+            }
+            return true;
+        }
 
-                if (!msg_w_ptr)
-                {
-                    SPDLOG_CRITICAL("Message worker is not initialized");
-                }
+        void vehicle_status_intent_service::publish_vsi(workers::vsi_message_bucket_t &joined)
+        {
+            models::vehicle_status_intent vsi = compose_vehicle_status_intent(joined.bsm, joined.mo, joined.mp);
+            SPDLOG_DEBUG("Done composing vehicle_status_intent");
+            joined.trace.mark(kafka_clients::trace_stage::LANELET_LOOKUP);
+            // Serialized in the reusable buffer of the composition thread and moved into the producer
+            std::string msg_to_pub = vsi.asJson();
+            joined.trace.mark(kafka_clients::trace_stage::SERIALIZE);
+            if (!msg_to_pub.empty())
+            {
+                joined.trace.mark(kafka_clients::trace_stage::PRODUCE);
+                this->_vsi_producer_worker->send(std::move(msg_to_pub), joined.trace);
             }
-            return;
+            kafka_clients::pipeline_trace_metrics::instance().record(joined.trace, kafka_clients::trace_stage::INGEST, kafka_clients::trace_stage::PRODUCE);
         }
 
         template <typename T>
-        void vehicle_status_intent_service::publish_msg(T msg,  std::shared_ptr<kafka_clients::kafka_producer_worker> producer_worker)
+        void vehicle_status_intent_service::publish_msg(T msg,  std::shared_ptr<kafka_clients::producer_transport> producer_worker)
         {
             std::string msg_to_send = "";
             msg_to_send = (char *)msg;
@@ -0,0 +1,143 @@
+#include "vsi_composition_pool.h"
+
+#include <chrono>
+
+namespace message_services
+{
+    namespace workers
+    {
+        namespace
+        {
+            // Empty polls answered with a yield before the worker blocks, or full pushes before the submitter starts sleeping
+            const int SPIN_COUNT = 64;
+            const std::chrono::microseconds FULL_QUEUE_SLEEP(50);
+        }
+
+        vsi_composition_pool::vsi_composition_pool(size_t worker_count, size_t queue_size, std::function<void(vsi_message_bucket_t &)> compose_handler)
+            : compose_handler(std::move(compose_handler))
+        {
+            if (worker_count == 0)
+            {
+                worker_count = 1;
+            }
+            for (size_t i = 0; i < worker_count; i++)
+            {
+                queues.push_back(std::make_unique<kafka_clients::bounded_mpmc_queue<vsi_message_bucket_t>>(queue_size));
+                signals.push_back(std::make_unique<worker_signal_t>());
+            }
+        }
+
+        vsi_composition_pool::~vsi_composition_pool()
+        {
+            stop();
+        }
+
+        void vsi_composition_pool::start()
+        {
+            if (running.exchange(true))
+            {
+                return;
+            }
+            for (size_t i = 0; i < queues.size(); i++)
+            {
+                threads.emplace_back(&vsi_composition_pool::run_worker, this, i);
+            }
+            SPDLOG_INFO("Started {0} vehicle status and intent composition workers. ", queues.size());
+        }
+
+        void vsi_composition_pool::stop()
+        {
+            running.store(false);
+            for (auto &signal : signals)
+            {
+                std::lock_guard<std::mutex> lck(signal->mtx);
+                signal->cv.notify_all();
+            }
+            for (auto &thread : threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            threads.clear();
+        }
+
+        bool vsi_composition_pool::submit(vsi_message_bucket_t &&joined)
+        {
+            size_t index = worker_index(joined.mo.getHeader().sender_id);
+            auto &queue = queues[index];
+            auto &signal = *signals[index];
+            int spins = 0;
+            while (running.load(std::memory_order_relaxed))
+            {
+                if (queue->try_push(std::move(joined)))
+                {
+                    // The worker publishes sleeping before checking pending, so one of the two sees the other's store
+                    signal.pending.fetch_add(1);
+                    if (signal.sleeping.load())
+                    {
+                        std::lock_guard<std::mutex> lck(signal.mtx);
+                        signal.cv.notify_one();
+                    }
+                    return true;
+                }
+                if (spins < SPIN_COUNT)
+                {
+                    std::this_thread::yield();
+                    spins++;
+                }
+                else
+                {
+                    std::this_thread::sleep_for(FULL_QUEUE_SLEEP);
+                }
+            }
+            return false;
+        }
+
+        size_t vsi_composition_pool::worker_index(const std::string &vehicle_id) const
+        {
+            return std::hash<std::string>{}(vehicle_id) % queues.size();
+        }
+
+        size_t vsi_composition_pool::worker_count() const
+        {
+            return queues.size();
+        }
+
+        void vsi_composition_pool::run_worker(size_t index)
+        {
+            auto &queue = queues[index];
+            auto &signal = *signals[index];
+            vsi_message_bucket_t joined;
+            int spins = 0;
+            while (true)
+            {
+                if (queue->try_pop(joined))
+                {
+                    signal.pending.fetch_sub(1);
+                    spins = 0;
+                    compose_handler(joined);
+                    continue;
+                }
+                if (!running.load())
+                {
+                    break;
+                }
+                if (spins < SPIN_COUNT)
+                {
+                    std::this_thread::yield();
+                    spins++;
+                    continue;
+                }
+                // Block until a message is submitted or the pool is stopped
+                std::unique_lock<std::mutex> lck(signal.mtx);
+                signal.sleeping.store(true);
+                signal.cv.wait(lck, [this, &signal]()
+                               { return signal.pending.load() > 0 || !running.load(); });
+                signal.sleeping.store(false);
+                spins = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,235 @@
+#include "vsi_join_worker.h"
+
+namespace message_services
+{
+    namespace workers
+    {
+        vsi_join_worker::vsi_join_worker(std::time_t join_window_milli_sec, size_t max_pending_per_vehicle)
+            : join_window_milli_sec(join_window_milli_sec), max_pending_per_vehicle(std::max<size_t>(max_pending_per_vehicle, 1))
+        {
+        }
+
+        bool vsi_join_worker::process_bsm(models::bsm bsm, vsi_message_bucket_t &joined)
+        {
+            models::bsmCoreData_t core_data = bsm.getCore_data();
+            models::msg_key_t bsm_msg_key = models::generate_bsm_msg_key(core_data.temprary_id, core_data.msg_count, core_data.sec_mark);
+            std::time_t cur_timestamp = bsm.msg_received_timestamp_;
+
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            expire_locked(cur_timestamp);
+            this->bsm_m.insert_or_assign(bsm_msg_key, std::move(bsm));
+            schedule_expiry(cur_timestamp, expiry_kind::bsm, bsm_msg_key, "");
+
+            const std::string *sender_id = this->pending_bsm_msg_key_m.find(bsm_msg_key);
+            if (sender_id == nullptr)
+            {
+                return false;
+            }
+            auto sender_itr = this->pending_mo_m.find(*sender_id);
+            if (sender_itr == this->pending_mo_m.end())
+            {
+                return false;
+            }
+            for (auto pending_itr = sender_itr->second.begin(); pending_itr != sender_itr->second.end(); pending_itr++)
+            {
+                if (pending_itr->bsm_msg_key == bsm_msg_key && try_join(*pending_itr, cur_timestamp, joined))
+                {
+                    erase_pending(sender_itr, pending_itr);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool vsi_join_worker::process_mobilitypath(models::mobilitypath mp, vsi_message_bucket_t &joined)
+        {
+            models::mobility_header_t header = mp.getHeader();
+            models::msg_key_t mp_msg_key = models::generate_sender_timestamp_key(header.sender_id, header.timestamp / MOBILITY_OPERATION_PATH_MAX_DURATION);
+            std::time_t cur_timestamp = mp.msg_received_timestamp_;
+
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            expire_locked(cur_timestamp);
+            this->mp_m.insert_or_assign(mp_msg_key, std::move(mp));
+            schedule_expiry(cur_timestamp, expiry_kind::mobilitypath, mp_msg_key, "");
+
+            auto sender_itr = this->pending_mo_m.find(header.sender_id);
+            if (sender_itr == this->pending_mo_m.end())
+            {
+                return false;
+            }
+            for (auto pending_itr = sender_itr->second.begin(); pending_itr != sender_itr->second.end(); pending_itr++)
+            {
+                if (pending_itr->mp_msg_key == mp_msg_key && try_join(*pending_itr, cur_timestamp, joined))
+                {
+                    erase_pending(sender_itr, pending_itr);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool vsi_join_worker::process_mobilityoperation(models::mobilityoperation mo, vsi_message_bucket_t &joined)
+        {
+            models::mobility_header_t header = mo.getHeader();
+            const models::strategy_params_t &params = mo.getParsed_strategy_params();
+            if (!params.has(models::msg_count_param | models::sec_mark_param))
+            {
+                SPDLOG_ERROR("MobilityOperation from {0} has no valid msg_count and sec_mark strategy params: {1}", header.sender_id, mo.getStrategy_params());
+                return false;
+            }
+            pending_mobilityoperation_t pending;
+            pending.bsm_msg_key = models::generate_bsm_msg_key(header.sender_bsm_id, params.msg_count, params.sec_mark);
+            pending.mp_msg_key = models::generate_sender_timestamp_key(header.sender_id, header.timestamp / MOBILITY_OPERATION_PATH_MAX_DURATION);
+            std::time_t cur_timestamp = mo.msg_received_timestamp_;
+            pending.mo = std::move(mo);
+
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            expire_locked(cur_timestamp);
+            if (try_join(pending, cur_timestamp, joined))
+            {
+                return true;
+            }
+
+            auto sender_itr = this->pending_mo_m.find(header.sender_id);
+            if (sender_itr != this->pending_mo_m.end() && sender_itr->second.size() >= this->max_pending_per_vehicle)
+            {
+                SPDLOG_DEBUG("Join window of vehicle {0} is full, dropping its oldest MobilityOperation", header.sender_id);
+                erase_pending(sender_itr, sender_itr->second.begin());
+            }
+            this->pending_bsm_msg_key_m.insert_or_assign(pending.bsm_msg_key, header.sender_id);
+            this->pending_mo_m[header.sender_id].push_back(std::move(pending));
+            schedule_expiry(cur_timestamp, expiry_kind::mobilityoperation, models::msg_key_t(), header.sender_id);
+            return false;
+        }
+
+        bool vsi_join_worker::try_join(pending_mobilityoperation_t &pending, std::time_t cur_timestamp, vsi_message_bucket_t &joined)
+        {
+            models::bsm *bsm = this->bsm_m.find(pending.bsm_msg_key);
+            if (bsm == nullptr)
+            {
+                return false;
+            }
+            if (std::abs(cur_timestamp - bsm->msg_received_timestamp_) > this->join_window_milli_sec)
+            {
+                SPDLOG_DEBUG("BSM EXPIRED {0}", std::abs(cur_timestamp - bsm->msg_received_timestamp_));
+                this->bsm_m.erase(pending.bsm_msg_key);
+                return false;
+            }
+            models::mobilitypath *mp = this->mp_m.find(pending.mp_msg_key);
+            if (mp == nullptr)
+            {
+                return false;
+            }
+
+            joined.mo = std::move(pending.mo);
+            joined.bsm = std::move(*bsm);
+            joined.mp = std::move(*mp);
+            this->bsm_m.erase(pending.bsm_msg_key);
+            this->mp_m.erase(pending.mp_msg_key);
+            return true;
+        }
+
+        void vsi_join_worker::erase_pending(std::unordered_map<std::string, std::deque<pending_mobilityoperation_t>>::iterator sender_itr,
+                                            std::deque<pending_mobilityoperation_t>::iterator pending_itr)
+        {
+            auto &vehicle_pending = sender_itr->second;
+            // Another MobilityOperation of the same vehicle may still wait for the same BSM
+            auto bsm_msg_key_count = std::count_if(vehicle_pending.begin(), vehicle_pending.end(), [&pending_itr](const pending_mobilityoperation_t &pending)
+                                                   { return pending.bsm_msg_key == pending_itr->bsm_msg_key; });
+            if (bsm_msg_key_count <= 1)
+            {
+                this->pending_bsm_msg_key_m.erase(pending_itr->bsm_msg_key);
+            }
+            vehicle_pending.erase(pending_itr);
+            if (vehicle_pending.empty())
+            {
+                this->pending_mo_m.erase(sender_itr);
+            }
+        }
+
+        void vsi_join_worker::schedule_expiry(std::time_t timestamp, expiry_kind kind, const models::msg_key_t &key, const std::string &sender_id)
+        {
+            if (!this->expiry_q.empty() && timestamp < this->expiry_q.back().timestamp)
+            {
+                timestamp = this->expiry_q.back().timestamp;
+            }
+            this->expiry_q.push_back({timestamp, kind, key, sender_id});
+        }
+
+        size_t vsi_join_worker::expire(std::time_t cur_timestamp)
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            return expire_locked(cur_timestamp);
+        }
+
+        size_t vsi_join_worker::expire_locked(std::time_t cur_timestamp)
+        {
+            size_t removed = 0;
+            while (!this->expiry_q.empty() && cur_timestamp - this->expiry_q.front().timestamp > this->join_window_milli_sec)
+            {
+                const expiry_entry_t &entry = this->expiry_q.front();
+                // Skip entries of messages already joined, or replaced by a newer message with the same key
+                if (entry.kind == expiry_kind::bsm)
+                {
+                    const models::bsm *bsm = this->bsm_m.find(entry.key);
+                    if (bsm != nullptr && bsm->msg_received_timestamp_ <= entry.timestamp)
+                    {
+                        this->bsm_m.erase(entry.key);
+                        removed++;
+                    }
+                }
+                else if (entry.kind == expiry_kind::mobilitypath)
+                {
+                    const models::mobilitypath *mp = this->mp_m.find(entry.key);
+                    if (mp != nullptr && mp->msg_received_timestamp_ <= entry.timestamp)
+                    {
+                        this->mp_m.erase(entry.key);
+                        removed++;
+                    }
+                }
+                else
+                {
+                    // Pending MobilityOperation messages of a vehicle are in arrival order
+                    auto sender_itr = this->pending_mo_m.find(entry.sender_id);
+                    bool is_sender_erased = sender_itr == this->pending_mo_m.end();
+                    while (!is_sender_erased && sender_itr->second.front().mo.msg_received_timestamp_ <= entry.timestamp)
+                    {
+                        is_sender_erased = sender_itr->second.size() == 1;
+                        erase_pending(sender_itr, sender_itr->second.begin());
+                        removed++;
+                    }
+                }
+                this->expiry_q.pop_front();
+            }
+
+            if (removed > 0)
+            {
+                SPDLOG_DEBUG("Expired {0} messages from the join window", removed);
+            }
+            return removed;
+        }
+
+        size_t vsi_join_worker::get_bsm_count()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            return this->bsm_m.size();
+        }
+
+        size_t vsi_join_worker::get_mobilitypath_count()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            return this->mp_m.size();
+        }
+
+        size_t vsi_join_worker::get_pending_mobilityoperation_count()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            size_t count = 0;
+            for (const auto &sender_pending : this->pending_mo_m)
+            {
+                count += sender_pending.second.size();
+            }
+            return count;
+        }
+    }
+}
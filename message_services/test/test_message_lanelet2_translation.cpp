@@ -1,4 +1,7 @@
 #include <rapidjson/document.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 
 #include "gtest/gtest.h"
 #include "message_lanelet2_translation.h"
@@ -63,6 +66,39 @@ TEST(test_message_lanelet2_translation, get_cur_lanelet_id_by_point_and_directio
     ASSERT_EQ(12459, clt.get_cur_lanelet_by_point_and_direction(basic_point3d, "", trajectory).id());
 }
 
+TEST(test_message_lanelet2_translation, get_cur_lanelet_by_vehicle_and_direction)
+{
+    message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
+    message_services::models::trajectory trajectory;
+    message_services::message_translations::vehicle_lanelet_track_t track;
+
+    //Position within the entry lanelet starts the vehicle track
+    lanelet::BasicPoint3d basic_point3d = lanelet::Point3d(lanelet::utils::getId(), {-89.162, 316.702, 72}).basicPoint();
+    ASSERT_EQ(19252, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45244", basic_point3d, "NA", trajectory).id());
+    ASSERT_TRUE(clt.get_vehicle_lanelet_track("DOT-45244", track));
+    ASSERT_EQ(19252, track.lanelet_id);
+
+    //Position within the link lanelet with proper turn direction is found in the entry lanelet successors
+    basic_point3d = lanelet::Point3d(lanelet::utils::getId(), {-87.9078, 320.47, 72}).basicPoint();
+    ASSERT_EQ(22414, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45244", basic_point3d, "right", trajectory).id());
+
+    //The tracked link lanelet is kept without turn direction
+    ASSERT_EQ(22414, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45244", basic_point3d, "NA", trajectory).id());
+
+    //The tracked link lanelet is not kept once the turn direction changes
+    ASSERT_NE(22414, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45244", basic_point3d, "left", trajectory).id());
+
+    //Vehicle without track cannot determine the link lanelet without turn direction
+    ASSERT_EQ(0, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45245", basic_point3d, "NA", trajectory).id());
+    ASSERT_FALSE(clt.get_vehicle_lanelet_track("DOT-45245", track));
+
+    //Position within the departure lanelet
+    basic_point3d = lanelet::Point3d(lanelet::utils::getId(), {-66.3387, 327.636, 72}).basicPoint();
+    ASSERT_EQ(12459, clt.get_cur_lanelet_by_vehicle_and_direction("DOT-45244", basic_point3d, "NA", trajectory).id());
+    ASSERT_TRUE(clt.get_vehicle_lanelet_track("DOT-45244", track));
+    ASSERT_EQ(12459, track.lanelet_id);
+}
+
 TEST(test_message_lanelet2_translation, get_cur_lanelets_by_point)
 {
     message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
@@ -85,6 +121,60 @@ TEST(test_message_lanelet2_translation, get_cur_lanelets_by_point)
     ASSERT_EQ(12459, clt.get_cur_lanelets_by_point(basic_point3d).front().id());
 }
 
+/**
+ * @brief The lanelet grid finds the same lanelets as the nearest lanelets search in the map R-tree for the centerline segment midpoints
+ * of the sample map. The R-tree search returns at most three of them.
+ */
+TEST(test_message_lanelet2_translation, get_cur_lanelets_by_point_matches_rtree)
+{
+    const std::string map_file = "../../sample_map/town01_vector_map_test.osm";
+    message_services::message_translations::message_lanelet2_translation clt;
+    ASSERT_TRUE(clt.read_lanelet2_map(map_file));
+
+    // Load the map again with the same projection to sample points in the map frame
+    int projector_type = 1;
+    std::string target_frame;
+    lanelet::ErrorMessages errors;
+    lanelet::io_handlers::AutowareOsmParser::parseMapParams(map_file, &projector_type, &target_frame);
+    lanelet::projection::LocalFrameProjector local_projector(target_frame.c_str());
+    lanelet::LaneletMapPtr map_ptr = lanelet::load(map_file, local_projector, &errors);
+    std::vector<lanelet::BasicPoint3d> points;
+    for (const auto &ll : map_ptr->laneletLayer)
+    {
+        // Midpoints of the centerline segments, the centerline end points are on the lanelet borders
+        lanelet::ConstLineString3d centerline = ll.centerline3d();
+        for (size_t i = 1; i < centerline.size(); i++)
+        {
+            points.push_back((centerline[i - 1].basicPoint() + centerline[i].basicPoint()) / 2);
+        }
+    }
+    ASSERT_FALSE(points.empty());
+
+    auto sorted_ids = [](const std::vector<lanelet::Lanelet> &lanelets)
+    {
+        std::vector<lanelet::Id> ids;
+        for (const auto &ll : lanelets)
+        {
+            ids.push_back(ll.id());
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+    for (const auto &point : points)
+    {
+        std::vector<lanelet::Id> rtree_ids = sorted_ids(clt.find_cur_lanelets_in_rtree(point));
+        std::vector<lanelet::Id> grid_ids = sorted_ids(clt.get_cur_lanelets_by_point(point));
+        if (rtree_ids.size() < 3)
+        {
+            ASSERT_EQ(rtree_ids, grid_ids);
+        }
+        else
+        {
+            ASSERT_TRUE(std::includes(grid_ids.begin(), grid_ids.end(), rtree_ids.begin(), rtree_ids.end()));
+        }
+    }
+}
+
 TEST(test_message_lanelet2_translation, distance2_cur_lanelet_end_point)
 {
     message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
@@ -190,6 +280,76 @@ TEST(test_message_lanelet2_translation, get_lanelet_types_ids)
     ASSERT_EQ(0, clt.get_lanelet_types_ids(lanelet_12459, "NA").size());
 }
 
+TEST(test_message_lanelet2_translation, map_snapshot)
+{
+    const std::string snapshot_file = "../vector_map_test.snapshot";
+    std::remove(snapshot_file.c_str());
+
+    // The first load reads the osm map and writes the snapshot
+    auto start = std::chrono::steady_clock::now();
+    message_services::message_translations::message_lanelet2_translation osm_clt("../vector_map.osm", snapshot_file);
+    double osm_load_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::ifstream snapshot(snapshot_file, std::ios::binary);
+    ASSERT_TRUE(snapshot.good());
+
+    // The second load reads the snapshot, without building the routing graph
+    start = std::chrono::steady_clock::now();
+    message_services::message_translations::message_lanelet2_translation snapshot_clt("../vector_map.osm", snapshot_file);
+    double snapshot_load_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SPDLOG_INFO("Map load from osm {0:.3f} s, from snapshot {1:.3f} s", osm_load_sec, snapshot_load_sec);
+
+    message_services::models::trajectory trajectory;
+    lanelet::BasicPoint3d entry_point(-89.162, 316.702, 72);
+    lanelet::BasicPoint3d link_point(-87.9078, 320.47, 72);
+    lanelet::Lanelet lanelet_19252 = snapshot_clt.get_cur_lanelet_by_point_and_direction(entry_point, "", trajectory);
+    ASSERT_EQ(19252, lanelet_19252.id());
+    ASSERT_EQ(22414, snapshot_clt.get_cur_lanelet_by_point_and_direction(link_point, "right", trajectory).id());
+    ASSERT_EQ(0, snapshot_clt.get_cur_lanelet_by_point_and_direction(link_point, "", trajectory).id());
+    ASSERT_EQ(osm_clt.get_lanelet_types_ids(lanelet_19252, "right"), snapshot_clt.get_lanelet_types_ids(lanelet_19252, "right"));
+    ASSERT_EQ(3, snapshot_clt.get_lanelet_types_ids(lanelet_19252, "right").size());
+    ASSERT_EQ(osm_clt.distance2_cur_lanelet_end(entry_point, lanelet_19252, "", trajectory),
+              snapshot_clt.distance2_cur_lanelet_end(entry_point, lanelet_19252, "", trajectory));
+
+    // A snapshot of another map is rejected, the map is read from the osm file
+    uint64_t source_hash = 0;
+    ASSERT_TRUE(message_services::message_translations::hash_lanelet_map_file("../vector_map.osm", source_hash));
+    std::string target_frame;
+    lanelet::LaneletMapPtr map_ptr;
+    std::unordered_map<lanelet::Id, message_services::message_translations::lanelet_snapshot_roles_t> roles;
+    ASSERT_TRUE(message_services::message_translations::read_lanelet_map_snapshot(snapshot_file, source_hash, target_frame, map_ptr, roles));
+    ASSERT_FALSE(message_services::message_translations::read_lanelet_map_snapshot(snapshot_file, source_hash + 1, target_frame, map_ptr, roles));
+    ASSERT_FALSE(message_services::message_translations::read_lanelet_map_snapshot("../fake_map_path.snapshot", source_hash, target_frame, map_ptr, roles));
+    std::remove(snapshot_file.c_str());
+}
+
+TEST(test_message_lanelet2_translation, get_lanelet_types_ids_entry_without_previous)
+{
+    const std::string snapshot_file = "../vector_map_no_previous_test.snapshot";
+    std::remove(snapshot_file.c_str());
+    // Write the snapshot, then rewrite it with entry lanelet 19252 at the map boundary, without a previous lanelet
+    message_services::message_translations::message_lanelet2_translation osm_clt("../vector_map.osm", snapshot_file);
+    uint64_t source_hash = 0;
+    ASSERT_TRUE(message_services::message_translations::hash_lanelet_map_file("../vector_map.osm", source_hash));
+    std::string target_frame;
+    lanelet::LaneletMapPtr map_ptr;
+    std::unordered_map<lanelet::Id, message_services::message_translations::lanelet_snapshot_roles_t> roles;
+    ASSERT_TRUE(message_services::message_translations::read_lanelet_map_snapshot(snapshot_file, source_hash, target_frame, map_ptr, roles));
+    ASSERT_NE(roles.end(), roles.find(19252));
+    roles[19252].previous = lanelet::InvalId;
+    ASSERT_TRUE(message_services::message_translations::write_lanelet_map_snapshot(snapshot_file, source_hash, target_frame, *map_ptr, roles));
+
+    message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm", snapshot_file);
+    message_services::models::trajectory trajectory;
+    lanelet::Lanelet lanelet_19252 = clt.get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d(-89.162, 316.702, 72), "", trajectory);
+    ASSERT_EQ(19252, lanelet_19252.id());
+    auto lanelet_types = clt.get_lanelet_types_ids(lanelet_19252, "right");
+    ASSERT_EQ(3, lanelet_types.size());
+    ASSERT_EQ(message_services::models::entry, lanelet_types.at(19252));
+    ASSERT_EQ(message_services::models::link, lanelet_types.at(22414));
+    ASSERT_EQ(message_services::models::departure, lanelet_types.at(12459));
+    std::remove(snapshot_file.c_str());
+}
+
 TEST(test_message_lanelet2_translation, get_route_lanelet_ids)
 {
     message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
@@ -346,6 +506,51 @@ TEST(test_message_lanelet2_translation, ecef_2_map_point)
 }
 
 
+TEST(test_message_lanelet2_translation, trajectory_2_map_points)
+{
+    message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
+    message_services::models::trajectory trajectory;
+    message_services::models::locationOffsetECEF_t offset;
+
+    //From lanelet 19252 to lanelet 12459
+    trajectory.location.ecef_x = 110460730;
+    trajectory.location.ecef_y = -484214174;
+    trajectory.location.ecef_z = 398846417;
+    offset.offset_x = 2073;
+    offset.offset_y = 1178;
+    offset.offset_z = 850;
+    trajectory.offsets.push_back(offset);
+    offset.offset_x = -350;
+    offset.offset_y = 120;
+    offset.offset_z = 40;
+    trajectory.offsets.push_back(offset);
+
+    message_services::message_translations::trajectory_map_points_t points = clt.trajectory_2_map_points(trajectory);
+    ASSERT_EQ(3, points.size());
+    std::int32_t ecef_x = trajectory.location.ecef_x;
+    std::int32_t ecef_y = trajectory.location.ecef_y;
+    std::int32_t ecef_z = trajectory.location.ecef_z;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        if (i > 0)
+        {
+            ecef_x += trajectory.offsets[i - 1].offset_x;
+            ecef_y += trajectory.offsets[i - 1].offset_y;
+            ecef_z += trajectory.offsets[i - 1].offset_z;
+        }
+        lanelet::BasicPoint3d expected = clt.ecef_2_map_point(ecef_x, ecef_y, ecef_z);
+        ASSERT_NEAR(expected.x(), points.at(i).x(), 0.01);
+        ASSERT_NEAR(expected.y(), points.at(i).y(), 0.01);
+        ASSERT_NEAR(expected.z(), points.at(i).z(), 0.01);
+    }
+    ASSERT_NEAR(-66.3387, points.at(1).x(), 0.1);
+    ASSERT_NEAR(327.636, points.at(1).y(), 0.1);
+
+    //Trajectory without offsets only has the location
+    trajectory.offsets.clear();
+    ASSERT_EQ(1, clt.trajectory_2_map_points(trajectory).size());
+}
+
 TEST(test_message_lanelet2_translation, gps_2_map_point)
 {
     message_services::message_translations::message_lanelet2_translation clt("../vector_map.osm");
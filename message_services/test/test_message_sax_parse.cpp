@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "bsm.h"
+#include "mobilityoperation.h"
+#include "mobilitypath.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Read sample messages from the scripts directory. Fails the calling test if any sample is missing so the
+     * comparisons can not pass vacuously.
+     */
+    void read_samples(const std::vector<std::string> &file_names, std::vector<std::string> &samples)
+    {
+        samples.clear();
+        for (const auto &file_name : file_names)
+        {
+            std::ifstream file("../../scripts/" + file_name);
+            ASSERT_TRUE(file.is_open()) << "Sample " << file_name << " not found";
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            samples.push_back(buffer.str());
+        }
+    }
+
+    template <class T>
+    bool parse_dom(const std::string &json_str, T &msg_obj)
+    {
+        rapidjson::Document doc;
+        if (doc.Parse(json_str.c_str(), json_str.size()).HasParseError())
+        {
+            return false;
+        }
+        msg_obj.fromJsonObject(doc);
+        return true;
+    }
+
+    template <class T>
+    bool parse_sax(const std::string &json_str, T &msg_obj)
+    {
+        return msg_obj.fromJson(json_str.data(), json_str.size());
+    }
+}
+
+TEST(test_message_sax_parse, sax_matches_dom)
+{
+    std::vector<std::string> samples;
+    ASSERT_NO_FATAL_FAILURE(read_samples({"bsm.json", "bsm_12_06.json", "bsm_12_8.json"}, samples));
+    for (const auto &sample : samples)
+    {
+        message_services::models::bsm dom_obj, sax_obj;
+        ASSERT_TRUE(parse_dom(sample, dom_obj));
+        ASSERT_TRUE(parse_sax(sample, sax_obj));
+        auto dom_core_data = dom_obj.getCore_data();
+        auto sax_core_data = sax_obj.getCore_data();
+        ASSERT_EQ(dom_core_data.temprary_id, sax_core_data.temprary_id);
+        ASSERT_EQ(dom_core_data.msg_count, sax_core_data.msg_count);
+        ASSERT_EQ(dom_core_data.sec_mark, sax_core_data.sec_mark);
+        ASSERT_EQ(dom_core_data.latitude, sax_core_data.latitude);
+        ASSERT_EQ(dom_core_data.longitude, sax_core_data.longitude);
+        ASSERT_EQ(dom_core_data.speed, sax_core_data.speed);
+        ASSERT_EQ(dom_core_data.heading, sax_core_data.heading);
+        ASSERT_EQ(dom_core_data.size.length, sax_core_data.size.length);
+        ASSERT_EQ(dom_core_data.size.width, sax_core_data.size.width);
+        ASSERT_EQ(dom_core_data.accelSet.Long, sax_core_data.accelSet.Long);
+        ASSERT_EQ(dom_core_data.brakes.brakeBoost, sax_core_data.brakes.brakeBoost);
+    }
+    ASSERT_NO_FATAL_FAILURE(read_samples({"mobilityoperation.json", "mobilityoperation_12_06.json", "mobilityoperation_12_8.json"}, samples));
+    for (const auto &sample : samples)
+    {
+        message_services::models::mobilityoperation dom_obj, sax_obj;
+        ASSERT_TRUE(parse_dom(sample, dom_obj));
+        ASSERT_TRUE(parse_sax(sample, sax_obj));
+        ASSERT_EQ(dom_obj.getHeader().sender_id, sax_obj.getHeader().sender_id);
+        ASSERT_EQ(dom_obj.getHeader().sender_bsm_id, sax_obj.getHeader().sender_bsm_id);
+        ASSERT_EQ(dom_obj.getHeader().plan_id, sax_obj.getHeader().plan_id);
+        ASSERT_EQ(dom_obj.getHeader().timestamp, sax_obj.getHeader().timestamp);
+        ASSERT_EQ(dom_obj.getStrategy(), sax_obj.getStrategy());
+        ASSERT_EQ(dom_obj.getStrategy_params(), sax_obj.getStrategy_params());
+    }
+    ASSERT_NO_FATAL_FAILURE(read_samples({"mobilitypath.json", "mobilitypath_12_02.json", "mobilitypath_12_06.json", "mobilitypath_12_8.json"}, samples));
+    for (const auto &sample : samples)
+    {
+        message_services::models::mobilitypath dom_obj, sax_obj;
+        ASSERT_TRUE(parse_dom(sample, dom_obj));
+        ASSERT_TRUE(parse_sax(sample, sax_obj));
+        ASSERT_EQ(dom_obj.getHeader().sender_id, sax_obj.getHeader().sender_id);
+        ASSERT_EQ(dom_obj.getHeader().timestamp, sax_obj.getHeader().timestamp);
+        ASSERT_EQ(dom_obj.getTrajectory().location.ecef_x, sax_obj.getTrajectory().location.ecef_x);
+        ASSERT_EQ(dom_obj.getTrajectory().location.ecef_z, sax_obj.getTrajectory().location.ecef_z);
+        ASSERT_EQ(dom_obj.getTrajectory().offsets.size(), sax_obj.getTrajectory().offsets.size());
+        for (size_t i = 0; i < sax_obj.getTrajectory().offsets.size(); i++)
+        {
+            ASSERT_EQ(dom_obj.getTrajectory().offsets[i].offset_x, sax_obj.getTrajectory().offsets[i].offset_x);
+            ASSERT_EQ(dom_obj.getTrajectory().offsets[i].offset_y, sax_obj.getTrajectory().offsets[i].offset_y);
+        }
+    }
+}
+
+TEST(test_message_sax_parse, sax_rejects_invalid_json)
+{
+    message_services::models::bsm bsm_obj;
+    ASSERT_FALSE(bsm_obj.fromJson(std::string("{\"core_data\": {\"id\": \"bsmid1\",")));
+    ASSERT_FALSE(bsm_obj.fromJson(std::string("{\"core_data\": {\"sec_mark\": \"abc\"}}")));
+    // The payload of a Kafka message is bounded by its length, not NUL terminated
+    std::string payload = "{\"core_data\": {\"id\": \"bsmid1\",\"sec_mark\": \"16323\"}}trailing bytes";
+    ASSERT_TRUE(bsm_obj.fromJson(payload.data(), payload.find("trailing")));
+    ASSERT_EQ("bsmid1", bsm_obj.getCore_data().temprary_id);
+    ASSERT_EQ(16323, bsm_obj.getCore_data().sec_mark);
+}
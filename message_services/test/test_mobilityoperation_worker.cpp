@@ -41,4 +41,28 @@ TEST(test_mobilityoperation_worker, pop_cur_element_from_list)
     ASSERT_EQ("5.000000", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("min_gap"));
     ASSERT_EQ("9999", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("depart_pos"));
     ASSERT_EQ("straight", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("turn_direction"));
-}
\ No newline at end of file
+}
+
+TEST(test_mobilityoperation_worker, parsed_strategy_params)
+{
+    message_services::models::mobilityoperation mo_obj;
+    mo_obj.setStrategy_params("msg_count: 12,access: 0, max_accel: 1.500000, max_decel:-1.000000,react_time: 4.500000, min_gap: 5.000000, depart_pos: 9999,turn_direction:straight , sec_mark:abc");
+    const auto &params = mo_obj.getParsed_strategy_params();
+    ASSERT_EQ(12, params.msg_count);
+    ASSERT_EQ(0, params.access);
+    ASSERT_EQ(1.5, params.max_accel);
+    ASSERT_EQ(-1.0, params.max_decel);
+    ASSERT_EQ(4.5, params.react_time);
+    ASSERT_EQ(5.0, params.min_gap);
+    ASSERT_EQ(9999, params.depart_pos);
+    ASSERT_EQ("straight", params.turn_direction);
+    ASSERT_TRUE(params.has(message_services::models::msg_count_param | message_services::models::depart_pos_param | message_services::models::turn_direction_param));
+    // Values that std::stol rejects are not marked as parsed
+    ASSERT_FALSE(params.has(message_services::models::sec_mark_param));
+
+    std::string mo_json_str = "{\"metadata\": {\"timestamp\" : \"1632679658\",\"hostStaticId\": \"DOT-508\"}, \"strategy_params\": \"msg_count: 7, sec_mark: 16323\"}";
+    ASSERT_TRUE(mo_obj.fromJson(mo_json_str));
+    ASSERT_EQ(7, mo_obj.getParsed_strategy_params().msg_count);
+    ASSERT_EQ(16323, mo_obj.getParsed_strategy_params().sec_mark);
+    ASSERT_FALSE(mo_obj.getParsed_strategy_params().has(message_services::models::depart_pos_param));
+}
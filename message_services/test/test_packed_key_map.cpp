@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "packed_key_map.h"
+
+#include <map>
+#include <random>
+
+TEST(test_packed_key_map, pack_msg_id)
+{
+    ASSERT_EQ(message_services::models::pack_msg_id("bsmid1"), message_services::models::pack_msg_id("bsmid1"));
+    ASSERT_NE(message_services::models::pack_msg_id("bsmid1"), message_services::models::pack_msg_id("bsmid2"));
+    ASSERT_NE(message_services::models::pack_msg_id("bsmid1"), message_services::models::pack_msg_id("bsmid1 "));
+    // Ids longer than 8 bytes are hashed and never equal a packed short id
+    ASSERT_NE(message_services::models::pack_msg_id("vehicle_id_01"), message_services::models::pack_msg_id("vehicle_id_02"));
+    ASSERT_NE(0U, message_services::models::pack_msg_id("vehicle_id_01") >> 63);
+
+    // The BSM key of (id, msg_count, sec_mark) must not collide with a shifted combination of the same digits
+    ASSERT_NE(message_services::models::generate_bsm_msg_key("bsmid1", 12, 16323), message_services::models::generate_bsm_msg_key("bsmid1", 1, 216323));
+    ASSERT_EQ(message_services::models::generate_sender_timestamp_key("DOT-507", 1632679), message_services::models::generate_sender_timestamp_key("DOT-507", 1632679));
+}
+
+TEST(test_packed_key_map, insert_find_erase)
+{
+    message_services::workers::packed_key_map<std::string> key_map(8);
+    auto key_1 = message_services::models::generate_bsm_msg_key("bsmid1", 12, 16323);
+    auto key_2 = message_services::models::generate_bsm_msg_key("bsmid2", 13, 16323);
+    ASSERT_TRUE(key_map.empty());
+    ASSERT_EQ(nullptr, key_map.find(key_1));
+
+    key_map.insert_or_assign(key_1, "first");
+    key_map.insert_or_assign(key_2, "second");
+    ASSERT_EQ(2, key_map.size());
+    ASSERT_EQ("first", *key_map.find(key_1));
+    ASSERT_EQ("second", *key_map.find(key_2));
+
+    key_map.insert_or_assign(key_1, "replaced");
+    ASSERT_EQ(2, key_map.size());
+    ASSERT_EQ("replaced", *key_map.find(key_1));
+
+    ASSERT_TRUE(key_map.erase(key_1));
+    ASSERT_FALSE(key_map.erase(key_1));
+    ASSERT_EQ(nullptr, key_map.find(key_1));
+    ASSERT_EQ("second", *key_map.find(key_2));
+    ASSERT_EQ(1, key_map.size());
+}
+
+TEST(test_packed_key_map, matches_std_map)
+{
+    // Random inserts and erases on a small key space create long probe clusters and wrap around the end of the table
+    message_services::workers::packed_key_map<int> key_map(8);
+    std::map<std::pair<uint64_t, uint64_t>, int> reference_map;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> key_distribution(0, 300);
+    for (int i = 0; i < 20000; i++)
+    {
+        auto key = message_services::models::generate_sender_timestamp_key("DOT-507", key_distribution(generator));
+        std::pair<uint64_t, uint64_t> reference_key = {key.id, key.value};
+        if (generator() % 3 == 0)
+        {
+            ASSERT_EQ(reference_map.erase(reference_key) == 1, key_map.erase(key));
+        }
+        else
+        {
+            key_map.insert_or_assign(key, i);
+            reference_map[reference_key] = i;
+        }
+        ASSERT_EQ(reference_map.size(), key_map.size());
+    }
+    for (const auto &entry : reference_map)
+    {
+        message_services::models::msg_key_t key;
+        key.id = entry.first.first;
+        key.value = entry.first.second;
+        ASSERT_NE(nullptr, key_map.find(key));
+        ASSERT_EQ(entry.second, *key_map.find(key));
+    }
+
+    size_t removed = key_map.erase_if([](const message_services::models::msg_key_t &key, int)
+                                      { return key.value % 2 == 0; });
+    size_t expected_removed = 0;
+    for (auto itr = reference_map.begin(); itr != reference_map.end();)
+    {
+        if (itr->first.second % 2 == 0)
+        {
+            itr = reference_map.erase(itr);
+            expected_removed++;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+    ASSERT_EQ(expected_removed, removed);
+    ASSERT_EQ(reference_map.size(), key_map.size());
+    for (const auto &entry : reference_map)
+    {
+        message_services::models::msg_key_t key;
+        key.id = entry.first.first;
+        key.value = entry.first.second;
+        ASSERT_NE(nullptr, key_map.find(key));
+    }
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "vsi_composition_pool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(test_vsi_composition_pool, compose_in_order_per_vehicle)
+{
+    const int vehicle_count = 16;
+    const int message_count = 200;
+    std::mutex composed_mtx;
+    std::map<std::string, std::vector<uint64_t>> composed_m;
+    std::map<std::string, std::set<std::thread::id>> composed_threads_m;
+    message_services::workers::vsi_composition_pool pool(4, 8, [&composed_mtx, &composed_m, &composed_threads_m](message_services::workers::vsi_message_bucket_t &joined)
+                                                         {
+                                                             std::unique_lock<std::mutex> lck(composed_mtx);
+                                                             composed_m[joined.mo.getHeader().sender_id].push_back(joined.mo.getHeader().timestamp);
+                                                             composed_threads_m[joined.mo.getHeader().sender_id].insert(std::this_thread::get_id()); });
+    ASSERT_EQ(4, pool.worker_count());
+
+    message_services::workers::vsi_message_bucket_t joined;
+    ASSERT_FALSE(pool.submit(std::move(joined)));
+
+    pool.start();
+    for (int i = 0; i < message_count; i++)
+    {
+        for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+        {
+            message_services::models::mobility_header_t header;
+            header.sender_id = "DOT-" + std::to_string(vehicle);
+            header.timestamp = i;
+            message_services::workers::vsi_message_bucket_t vehicle_joined;
+            vehicle_joined.mo.setHeader(header);
+            ASSERT_TRUE(pool.submit(std::move(vehicle_joined)));
+        }
+    }
+    pool.stop();
+
+    ASSERT_EQ(vehicle_count, composed_m.size());
+    for (const auto &composed : composed_m)
+    {
+        ASSERT_EQ(message_count, composed.second.size());
+        for (int i = 0; i < message_count; i++)
+        {
+            ASSERT_EQ(i, composed.second[i]);
+        }
+    }
+
+    // All messages of a vehicle are composed on one worker thread, shared by the vehicles of the same worker index
+    std::map<size_t, std::thread::id> worker_threads_m;
+    for (const auto &composed_threads : composed_threads_m)
+    {
+        ASSERT_EQ(1, composed_threads.second.size());
+        auto worker_thread = worker_threads_m.emplace(pool.worker_index(composed_threads.first), *composed_threads.second.begin()).first;
+        ASSERT_EQ(worker_thread->second, *composed_threads.second.begin());
+    }
+    for (const auto &worker_thread : worker_threads_m)
+    {
+        for (const auto &other_worker_thread : worker_threads_m)
+        {
+            ASSERT_EQ(worker_thread.first == other_worker_thread.first, worker_thread.second == other_worker_thread.second);
+        }
+    }
+}
+
+TEST(test_vsi_composition_pool, idle_worker_wakes_on_submit)
+{
+    std::mutex composed_mtx;
+    std::condition_variable composed_cv;
+    int composed_count = 0;
+    message_services::workers::vsi_composition_pool pool(1, 8, [&composed_mtx, &composed_cv, &composed_count](message_services::workers::vsi_message_bucket_t &)
+                                                         {
+                                                             std::unique_lock<std::mutex> lck(composed_mtx);
+                                                             composed_count++;
+                                                             composed_cv.notify_all(); });
+    pool.start();
+    // Let the worker exhaust its spins and block on the empty queue
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    message_services::models::mobility_header_t header;
+    header.sender_id = "DOT-0";
+    message_services::workers::vsi_message_bucket_t joined;
+    joined.mo.setHeader(header);
+    ASSERT_TRUE(pool.submit(std::move(joined)));
+    {
+        std::unique_lock<std::mutex> lck(composed_mtx);
+        ASSERT_TRUE(composed_cv.wait_for(lck, std::chrono::seconds(5), [&composed_count]()
+                                         { return composed_count == 1; }));
+    }
+    pool.stop();
+}
@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include "vsi_join_worker.h"
+
+#include <map>
+
+namespace
+{
+    const std::string bsm_json_str = "{\"core_data\": {\"id\": \"bsmid1\", \"lat\":\"38.956287\",\"long\" :\"-77.150492\",\"elev\" :\"72\",\"sec_mark\": \"16323\",\"msg_count\": \"12\", \"speed\": \"13\" ,\"size\": { \"length\": \"12\"}}}";
+    const std::string mp_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}, \"trajectory\": { \"location\": {\"ecefX\": 122, \"ecef_y\": 1,\"ecefZ\": 0}}}";
+    const std::string mo_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}, \"strategy\": \"Carma/signalized_intersection\",\"strategy_params\": \"msg_count: 12, sec_mark: 16323, access: 0, max_accel: 1.500000, max_decel:-1.000000,react_time: 4.500000, min_gap: 5.000000, depart_pos: 9999,turn_direction:straight\"}";
+
+    template <class T>
+    T parse(const std::string &json_str, std::time_t received_timestamp)
+    {
+        T msg_obj;
+        msg_obj.fromJson(json_str);
+        msg_obj.msg_received_timestamp_ = received_timestamp;
+        return msg_obj;
+    }
+}
+
+TEST(test_vsi_join_worker, join_in_any_arrival_order)
+{
+    std::vector<std::vector<int>> arrival_orders = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (const auto &arrival_order : arrival_orders)
+    {
+        message_services::workers::vsi_join_worker join_w_obj;
+        message_services::workers::vsi_message_bucket_t joined;
+        std::time_t timestamp = 1000000;
+        int joined_count = 0;
+        for (size_t i = 0; i < arrival_order.size(); i++)
+        {
+            bool is_joined = false;
+            switch (arrival_order[i])
+            {
+            case 0:
+                is_joined = join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, timestamp), joined);
+                break;
+            case 1:
+                is_joined = join_w_obj.process_mobilitypath(parse<message_services::models::mobilitypath>(mp_json_str, timestamp), joined);
+                break;
+            default:
+                is_joined = join_w_obj.process_mobilityoperation(parse<message_services::models::mobilityoperation>(mo_json_str, timestamp), joined);
+                break;
+            }
+            // Only the last of the three matching messages completes the join
+            ASSERT_EQ(i == arrival_order.size() - 1, is_joined);
+            joined_count += is_joined ? 1 : 0;
+        }
+        ASSERT_EQ(1, joined_count);
+        ASSERT_EQ("bsmid1", joined.bsm.getCore_data().temprary_id);
+        ASSERT_EQ("DOT-507", joined.mp.getHeader().sender_id);
+        ASSERT_EQ("straight", joined.mo.get_value_from_strategy_params("turn_direction"));
+        ASSERT_EQ(0, join_w_obj.get_bsm_count());
+        ASSERT_EQ(0, join_w_obj.get_mobilitypath_count());
+        ASSERT_EQ(0, join_w_obj.get_pending_mobilityoperation_count());
+    }
+}
+
+TEST(test_vsi_join_worker, no_join_outside_window)
+{
+    message_services::workers::vsi_join_worker join_w_obj(1000);
+    message_services::workers::vsi_message_bucket_t joined;
+    ASSERT_FALSE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1000000), joined));
+    ASSERT_FALSE(join_w_obj.process_mobilitypath(parse<message_services::models::mobilitypath>(mp_json_str, 1000500), joined));
+    // BSM is older than the join window when the MobilityOperation arrives
+    ASSERT_FALSE(join_w_obj.process_mobilityoperation(parse<message_services::models::mobilityoperation>(mo_json_str, 1001500), joined));
+    ASSERT_EQ(0, join_w_obj.get_bsm_count());
+    ASSERT_EQ(1, join_w_obj.get_pending_mobilityoperation_count());
+
+    ASSERT_EQ(2, join_w_obj.expire(1003000));
+    ASSERT_EQ(0, join_w_obj.get_mobilitypath_count());
+    ASSERT_EQ(0, join_w_obj.get_pending_mobilityoperation_count());
+}
+
+TEST(test_vsi_join_worker, bounded_pending_per_vehicle)
+{
+    message_services::workers::vsi_join_worker join_w_obj(1000, 3);
+    message_services::workers::vsi_message_bucket_t joined;
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_FALSE(join_w_obj.process_mobilityoperation(parse<message_services::models::mobilityoperation>(mo_json_str, 1000000 + i), joined));
+    }
+    ASSERT_EQ(3, join_w_obj.get_pending_mobilityoperation_count());
+
+    // Each BSM and MobilityPath pair completes one of the pending MobilityOperation messages
+    ASSERT_FALSE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1000100), joined));
+    ASSERT_TRUE(join_w_obj.process_mobilitypath(parse<message_services::models::mobilitypath>(mp_json_str, 1000100), joined));
+    ASSERT_EQ(2, join_w_obj.get_pending_mobilityoperation_count());
+    ASSERT_FALSE(join_w_obj.process_mobilitypath(parse<message_services::models::mobilitypath>(mp_json_str, 1000200), joined));
+    ASSERT_TRUE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1000200), joined));
+    ASSERT_EQ(1, join_w_obj.get_pending_mobilityoperation_count());
+}
+
+TEST(test_vsi_join_worker, missing_strategy_params)
+{
+    message_services::workers::vsi_join_worker join_w_obj;
+    message_services::workers::vsi_message_bucket_t joined;
+    std::string mo_no_params_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}}";
+    ASSERT_FALSE(join_w_obj.process_mobilityoperation(parse<message_services::models::mobilityoperation>(mo_no_params_json_str, 1000000), joined));
+    ASSERT_EQ(0, join_w_obj.get_pending_mobilityoperation_count());
+}
+
+TEST(test_vsi_join_worker, expire_skips_replaced_messages)
+{
+    message_services::workers::vsi_join_worker join_w_obj(1000);
+    message_services::workers::vsi_message_bucket_t joined;
+    ASSERT_FALSE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1000000), joined));
+    // Same BSM key received again replaces the stored BSM, which must outlive the expiry of the first one
+    ASSERT_FALSE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1000800), joined));
+    ASSERT_EQ(1, join_w_obj.get_bsm_count());
+    ASSERT_EQ(0, join_w_obj.expire(1001100));
+    ASSERT_EQ(1, join_w_obj.get_bsm_count());
+    ASSERT_EQ(1, join_w_obj.expire(1001900));
+    ASSERT_EQ(0, join_w_obj.get_bsm_count());
+
+    // Joined messages are not expired again
+    ASSERT_FALSE(join_w_obj.process_bsm(parse<message_services::models::bsm>(bsm_json_str, 1002000), joined));
+    ASSERT_FALSE(join_w_obj.process_mobilitypath(parse<message_services::models::mobilitypath>(mp_json_str, 1002000), joined));
+    ASSERT_TRUE(join_w_obj.process_mobilityoperation(parse<message_services::models::mobilityoperation>(mo_json_str, 1002000), joined));
+    ASSERT_EQ(0, join_w_obj.expire(1004000));
+}
+
+/**
+ * @brief The BSM and MobilityPath keys built on arrival match the keys built from the MobilityOperation of the same round, for string
+ * keys in std::map and packed keys in packed_key_map, while the maps hold the messages of other rounds and vehicles.
+ */
+TEST(test_vsi_join_worker, join_keys_across_rounds)
+{
+    const int vehicle_count = 3;
+    const int round_count = 5;
+    message_services::models::bsm bsm_obj;
+    message_services::models::mobilityoperation mo_obj;
+    std::map<std::string, int> bsm_string_m;
+    std::map<std::string, int> mp_string_m;
+    message_services::workers::packed_key_map<int> bsm_packed_m;
+    message_services::workers::packed_key_map<int> mp_packed_m;
+    int string_joined = 0;
+    int packed_joined = 0;
+    for (int round = 0; round < round_count; round++)
+    {
+        long msg_count = round % 128;
+        long sec_mark = (round * 100) % 60000;
+        uint64_t timestamp_bucket = 1632679657 + round;
+        for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+        {
+            std::string temporary_id = "bsm" + std::to_string(10000 + vehicle);
+            std::string sender_id = "DOT-" + std::to_string(10000 + vehicle);
+            bsm_string_m[bsm_obj.generate_hash_bsm_msg_id(temporary_id, msg_count, sec_mark)] = round;
+            mp_string_m[mo_obj.generate_hash_sender_timestamp_id(sender_id, timestamp_bucket)] = round;
+            bsm_packed_m.insert_or_assign(message_services::models::generate_bsm_msg_key(temporary_id, msg_count, sec_mark), round);
+            mp_packed_m.insert_or_assign(message_services::models::generate_sender_timestamp_key(sender_id, timestamp_bucket), round);
+        }
+    }
+    for (int round = 0; round < round_count; round++)
+    {
+        long msg_count = round % 128;
+        long sec_mark = (round * 100) % 60000;
+        uint64_t timestamp_bucket = 1632679657 + round;
+        for (int vehicle = 0; vehicle < vehicle_count; vehicle++)
+        {
+            std::string temporary_id = "bsm" + std::to_string(10000 + vehicle);
+            std::string sender_id = "DOT-" + std::to_string(10000 + vehicle);
+            auto bsm_itr = bsm_string_m.find(mo_obj.generate_hash_bsm_msg_id(temporary_id, msg_count, sec_mark));
+            auto mp_itr = mp_string_m.find(mo_obj.generate_hash_sender_timestamp_id(sender_id, timestamp_bucket));
+            if (bsm_itr != bsm_string_m.end() && mp_itr != mp_string_m.end() && bsm_itr->second == round && mp_itr->second == round)
+            {
+                string_joined++;
+            }
+            const int *bsm_round = bsm_packed_m.find(message_services::models::generate_bsm_msg_key(temporary_id, msg_count, sec_mark));
+            const int *mp_round = mp_packed_m.find(message_services::models::generate_sender_timestamp_key(sender_id, timestamp_bucket));
+            if (bsm_round != nullptr && mp_round != nullptr && *bsm_round == round && *mp_round == round)
+            {
+                packed_joined++;
+            }
+        }
+    }
+    ASSERT_EQ(vehicle_count * round_count, string_joined);
+    ASSERT_EQ(vehicle_count * round_count, packed_joined);
+    ASSERT_EQ(static_cast<size_t>(vehicle_count * round_count), bsm_packed_m.size());
+}
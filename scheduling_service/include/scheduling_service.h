@@ -9,6 +9,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <mutex>
 
 #include "intersection_client_api_lib/OAIHelpers.h"
 #include "intersection_client_api_lib/OAIDefaultApi.h"
@@ -37,11 +38,19 @@ namespace scheduling_service{
         std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler_ptr;
         std::shared_ptr<signal_phase_and_timing::spat> spat_ptr;
 
-        std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer_worker;
-        std::shared_ptr<kafka_clients::kafka_consumer_worker> spat_consumer_worker;
-        std::shared_ptr<kafka_clients::kafka_producer_worker> producer_worker;
+        // Consumer subscribed to the status and intent topic and, for signalized intersections, the spat topic
+        std::shared_ptr<kafka_clients::consumer_transport> consumer_worker;
+        std::shared_ptr<kafka_clients::producer_transport> producer_worker;
         std::shared_ptr<scheduling_worker> _scheduling_worker;
 
+        // Maximum number of messages drained from kafka per consumer poll
+        static constexpr size_t CONSUMER_BATCH_SIZE = 64;
+
+        // Pipeline trace of the latest status and intent update, continued by the next schedule
+        mutable std::mutex latest_trace_mtx;
+        mutable kafka_clients::trace_context latest_trace;
+        mutable bool has_latest_trace = false;
+
     public:
 
         
@@ -63,7 +72,7 @@ namespace scheduling_service{
 
         /**
          * @brief Create 2 threads:
-         * The first thread consumes status and intent message and updates the vehicle list.
+         * The first thread consumes status and intent (and spat) messages and updates the vehicle list (and spat).
          * The second thread schedule vehicles and produce the schedule plan.
          */
         void start();
@@ -80,14 +89,22 @@ namespace scheduling_service{
         bool config_scheduler(std::shared_ptr<OpenAPI::OAIIntersection_info> intersection_info_ptr);
 
         /**
-         * @brief Consume the status and intent messages via kafka consumer.
+         * @brief Consume the status and intent and the modified spat messages via kafka consumer and dispatch
+         * them by topic.
          */
         void consume_msg() const;
 
         /**
-         * @brief Consume the modified spat via kafka consumer.
+         * @brief Update the vehicle list with a status and intent message.
+         * @param msg consumed status and intent message.
+         */
+        void process_status_intent(const kafka_clients::kafka_message &msg) const;
+
+        /**
+         * @brief Update the spat with a modified spat message.
+         * @param msg consumed spat message.
          */
-        void consume_spat() const;
+        void process_spat(const kafka_clients::kafka_message &msg) const;
 
         /**
          * @brief Schedule vehicles and produce the schedule plan.
@@ -125,21 +142,14 @@ namespace scheduling_service{
          * 
          * @param worker 
          */
-        void set_consumer_worker( std::shared_ptr<kafka_clients::kafka_consumer_worker> worker );
+        void set_consumer_worker( std::shared_ptr<kafka_clients::consumer_transport> worker );
 
         /**
          * @brief Set the producer worker object for unit testing
          * 
          * @param worker 
          */
-        void set_producer_worker( std::shared_ptr<kafka_clients::kafka_producer_worker> worker );
-
-        /**
-         * @brief Set the spat consumer worker object for unit testing
-         * 
-         * @param worker 
-         */
-        void set_spat_consumer_worker( std::shared_ptr<kafka_clients::kafka_consumer_worker> worker );
+        void set_producer_worker( std::shared_ptr<kafka_clients::producer_transport> worker );
     };
 
 }
@@ -34,6 +34,21 @@ namespace scheduling_service{
          * @return An intersection schedule object that contains vehicles' estimated critical time points.
          */
         std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> schedule_vehicles(std::unordered_map<std::string, streets_vehicles::vehicle> veh_map, std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler) const;
+        /**
+         * @brief Runs the scheduler's schedule_vehicle_changes method to schedule all vehicles tracked by the scheduler after 
+         * applying the vehicle changes since the previous schedule.
+         * @param changes The vehicle changes since the previous schedule.
+         * @param scheduler The scheduler object.
+         * @return An intersection schedule object that contains vehicles' estimated critical time points.
+         */
+        std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> schedule_vehicle_changes(const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler) const;
+
+    private:
+        /**
+         * @brief Create an empty intersection schedule for the configured intersection type, timestamped with the current time.
+         * @return An empty intersection schedule object.
+         */
+        std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> create_intersection_schedule() const;
 
 
     };
@@ -6,15 +6,29 @@ namespace scheduling_service{
     {
         try
         {
-            auto client = std::make_shared<kafka_clients::kafka_client>();
+            auto client = std::make_shared<kafka_clients::kafka_client>(
+                    kafka_clients::parse_transport_type(streets_service::streets_configuration::get_string_config("message_transport")));
             
             this -> bootstrap_server = streets_service::streets_configuration::get_string_config("bootstrap_server");
             this -> group_id = streets_service::streets_configuration::get_string_config("group_id");
             this -> consumer_topic = streets_service::streets_configuration::get_string_config("consumer_topic");
             this -> producer_topic = streets_service::streets_configuration::get_string_config("producer_topic");
 
-            consumer_worker = client->create_consumer(bootstrap_server, consumer_topic, group_id);
-            producer_worker  = client->create_producer(bootstrap_server, producer_topic);
+            auto consumer_properties = kafka_clients::get_consumer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_properties"));
+            auto producer_properties = kafka_clients::get_producer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_producer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_producer_properties"));
+
+            // Status and intent and, for signalized intersections, SPaT are served by a single consumer
+            std::vector<std::string> consumer_topics{consumer_topic};
+            if ( streets_service::streets_configuration::get_string_config("intersection_type").compare("signalized_intersection") == 0 ) {
+                this -> spat_topic = streets_service::streets_configuration::get_string_config("spat_topic");
+                consumer_topics.push_back(spat_topic);
+            }
+            consumer_worker = client->create_consumer_transport(bootstrap_server, consumer_topics, group_id, consumer_properties);
+            producer_worker  = client->create_producer_transport(bootstrap_server, producer_topic, producer_properties);
 
             if(!consumer_worker->init())
             {
@@ -44,27 +58,8 @@ namespace scheduling_service{
                 exit(EXIT_FAILURE);
                 return false;
             }
-            
-            if ( streets_service::streets_configuration::get_string_config("intersection_type").compare("signalized_intersection") == 0 ) {
-                this -> spat_topic = streets_service::streets_configuration::get_string_config("spat_topic");
-                spat_consumer_worker = client->create_consumer(bootstrap_server, spat_topic, group_id);
-                if(!spat_consumer_worker->init())
-                {
-                    SPDLOG_CRITICAL("kafka consumer initialize error");
-                    exit(EXIT_FAILURE);
-                    return false;
-                }
-                else
-                {
-                    spat_consumer_worker->subscribe();
-                    if(!spat_consumer_worker->is_running())
-                    {
-                        SPDLOG_CRITICAL("spat_consumer_worker is not running");
-                        exit(EXIT_FAILURE);
-                        return false;
-                    }
-                }
-            }
+
+            kafka_clients::pipeline_trace_metrics::instance().set_log_interval_ms(streets_service::streets_configuration::get_int_config("pipeline_trace_log_interval"));
 
             config_vehicle_list();
 
@@ -95,11 +90,6 @@ namespace scheduling_service{
     {
         std::thread consumer_thread(&scheduling_service::consume_msg, this );
         std::thread scheduling_thread(&scheduling_service::schedule_veh, this);
-        
-        if ( streets_service::streets_configuration::get_string_config("intersection_type").compare("signalized_intersection") == 0 ) {
-            std::thread spat_consumer_thread(&scheduling_service::consume_spat, this );
-            spat_consumer_thread.join();
-        }
 
         consumer_thread.join();
         scheduling_thread.join();
@@ -160,6 +150,7 @@ namespace scheduling_service{
             processor->set_spat(spat_ptr);
             processor->set_initial_green_buffer(streets_service::streets_configuration::get_int_config("initial_green_buffer"));
             processor->set_final_green_buffer(streets_service::streets_configuration::get_int_config("final_green_buffer"));
+            processor->set_ev_scheduling_threads(streets_service::streets_configuration::get_int_config("ev_scheduling_threads"));
             
             SPDLOG_DEBUG("Signalized scheduler is configured successfully! ");
             return true;
@@ -174,46 +165,52 @@ namespace scheduling_service{
 
     void scheduling_service::consume_msg() const
     {
-        SPDLOG_INFO("Starting status and intent consumer thread.");
-        while (consumer_worker->is_running()) 
+        SPDLOG_INFO("Starting consumer thread.");
+        kafka_clients::kafka_consumer_dispatcher dispatcher(consumer_worker);
+        dispatcher.register_handler(consumer_topic, [this](const kafka_clients::kafka_message &msg)
+                                    { process_status_intent(msg); });
+        if (!spat_topic.empty())
         {
-            
-            const std::string payload = consumer_worker->consume(1000);
-            try {
-            if(payload.length() != 0 && vehicle_list_ptr)
-            {                
-
-                vehicle_list_ptr->process_update(payload);
-    
-            }}
-            catch(const streets_vehicles::status_intent_processing_exception &e) {
-                SPDLOG_ERROR("Exception encounter during update parsing! \n{0}", e.what());
-            }
+            dispatcher.register_handler(spat_topic, [this](const kafka_clients::kafka_message &msg)
+                                        { process_spat(msg); });
         }
-        SPDLOG_WARN("Stopping status and intent consumer thread!");
+        dispatcher.run(CONSUMER_BATCH_SIZE);
+        SPDLOG_WARN("Stopping consumer thread!");
         consumer_worker->stop();
     }
 
 
-    void scheduling_service::consume_spat() const
+    void scheduling_service::process_status_intent(const kafka_clients::kafka_message &msg) const
     {
-        SPDLOG_INFO("Starting spat consumer thread.");
-        while (spat_consumer_worker->is_running()) 
-        {  
-            const std::string spat_msg = spat_consumer_worker->consume(1000);
-            if(spat_msg.length() != 0 && spat_ptr)
-            {                
-                try {
-                    spat_ptr->fromJson(spat_msg);
-                }
-                catch(const signal_phase_and_timing::signal_phase_and_timing_exception &ex) {
-                    SPDLOG_ERROR("Failure in reading the spat message : {0}", ex.what());
-                }
-                    
+        try {
+            if(vehicle_list_ptr)
+            {
+                kafka_clients::trace_context trace = kafka_clients::read_trace_context(msg);
+                trace.mark(kafka_clients::trace_stage::SCHEDULE_INGEST);
+                vehicle_list_ptr->process_update(msg.payload(), msg.length());
+                kafka_clients::pipeline_trace_metrics::instance().record(trace, kafka_clients::trace_stage::SCHEDULE_INGEST, kafka_clients::trace_stage::SCHEDULE_INGEST);
+                std::scoped_lock<std::mutex> lck(latest_trace_mtx);
+                latest_trace = trace;
+                has_latest_trace = true;
+            }
+        }
+        catch(const streets_vehicles::status_intent_processing_exception &e) {
+            SPDLOG_ERROR("Exception encounter during update parsing! \n{0}", e.what());
+        }
+    }
+
+
+    void scheduling_service::process_spat(const kafka_clients::kafka_message &msg) const
+    {
+        if(spat_ptr)
+        {
+            try {
+                spat_ptr->fromJson(msg.to_string());
+            }
+            catch(const signal_phase_and_timing::signal_phase_and_timing_exception &ex) {
+                SPDLOG_ERROR("Failure in reading the spat message : {0}", ex.what());
             }
         }
-        SPDLOG_WARN("Stopping spat consumer thread!");
-        spat_consumer_worker->stop();
     }
 
 
@@ -228,6 +225,8 @@ namespace scheduling_service{
         
         auto scheduling_delta = u_int64_t(streets_service::streets_configuration::get_double_config("scheduling_delta") * 1000);
         int sch_count = 0;
+        // Incremental scheduling drains vehicle changes instead of copying all vehicles every schedule
+        bool incremental_scheduling = streets_service::streets_configuration::get_boolean_config("incremental_scheduling");
         std::unordered_map<std::string, streets_vehicles::vehicle> veh_map;
 
         while (true)
@@ -237,18 +236,50 @@ namespace scheduling_service{
             auto next_schedule_time_epoch = std::chrono::system_clock::now() + std::chrono::milliseconds(scheduling_delta);
 
             
-            veh_map = vehicle_list_ptr -> get_vehicles();
+            // The schedule continues the trace of the latest update it includes
+            kafka_clients::trace_context trace;
+            bool has_trace = false;
+            {
+                std::scoped_lock<std::mutex> lck(latest_trace_mtx);
+                if (has_latest_trace)
+                {
+                    trace = latest_trace;
+                    has_trace = true;
+                    has_latest_trace = false;
+                }
+            }
             try {
-                auto int_schedule = _scheduling_worker->schedule_vehicles(veh_map, scheduler_ptr);
+                std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> int_schedule;
+                bool has_vehicles;
+                if ( incremental_scheduling ) {
+                    int_schedule = _scheduling_worker->schedule_vehicle_changes(vehicle_list_ptr->get_vehicle_changes(), scheduler_ptr);
+                    has_vehicles = !scheduler_ptr->get_tracked_vehicles().empty();
+                }
+                else {
+                    veh_map = vehicle_list_ptr -> get_vehicles();
+                    int_schedule = _scheduling_worker->schedule_vehicles(veh_map, scheduler_ptr);
+                    has_vehicles = !veh_map.empty();
+                }
+                trace.mark(kafka_clients::trace_stage::SCHEDULE);
                 if ( streets_service::streets_configuration::get_boolean_config("enable_schedule_logging") ) {
                     auto logger = spdlog::get("csv_logger");
-                    if ( logger != nullptr && !veh_map.empty() ){
+                    if ( logger != nullptr && has_vehicles ){
                         logger->info( int_schedule->toCSV());
                     }
                 }
                 std::string msg_to_send = int_schedule->toJson();
+                trace.mark(kafka_clients::trace_stage::SCHEDULE_SERIALIZE);
                 /* produce the scheduling plan to kafka */
-                producer_worker->send(msg_to_send);
+                if (has_trace)
+                {
+                    trace.mark(kafka_clients::trace_stage::SCHEDULE_PRODUCE);
+                    producer_worker->send(std::move(msg_to_send), trace);
+                    kafka_clients::pipeline_trace_metrics::instance().record(trace, kafka_clients::trace_stage::SCHEDULE, kafka_clients::trace_stage::SCHEDULE_PRODUCE);
+                }
+                else
+                {
+                    producer_worker->send(std::move(msg_to_send));
+                }
             }
             catch( const streets_vehicle_scheduler::scheduling_exception &e) {
                 SPDLOG_ERROR("Scheduling Exception: {0}",e.what());
@@ -317,16 +348,12 @@ namespace scheduling_service{
         scheduler_ptr = scheduler;
     }
 
-    void scheduling_service::set_consumer_worker(std::shared_ptr<kafka_clients::kafka_consumer_worker> worker) {
+    void scheduling_service::set_consumer_worker(std::shared_ptr<kafka_clients::consumer_transport> worker) {
         consumer_worker = worker;
     }
 
-    void scheduling_service::set_producer_worker(std::shared_ptr<kafka_clients::kafka_producer_worker> worker) {
+    void scheduling_service::set_producer_worker(std::shared_ptr<kafka_clients::producer_transport> worker) {
         producer_worker = worker;
     }
-
-    void scheduling_service::set_spat_consumer_worker(std::shared_ptr<kafka_clients::kafka_consumer_worker> worker) {
-        spat_consumer_worker = worker;
-    }
 }
 
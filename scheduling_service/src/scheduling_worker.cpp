@@ -6,7 +6,20 @@ namespace scheduling_service{
 
     std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> scheduling_worker::schedule_vehicles(std::unordered_map<std::string, streets_vehicles::vehicle> veh_map, std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler) const
     {
+        auto int_schedule = create_intersection_schedule();
+        scheduler->schedule_vehicles(veh_map, int_schedule);
+        return int_schedule;
+    }
 
+    std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> scheduling_worker::schedule_vehicle_changes(const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler) const
+    {
+        auto int_schedule = create_intersection_schedule();
+        scheduler->schedule_vehicle_changes(changes, int_schedule);
+        return int_schedule;
+    }
+
+    std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> scheduling_worker::create_intersection_schedule() const
+    {
         std::shared_ptr<streets_vehicle_scheduler::intersection_schedule> int_schedule;
         if ( streets_service::streets_configuration::get_string_config("intersection_type").compare("stop_controlled_intersection") == 0 ) {
             int_schedule = std::make_shared<streets_vehicle_scheduler::all_stop_intersection_schedule>();
@@ -19,10 +32,6 @@ namespace scheduling_service{
         }
 
         int_schedule->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-        scheduler->schedule_vehicles(veh_map, int_schedule);
-
-        
-
         return int_schedule;
     }
 
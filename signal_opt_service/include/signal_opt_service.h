@@ -16,12 +16,11 @@ namespace signal_opt_service
     private:
         std::shared_ptr<signal_opt_messages_worker> _so_msgs_worker_ptr;
         std::string _bootstrap_server;
-        std::string _spat_group_id;
+        std::string _consumer_group_id;
         std::string _spat_topic_name;
-        std::string _vsi_group_id;
         std::string _vsi_topic_name;
-        std::shared_ptr<kafka_clients::kafka_consumer_worker> _vsi_consumer;
-        std::shared_ptr<kafka_clients::kafka_consumer_worker> _spat_consumer;
+        // Single consumer subscribed to both the SPaT and the vehicle status and intent topics
+        std::shared_ptr<kafka_clients::consumer_transport> _consumer;
 
     public:
         /**
@@ -37,16 +36,21 @@ namespace signal_opt_service
          */
         bool initialize();
         /**
-         * @brief Create threads and consume messages
+         * @brief Create the consumer thread and consume messages
          */
         void start() const;
 
         /**
-         * @brief Consume the different types of kafka stream via kafka consumers
-         * @param msg_json The consumed kafka stream in JSON format
+         * @brief Consume the SPaT and vehicle status and intent topics from one poll loop and dispatch the
+         * messages by topic.
+         */
+        void consume_msgs() const;
+        /**
+         * @brief Process a consumed message of the given type
+         * @param payload The consumed kafka message in JSON format
          * @param consume_msg_type The type of message consumed by the kafka consumer
          */
-        void consume_msg(std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer, CONSUME_MSG_TYPE consume_msg_type) const;
+        void process_msg(const std::string &payload, CONSUME_MSG_TYPE consume_msg_type) const;
         /**
          * @brief Updating the intersection info.
          * @param sleep_millisecs The current thread sleep for milliseconds after each update attempt
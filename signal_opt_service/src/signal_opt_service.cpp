@@ -9,28 +9,31 @@ namespace signal_opt_service
             _so_msgs_worker_ptr = std::make_shared<signal_opt_messages_worker>();
 
             // Kafka config
-            auto client = std::make_unique<kafka_clients::kafka_client>();
+            auto client = std::make_unique<kafka_clients::kafka_client>(
+                kafka_clients::parse_transport_type(streets_service::streets_configuration::get_string_config("message_transport")));
             _bootstrap_server = streets_service::streets_configuration::get_string_config("bootstrap_server");
             _spat_topic_name = streets_service::streets_configuration::get_string_config("spat_consumer_topic");
-            _spat_group_id = streets_service::streets_configuration::get_string_config("spat_group_id");
             _vsi_topic_name = streets_service::streets_configuration::get_string_config("vsi_consumer_topic");
-            _vsi_group_id = streets_service::streets_configuration::get_string_config("vsi_group_id");
+            _consumer_group_id = streets_service::streets_configuration::get_string_config("consumer_group_id");
 
-            _spat_consumer = client->create_consumer(_bootstrap_server, _spat_topic_name, _spat_group_id);
-            _vsi_consumer = client->create_consumer(_bootstrap_server, _vsi_topic_name, _vsi_group_id);
+            auto consumer_properties = kafka_clients::get_consumer_properties(
+                streets_service::streets_configuration::get_string_config("kafka_consumer_profile"),
+                streets_service::streets_configuration::get_string_config("kafka_consumer_properties"));
 
-            if (!_spat_consumer->init() || !_vsi_consumer->init())
+            // Single consumer for the SPaT and vehicle status and intent topics
+            _consumer = client->create_consumer_transport(_bootstrap_server, std::vector<std::string>{_spat_topic_name, _vsi_topic_name}, _consumer_group_id, consumer_properties);
+
+            if (!_consumer->init())
             {
-                SPDLOG_CRITICAL("kafka consumers ( _spat_consumer_worker  or _vsi_consumer_worker) initialize error");
+                SPDLOG_CRITICAL("kafka consumer ( _consumer ) initialize error");
                 exit(EXIT_FAILURE);
             }
             else
             {
-                _spat_consumer->subscribe();
-                _vsi_consumer->subscribe();
-                if (!_spat_consumer->is_running() || !_vsi_consumer->is_running())
+                _consumer->subscribe();
+                if (!_consumer->is_running())
                 {
-                    SPDLOG_CRITICAL("kafka consumers ( _spat_consumer_worker or _vsi_consumer_worker) is not running");
+                    SPDLOG_CRITICAL("kafka consumer ( _consumer ) is not running");
                     exit(EXIT_FAILURE);
                 }
             }
@@ -57,45 +60,50 @@ namespace signal_opt_service
 
     void signal_opt_service::start() const
     {
-        std::thread spat_t(&signal_opt_service::consume_msg, this, std::ref(_spat_consumer), CONSUME_MSG_TYPE::SPAT);
-        std::thread vsi_t(&signal_opt_service::consume_msg, this, std::ref(_vsi_consumer), CONSUME_MSG_TYPE::VEHICLE_STATUS_INTENT);
-        spat_t.join();
-        vsi_t.join();
+        std::thread consumer_t(&signal_opt_service::consume_msgs, this);
+        consumer_t.join();
     }
 
-    void signal_opt_service::consume_msg(std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer, CONSUME_MSG_TYPE consume_msg_type) const
+    void signal_opt_service::consume_msgs() const
     {
-        while (consumer->is_running())
+        kafka_clients::kafka_consumer_dispatcher dispatcher(_consumer);
+        dispatcher.register_handler(_spat_topic_name, [this](const kafka_clients::kafka_message &msg)
+                                    { process_msg(msg.to_string(), CONSUME_MSG_TYPE::SPAT); });
+        dispatcher.register_handler(_vsi_topic_name, [this](const kafka_clients::kafka_message &msg)
+                                    { process_msg(msg.to_string(), CONSUME_MSG_TYPE::VEHICLE_STATUS_INTENT); });
+        dispatcher.run();
+    }
+
+    void signal_opt_service::process_msg(const std::string &payload, CONSUME_MSG_TYPE consume_msg_type) const
+    {
+        if (payload.length() == 0)
         {
-            const std::string payload = consumer->consume(1000);
-            if (payload.length() != 0)
-            {
-                SPDLOG_DEBUG("Consumed: {0}", payload);
-                if (!_so_msgs_worker_ptr)
-                {
-                    SPDLOG_CRITICAL("Message worker is not initialized");
-                    break;
-                }
+            return;
+        }
+        SPDLOG_DEBUG("Consumed: {0}", payload);
+        if (!_so_msgs_worker_ptr)
+        {
+            SPDLOG_CRITICAL("Message worker is not initialized");
+            return;
+        }
 
-                switch (consume_msg_type)
-                {
-                case CONSUME_MSG_TYPE::SPAT:
-                    if (!_so_msgs_worker_ptr->update_spat(payload))
-                    {
-                        SPDLOG_CRITICAL("Error occurred when updating SPAT.");                       
-                    }
-                    break;
-                case CONSUME_MSG_TYPE::VEHICLE_STATUS_INTENT:
-                    if (!_so_msgs_worker_ptr->add_update_vehicle(payload))
-                    {
-                        SPDLOG_CRITICAL("Error occurred when updating vehicle list.");
-                    }
-                    break;
-                default:
-                    SPDLOG_ERROR("Unknown consumer type!");
-                    break;
-                }
+        switch (consume_msg_type)
+        {
+        case CONSUME_MSG_TYPE::SPAT:
+            if (!_so_msgs_worker_ptr->update_spat(payload))
+            {
+                SPDLOG_CRITICAL("Error occurred when updating SPAT.");
             }
+            break;
+        case CONSUME_MSG_TYPE::VEHICLE_STATUS_INTENT:
+            if (!_so_msgs_worker_ptr->add_update_vehicle(payload))
+            {
+                SPDLOG_CRITICAL("Error occurred when updating vehicle list.");
+            }
+            break;
+        default:
+            SPDLOG_ERROR("Unknown consumer type!");
+            break;
         }
     }
 
@@ -121,14 +129,9 @@ namespace signal_opt_service
 
     signal_opt_service::~signal_opt_service()
     {
-        if (_spat_consumer)
-        {
-            _spat_consumer->stop();
-        }
-
-        if (_vsi_consumer)
+        if (_consumer)
         {
-            _vsi_consumer->stop();
+            _consumer->stop();
         }
     }
 }
\ No newline at end of file
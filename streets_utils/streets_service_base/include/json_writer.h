@@ -0,0 +1,69 @@
+#pragma once
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <string>
+
+
+namespace streets_service {
+    /**
+     * Largest buffer kept by a thread between two write_json calls. A buffer grown beyond it by an
+     * unusually large message is released after the message is written.
+     */
+    static constexpr size_t JSON_WRITER_MAX_RETAINED_BUFFER_SIZE = 1 << 20;
+
+    /**
+     * Buffer reused by the write_json calls of the calling thread and the number of write_json calls of
+     * the thread currently writing into it.
+     */
+    struct json_writer_thread_buffer
+    {
+        rapidjson::StringBuffer buffer;
+        unsigned int depth = 0;
+    };
+
+    inline json_writer_thread_buffer &get_json_writer_thread_buffer()
+    {
+        static thread_local json_writer_thread_buffer thread_buffer;
+        return thread_buffer;
+    }
+
+    /**
+     * Serialize a JSON message into a buffer reused by all write_json calls of the calling thread, so
+     * the buffer only grows to the size of the largest message instead of being allocated and grown for
+     * each message. The result is copied once into the returned string, which can be moved into a
+     * producer send without further copies. A write_json call made from within write_json_fn writes
+     * into its own buffer instead, so it does not overwrite the enclosing message.
+     *
+     * @param write_json_fn callable bool(rapidjson::Writer<rapidjson::StringBuffer> &writer) writing the
+     * message, for example with Writer calls or rapidjson::Value::Accept.
+     * @returns serialized message, or an empty string if write_json_fn returns false.
+     */
+    template <typename WriteJsonFn>
+    std::string write_json(WriteJsonFn &&write_json_fn)
+    {
+        auto &thread_buffer = get_json_writer_thread_buffer();
+        // Restores the depth also when write_json_fn throws
+        struct depth_guard
+        {
+            unsigned int &depth;
+            explicit depth_guard(unsigned int &counter) : depth(counter) { ++depth; }
+            ~depth_guard() { --depth; }
+        } guard(thread_buffer.depth);
+        const bool nested = thread_buffer.depth > 1;
+        rapidjson::StringBuffer nested_buffer;
+        rapidjson::StringBuffer &buffer = nested ? nested_buffer : thread_buffer.buffer;
+        buffer.Clear();
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        std::string json;
+        if (write_json_fn(writer))
+        {
+            json.assign(buffer.GetString(), buffer.GetSize());
+        }
+        if (!nested && buffer.GetSize() > JSON_WRITER_MAX_RETAINED_BUFFER_SIZE)
+        {
+            buffer.Clear();
+            buffer.ShrinkToFit();
+        }
+        return json;
+    }
+};
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+#include "json_writer.h"
+
+
+using namespace streets_service;
+
+TEST(test_json_writer, write_json) {
+    std::string json = write_json([](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        writer.StartObject();
+        writer.String("v_id");
+        writer.String("DOT-45244");
+        writer.String("cur_speed");
+        writer.Double(13.5);
+        writer.EndObject();
+        return true;
+    });
+    ASSERT_EQ("{\"v_id\":\"DOT-45244\",\"cur_speed\":13.5}", json);
+
+    // The reused buffer does not keep the previous message
+    rapidjson::Document doc;
+    doc.Parse("[1,2,3]");
+    json = write_json([&doc](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        return doc.Accept(writer);
+    });
+    ASSERT_EQ("[1,2,3]", json);
+
+    // Failed writes return an empty string
+    json = write_json([](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        writer.StartObject();
+        return false;
+    });
+    ASSERT_TRUE(json.empty());
+
+    // Messages larger than the retained buffer size are written completely
+    std::string large_value(JSON_WRITER_MAX_RETAINED_BUFFER_SIZE, 'a');
+    json = write_json([&large_value](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        return writer.String(large_value.c_str(), static_cast<rapidjson::SizeType>(large_value.size()));
+    });
+    ASSERT_EQ(large_value.size() + 2, json.size());
+    json = write_json([](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        return writer.Int(1);
+    });
+    ASSERT_EQ("1", json);
+
+    // Messages written from within write_json do not overwrite the enclosing message
+    std::string nested_json;
+    json = write_json([&nested_json](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        writer.StartArray();
+        writer.Int(1);
+        nested_json = write_json([](rapidjson::Writer<rapidjson::StringBuffer> &nested_writer) {
+            return nested_writer.String("nested");
+        });
+        writer.Int(2);
+        return writer.EndArray();
+    });
+    ASSERT_EQ("[1,2]", json);
+    ASSERT_EQ("\"nested\"", nested_json);
+    json = write_json([](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+        return writer.Int(3);
+    });
+    ASSERT_EQ("3", json);
+}
@@ -1,4 +1,5 @@
 #include "spat.h"
+#include "json_writer.h"
 
 namespace signal_phase_and_timing{
 
@@ -19,15 +20,14 @@ namespace signal_phase_and_timing{
         }else {
             throw signal_phase_and_timing_exception("SPaT message is missing required intersections property!");
         }
-        rapidjson::StringBuffer buffer;
         try {
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-            spat.Accept(writer);
+            return streets_service::write_json([&spat](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+                return spat.Accept(writer);
+            });
         }
         catch( const std::exception &e ) {
             throw signal_phase_and_timing_exception(e.what());
         }
-        return buffer.GetString();
     }
 
     void spat::fromJson(const std::string &json )  {
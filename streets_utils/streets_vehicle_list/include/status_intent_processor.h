@@ -41,6 +41,16 @@ namespace streets_vehicles {
              * @return std::string vehicle id.
              */
             std::string get_vehicle_id(const std::string &status_intent_msg, rapidjson::Document &doc) const;
+            /**
+             * @brief Get the vehicle id string from status and intent message held in a buffer that is not
+             * required to be NUL-terminated.
+             * 
+             * @param status_intent_msg pointer to status and intent message.
+             * @param length size of status and intent message in bytes.
+             * @param doc rapidjson::Document to parse message into.
+             * @return std::string vehicle id.
+             */
+            std::string get_vehicle_id(const char *status_intent_msg, size_t length, rapidjson::Document &doc) const;
 
             /**
              * @brief Get the timeout Any vehicle status and intent
@@ -7,10 +7,21 @@
 #include <chrono>  
 #include <shared_mutex>
 #include <mutex>
+#include <unordered_set>
 
 
 
 namespace streets_vehicles {
+    /**
+     * @brief Vehicles added, updated or removed from a vehicle_list since the previous change set.
+     * 
+     */
+    struct vehicle_change_set {
+        // Vehicles added or updated, with their latest information
+        std::vector<vehicle> updated;
+        // Ids of vehicles removed after timing out or clearing the vehicle list
+        std::vector<std::string> removed;
+    };
     /**
      * @brief Class to store vehicle information for all vehicles in an intersection. Contains pointer
      * to a status_intent_processor which holds business logic to process status and intent vehicle 
@@ -27,6 +38,19 @@ namespace streets_vehicles {
             // shared mutex to enable read/write locking (requires C++ > 17)
             std::shared_mutex vehicle_list_lock;
             std::shared_ptr<status_intent_processor> processor;
+            // Whether vehicle changes are tracked, enabled by the first get_vehicle_changes call
+            bool track_changes = false;
+            // Ids of vehicles added or updated since the previous change set
+            std::unordered_set<std::string> updated_ids;
+            // Ids of vehicles removed since the previous change set
+            std::unordered_set<std::string> removed_ids;
+            /**
+             * @brief Record a vehicle change for the next change set.
+             * 
+             * @param v_id vehicle id.
+             * @param removed true if the vehicle was removed, false if it was added or updated.
+             */
+            void record_change(const std::string &v_id, bool removed);
             /**
              * @brief Adds a vehicle to the vehicle map.
              * 
@@ -60,6 +84,14 @@ namespace streets_vehicles {
              * @return std::unordered_map<std::string, vehicle> .
              */
             std::unordered_map<std::string, vehicle> get_vehicles();
+            /**
+             * @brief Get the vehicles added, updated or removed since the previous call, copying only the changed vehicles. 
+             * Changes are tracked from the first call, which returns all vehicles as added. Meant for a single consumer
+             * keeping its own copy of the vehicles up to date. Times out old vehicles like get_vehicles.
+             * 
+             * @return vehicle_change_set changes since the previous call.
+             */
+            vehicle_change_set get_vehicle_changes();
             /**
              * @brief Get the vehicles by lane id.
              * 
@@ -81,6 +113,15 @@ namespace streets_vehicles {
              * @param update std::string status and intent JSON vehicle update 
              */
             void process_update(const std::string &update);
+            /**
+             * @brief Process JSON status and intent update held in a caller owned buffer (e.g. a Kafka
+             * message payload) without copying it into a std::string. The buffer does not need to be
+             * NUL-terminated.
+             * 
+             * @param update pointer to status and intent JSON vehicle update.
+             * @param length size of update in bytes.
+             */
+            void process_update(const char *update, size_t length);
             /**
              * @brief Set the status_intent_processor to allow for customizable update processing.
              * 
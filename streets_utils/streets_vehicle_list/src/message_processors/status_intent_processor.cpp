@@ -14,7 +14,11 @@ namespace streets_vehicles {
    
 
     std::string status_intent_processor::get_vehicle_id(const std::string &status_intent_msg, rapidjson::Document &doc) const {
-        doc.Parse(status_intent_msg.c_str());
+        return get_vehicle_id(status_intent_msg.data(), status_intent_msg.size(), doc);
+    }
+
+    std::string status_intent_processor::get_vehicle_id(const char *status_intent_msg, size_t length, rapidjson::Document &doc) const {
+        doc.Parse(status_intent_msg, length);
         if (doc.HasParseError()){
             SPDLOG_ERROR("Error  : {0} Offset: {1} ", doc.GetParseError(), doc.GetErrorOffset());
             throw status_intent_processing_exception("Status and Intent message has JSON parse error!");
@@ -36,14 +36,57 @@ namespace streets_vehicles {
         return vehicles;
     }
 
+    vehicle_change_set vehicle_list::get_vehicle_changes() {
+        vehicle_change_set changes;
+        // Write Lock
+        std::unique_lock  lock(vehicle_list_lock);
+        purge_old_vehicles( processor->get_timeout());
+        if ( !track_changes ) {
+            // First change set adds all vehicles
+            track_changes = true;
+            changes.updated.reserve(vehicles.size());
+            for ( const auto &[v_id, veh] : vehicles ) {
+                changes.updated.push_back(veh);
+            }
+            return changes;
+        }
+        changes.updated.reserve(updated_ids.size());
+        for ( const auto &v_id : updated_ids ) {
+            auto it = vehicles.find(v_id);
+            if ( it != vehicles.end() ) {
+                changes.updated.push_back(it->second);
+            }
+        }
+        changes.removed.assign(removed_ids.begin(), removed_ids.end());
+        updated_ids.clear();
+        removed_ids.clear();
+        return changes;
+    }
+
+    void vehicle_list::record_change(const std::string &v_id, bool removed) {
+        if ( !track_changes ) {
+            return;
+        }
+        if ( removed ) {
+            updated_ids.erase(v_id);
+            removed_ids.insert(v_id);
+        }
+        else {
+            removed_ids.erase(v_id);
+            updated_ids.insert(v_id);
+        }
+    }
+
     void vehicle_list::add_vehicle(const vehicle &veh) {
         vehicles.insert(std::pair<std::string, vehicle>({veh._id,veh}));
+        record_change(veh._id, false);
     }
 
     void vehicle_list::update_vehicle(const vehicle &vehicle) {
         auto it = vehicles.find(vehicle._id);
         if (it != vehicles.end()) {
             it->second = vehicle;
+            record_change(vehicle._id, false);
         }else{
             SPDLOG_WARN("Did not find vehicle {0} to update!", vehicle._id);
         }
@@ -57,6 +100,7 @@ namespace streets_vehicles {
             SPDLOG_DEBUG("Checking Vehicle {0} timestamp {1} < timeout time {2} !", veh._id, veh._cur_time, timeout );
             if ( veh._cur_time < timeout_time  ) {
                 SPDLOG_WARN("Vehicle {0} timed out!", veh._id);
+                record_change(veh._id, true);
                 vehicles.erase(it ++);
             }
             else {
@@ -67,6 +111,10 @@ namespace streets_vehicles {
     }
 
     void vehicle_list::process_update( const std::string &update ) {
+        process_update(update.data(), update.size());
+    }
+
+    void vehicle_list::process_update( const char *update, size_t length ) {
       
         if ( processor != nullptr ) {
             // Write lock for purge/update/add
@@ -75,7 +123,7 @@ namespace streets_vehicles {
             try{
                 vehicle vehicle;
                 rapidjson::Document doc;
-                std::string v_id = processor->get_vehicle_id(update, doc);
+                std::string v_id = processor->get_vehicle_id(update, length, doc);
                 if ( vehicles.find(v_id) != vehicles.end() ) {
                     // If vehicle is already in Vehicle List, update vehicle
                     vehicle = vehicles.find(v_id)->second;
@@ -115,6 +163,9 @@ namespace streets_vehicles {
         // Write Lock
         std::unique_lock  lock(vehicle_list_lock);
         SPDLOG_WARN("Clearing Vehicle list!");
+        for ( const auto &[v_id, veh] : vehicles ) {
+            record_change(v_id, true);
+        }
         vehicles.clear();
 
     }
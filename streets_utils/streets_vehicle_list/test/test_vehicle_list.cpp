@@ -146,6 +146,17 @@ TEST_F(vehicle_list_test, parse_valid_json) {
 
 }
 
+TEST_F(vehicle_list_test, parse_valid_json_buffer) {
+    ASSERT_EQ(veh_list->get_vehicles().size(), 0);
+    veh_list->get_processor()->set_timeout(3.154e11);
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    // Append trailing bytes to the buffer to ensure only the first length bytes are parsed.
+    std::string buffer = updates.front() + "garbage";
+    veh_list->process_update(buffer.data(), updates.front().size());
+    ASSERT_EQ( veh_list->get_vehicles().size(), 1);
+    ASSERT_EQ( veh_list->get_vehicles_by_state(vehicle_state::EV).begin()->_id, "DOT-507");
+}
+
 TEST_F(vehicle_list_test, parse_invalid_json) {
     // Test initialization
     auto vehicles = veh_list->get_vehicles();
@@ -198,4 +209,31 @@ TEST_F(vehicle_list_test, parse_timeout_json) {
     }
     SPDLOG_INFO("Processed all updates!");
 
-}
\ No newline at end of file
+}
+TEST_F(vehicle_list_test, vehicle_changes) {
+    veh_list->get_processor()->set_timeout(3.154e11);
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    veh_list->process_update(updates[0]);
+    // First change set adds all vehicles
+    auto changes = veh_list->get_vehicle_changes();
+    ASSERT_EQ(changes.updated.size(), 1);
+    ASSERT_EQ(changes.updated.front()._id, "DOT-507");
+    ASSERT_TRUE(changes.removed.empty());
+    changes = veh_list->get_vehicle_changes();
+    ASSERT_TRUE(changes.updated.empty());
+    ASSERT_TRUE(changes.removed.empty());
+
+    // Only the updated vehicle is in the next change set
+    veh_list->process_update(updates[1]);
+    changes = veh_list->get_vehicle_changes();
+    ASSERT_EQ(changes.updated.size(), 1);
+    ASSERT_EQ(changes.updated.front()._id, "DOT-508");
+
+    // Vehicles updated then removed are only removed
+    veh_list->process_update(updates[2]);
+    veh_list->clear();
+    changes = veh_list->get_vehicle_changes();
+    ASSERT_TRUE(changes.updated.empty());
+    ASSERT_EQ(changes.removed.size(), 2);
+    ASSERT_TRUE(veh_list->get_vehicle_changes().removed.empty());
+}
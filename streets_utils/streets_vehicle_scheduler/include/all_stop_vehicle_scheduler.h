@@ -10,6 +10,7 @@
 #include "all_stop_intersection_schedule.h"
 #include "scheduling_exception.h"
 #include "vehicle_sorting.h"
+#include "link_conflict_index.h"
 
 
 namespace streets_vehicle_scheduler {
@@ -34,6 +35,10 @@ namespace streets_vehicle_scheduler {
              * @brief Limits how much departure position for a given vehicle can change from current reported departure position.
              */
             int flexibility_limit = 5;
+            /**
+             * @brief Link lanelet conflict matrix, built once per intersection information update.
+             */
+            link_conflict_index link_conflicts;
             /**
              * @brief Schedule all currently Departing Vehicle (DVs). Estimate intersection departure times (dt's) for each vehicle
              * based on kinematic vehicle information and intersection geometry. Method assumes empty intersection_schedule is passed in.
@@ -44,10 +49,11 @@ namespace streets_vehicle_scheduler {
              */
             void schedule_dvs( std::list<streets_vehicles::vehicle> &dvs, const std::shared_ptr<all_stop_intersection_schedule> &schedule) const;
             /**
-             * @brief Schedule all currently Ready to Depart Vehicles (RDVs). Consider all possible RDV departure orders. Select
-             * the one with the least calculated delay. Delay for a given vehicle is the difference between Entering Time and Stopping 
-             * Time. Method assumes intersection_schedule only populated with DV(s) vehicle_schedules. Method will add vehicle_schedule(s)
-             * for each RDV in vector.
+             * @brief Schedule all currently Ready to Depart Vehicles (RDVs). Search RDV departure orders within the flexibility
+             * limit for the one with the least calculated delay (@see search_rdv_departure_orders). Delay for a given vehicle is the 
+             * difference between Entering Time and Stopping Time. Method assumes intersection_schedule only populated with DV(s) 
+             * vehicle_schedules. Method will add vehicle_schedule(s) for each RDV in vector.
+             * @throw scheduling_exception if no RDV departure order is within the flexibility limit.
              * 
              * @param rdvs vector of unscheduled RDVs
              * @param schedule all_stop_intersection_schedule to add RDV scheduling information to.
@@ -97,57 +103,88 @@ namespace streets_vehicle_scheduler {
             void schedule_evs( std::list<streets_vehicles::vehicle> &evs, const std::shared_ptr<all_stop_intersection_schedule> &schedule ) const;
             
             /**
-             * @brief Estimates an entering time (ET) for a given Entering Vehicle (EV). This method first searches among the 
-             * existing scheduled vehicles and find the departure time (DT) of the last scheduled vehicle with conflicting direction.
-             * The ET of the vehicle is calculated based on this DT (if exist) and the estimated stopping time (ST) oft the vehicle.  
+             * @brief Estimates an entering time (ET) for a given Entering Vehicle (EV). This method first finds the departure 
+             * time (DT) of the last scheduled vehicle with conflicting direction. The ET of the vehicle is calculated based on 
+             * this DT (if exist) and the estimated stopping time (ST) oft the vehicle.  
              * 
-             * @param schedule all_stop_intersection_schedule.
+             * @param departures latest departure of the scheduled vehicles on each link lanelet, indexed by link lanelet index.
              * @param ev vehicle for which to estimate ET.
              * @param st estimated stopping time.
              */
-            uint64_t estimate_entering_time_for_ev(const std::vector<all_stop_vehicle_schedule> &vehicle_schedules, const streets_vehicles::vehicle &ev, const uint64_t st) const;
+            uint64_t estimate_entering_time_for_ev(const std::vector<link_departure> &departures, const streets_vehicles::vehicle &ev, const uint64_t st) const;
 
 
             /**
-             * @brief Creates and intersection schedule for a given RDV departure order. RDV departure order is based on 
-             * rdvs order. Returns reference to intersection_schedule option/possibility with given departure order. Assumes
-             * intersection_schedule option only contains schedules for DVs. Populates intersection_schedule with RDV
-             * vehicle_schedules.
+             * @brief State of the RDV departure order search. Holds the RDVs with the values that do not depend on departure 
+             * order, the departure order being considered and the best departure order found.
+             */
+            struct rdv_departure_order_search {
+                // Unscheduled RDVs in ascending departure position order
+                std::vector<streets_vehicles::vehicle> rdvs;
+                // Link lanelet index for each RDV
+                std::vector<int> link_indexes;
+                // Estimated clearance time in milliseconds for each RDV
+                std::vector<uint64_t> clearance_times;
+                // Whether each RDV is part of the departure order being considered
+                std::vector<bool> scheduled;
+                // Number of RDVs in the departure order being considered
+                size_t scheduled_count = 0;
+                // Already scheduled vehicles (e.i. DVs) followed by the RDVs of the departure order being considered
+                std::vector<all_stop_vehicle_schedule> vehicle_schedules;
+                // Latest departure of vehicle_schedules on each link lanelet, indexed by link lanelet index
+                std::vector<link_departure> departures;
+                // Intersection schedule timestamp in milliseconds
+                uint64_t timestamp = 0;
+                // First available departure position given already scheduled vehicles (e.i. DVs)
+                int starting_departure_position = 1;
+                // RDV vehicle schedules of the departure order with the least delay
+                std::vector<all_stop_vehicle_schedule> best_schedules;
+                // Delay of the best departure order in milliseconds
+                uint64_t best_delay = 0;
+                // Whether a valid departure order was found
+                bool found = false;
+            };
+            /**
+             * @brief Depth first branch and bound search over RDV departure orders. Each level appends one unscheduled RDV 
+             * at the next departure position and removes it when backtracking, so departure orders are evaluated incrementally
+             * without copying the intersection schedule. Branches are pruned when a RDV departure position change exceeds the 
+             * flexibility_limit or when their delay lower bound is not less than the delay of the best departure order found. 
+             * Departure orders are considered in ascending departure position order, so between orders with equal delay the 
+             * first one is kept.
              * 
-             * @param rdvs vector of unscheduled RDVs
-             * @param option all_stop_intersection_schedule possibility.
-             * @param starting_departure_position first available departure position given already scheduled vehicle (e.i. DVs)
-             * @param scheduled_dvs a vector of scheduled dvs, This includes dvs already schedules and any RDVs scheduled in this permutation.
-             *         This is necessary for calculating the current RDVs entering time based on already scheduled DVs and RDVs conflicts.
-             * @return true if departure order is valid and does not violate flexibility_limit for any vehicle.
-             * @return false if departure order is invalid and does violate flexibility_limit for any vehicle.
-             */
-            bool consider_departure_position_permutation( 
-                                                    const std::list<streets_vehicles::vehicle> &rdvs, 
-                                                    const std::shared_ptr<all_stop_intersection_schedule> &option,
-                                                    int starting_departure_position ) const;
-
+             * @param search search state, updated with the best departure order found.
+             * @param delay delay in milliseconds of the RDVs in the departure order being considered.
+             */
+            void search_rdv_departure_orders( rdv_departure_order_search &search, uint64_t delay ) const;
             /**
-             * @brief Estimate clearance time any vehicle given it's link lanelet information.  
+             * @brief Creates the vehicle schedule of a RDV departing after the given scheduled vehicles. A RDV is granted access
+             * only if no conflicting vehicle is scheduled and the previously scheduled vehicle has access. 
              * 
-             * @param veh vehicle to estimate clearance time for. 
-             * @param link_lane_info link lanelet vehicle is attempting to clear. 
-             * @return uint64_t clearance time in milliseconds. 
+             * @param veh RDV to schedule.
+             * @param link_index link lanelet index of the RDV.
+             * @param clearance_time estimated clearance time of the RDV in milliseconds.
+             * @param vehicle_schedules already scheduled vehicles (DVs and RDVs) in departure order.
+             * @param departures latest departure of vehicle_schedules on each link lanelet, indexed by link lanelet index.
+             * @param timestamp intersection schedule timestamp in milliseconds.
+             * @param departure_position departure position of the RDV.
+             * @return all_stop_vehicle_schedule vehicle schedule of the RDV.
              */
-            uint64_t estimate_clearance_time(const streets_vehicles::vehicle &veh, const OpenAPI::OAILanelet_info &link_lane_info) const;
+            all_stop_vehicle_schedule schedule_rdv( const streets_vehicles::vehicle &veh, 
+                                                    const int link_index,
+                                                    const uint64_t clearance_time,
+                                                    const std::vector<all_stop_vehicle_schedule> &vehicle_schedules,
+                                                    const std::vector<link_departure> &departures,
+                                                    const uint64_t timestamp,
+                                                    const int departure_position ) const;
 
             /**
-             * @brief Given a link lane and a vector of vehicle schedules, this method returns a pointer to a vehicle schedule with a 
-             * conflicting direction and the latest departure time. If no vehicle schedules have conflicting directions it returns 
-             * nullptr. This method is meant to return the limiting conflicting vehicle for scheduling new RDVs in a link lane.
-             * 
-             * @param link_lane the linking lane to be traveled
-             * @param schedules Already scheduled vehicles
-             * @return std::shared_ptr<vehicle_schedule> pointer to vehicle schedule with conflicting direction and latest departure time.
+             * @brief Estimate clearance time any vehicle given it's link lanelet information.  
              * 
+             * @param veh vehicle to estimate clearance time for. 
+             * @param link_lane lanelet_table index of link lanelet vehicle is attempting to clear. 
+             * @return uint64_t clearance time in milliseconds. 
              */
-            std::shared_ptr<all_stop_vehicle_schedule> get_latest_conflicting(const OpenAPI::OAILanelet_info &link_lane,
-                                        const std::vector<all_stop_vehicle_schedule> &schedules) const;
+            uint64_t estimate_clearance_time(const streets_vehicles::vehicle &veh, const size_t link_lane) const;
 
             /**
              * @brief Method to use vehicle kinematic information to estimate earliest possible time stopping time for a vehicle.
@@ -164,10 +201,10 @@ namespace streets_vehicle_scheduler {
              * trajectory to provide the vehicle. 
              * 
              * @param veh vehicle for which to calculate distance.
-             * @param entry_lane entry lane information.
+             * @param entry_lane lanelet_table index of entry lane.
              * @return double distance in meters
              */
-            double estimate_delta_x_prime( const streets_vehicles::vehicle &veh, const OpenAPI::OAILanelet_info &entry_lane ) const;
+            double estimate_delta_x_prime( const streets_vehicles::vehicle &veh, const size_t entry_lane ) const;
 
             /**
              * @brief Method to calculate v_hat. This is the maximum speed reached between maximum speed reached between acceleration
@@ -246,6 +283,12 @@ namespace streets_vehicle_scheduler {
              * @param limit How much can departure position change between schedules for any vehicle.
              */
             void set_flexibility_limit( const int limit );
+            /**
+             * @brief Set the intersection info object and build the link lanelet conflict matrix from it.
+             * 
+             * @param _intersection_info intersection information.
+             */
+            void set_intersection_info(std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info ) override;
             
     };
 }
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "intersection_client_api_lib/OAIIntersection_info.h"
+
+namespace streets_vehicle_scheduler {
+    /**
+     * @brief Immutable table of the entry and link lanelets of an intersection, compiled once from intersection information
+     * so the scheduling hot path does not copy OAILanelet_info objects out of Qt lists. Lanelets are given a dense index,
+     * entry lanelets first then link lanelets, each in intersection information order, and lanelet properties are stored
+     * in arrays indexed by it.
+     */
+    class intersection_lanelet_table {
+        private:
+            /**
+             * @brief Lanelet id by lanelet index.
+             */
+            std::vector<int> ids;
+            /**
+             * @brief Lanelet length in meters by lanelet index.
+             */
+            std::vector<double> lengths;
+            /**
+             * @brief Lanelet speed limit in m/s by lanelet index.
+             */
+            std::vector<double> speed_limits;
+            /**
+             * @brief Lanelet signal group id by lanelet index, 0 if the lanelet has none.
+             */
+            std::vector<int> signal_group_ids;
+            /**
+             * @brief Lanelet indexes of the link lanelets connected to each entry lanelet in link lanelet order, empty for
+             * link lanelets.
+             */
+            std::vector<std::vector<size_t>> connecting_link_lanelets;
+            /**
+             * @brief Lanelet indexes of the entry lanelets in intersection information order.
+             */
+            std::vector<size_t> entry_lanelets;
+            /**
+             * @brief Lanelet indexes of the link lanelets in intersection information order.
+             */
+            std::vector<size_t> link_lanelets;
+            /**
+             * @brief Entry lanelet index by lanelet id.
+             */
+            std::unordered_map<int, size_t> entry_indexes;
+            /**
+             * @brief Link lanelet index by lanelet id.
+             */
+            std::unordered_map<int, size_t> link_indexes;
+
+            /**
+             * @brief Append a lanelet to the property arrays.
+             *
+             * @param lanelet lanelet information.
+             * @return size_t lanelet index.
+             */
+            size_t add_lanelet( const OpenAPI::OAILanelet_info &lanelet );
+
+        public:
+            /**
+             * @brief Construct an empty lanelet table.
+             */
+            intersection_lanelet_table() = default;
+            /**
+             * @brief Compile the entry and link lanelets of intersection information into a lanelet table.
+             *
+             * @param info intersection information.
+             */
+            explicit intersection_lanelet_table( const OpenAPI::OAIIntersection_info &info );
+            /**
+             * @brief Find the lanelet index of an entry lanelet.
+             *
+             * @param lanelet_id entry lanelet id.
+             * @param index set to the lanelet index if found.
+             * @return true if the id is an entry lanelet of the intersection.
+             */
+            bool find_entry_lanelet( const int lanelet_id, size_t &index ) const;
+            /**
+             * @brief Find the lanelet index of a link lanelet.
+             *
+             * @param lanelet_id link lanelet id.
+             * @param index set to the lanelet index if found.
+             * @return true if the id is a link lanelet of the intersection.
+             */
+            bool find_link_lanelet( const int lanelet_id, size_t &index ) const;
+            /**
+             * @brief Lanelet indexes of the entry lanelets in intersection information order.
+             */
+            const std::vector<size_t> &get_entry_lanelets() const;
+            /**
+             * @brief Lanelet indexes of the link lanelets in intersection information order.
+             */
+            const std::vector<size_t> &get_link_lanelets() const;
+            int get_id( const size_t index ) const;
+            double get_length( const size_t index ) const;
+            double get_speed_limit( const size_t index ) const;
+            int get_signal_group_id( const size_t index ) const;
+            /**
+             * @brief Lanelet indexes of the link lanelets connected to an entry lanelet, in link lanelet order.
+             */
+            const std::vector<size_t> &get_connecting_link_lanelets( const size_t index ) const;
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "intersection_client_api_lib/OAIIntersection_info.h"
+
+namespace streets_vehicle_scheduler {
+    /**
+     * @brief Latest departure time (dt) of the vehicles scheduled through a link lanelet.
+     */
+    struct link_departure {
+        // Whether any vehicle is scheduled through the link lanelet
+        bool scheduled = false;
+        // Latest departure time in milliseconds of the vehicles scheduled through the link lanelet
+        uint64_t dt = 0;
+    };
+
+    /**
+     * @brief Dense conflict bit matrix of the link lanelets of an intersection. Link lanelets are given a dense index in
+     * intersection information order and row i holds a bit for each link lanelet in the conflict lanelet ids of link
+     * lanelet i. Together with a link_departure vector indexed by link lanelet index, this finds the latest departure time
+     * of the scheduled conflicting vehicles in O(#links) without scanning the vehicle schedules.
+     */
+    class link_conflict_index {
+        private:
+            /**
+             * @brief Link lanelet index by link lanelet id.
+             */
+            std::unordered_map<int, int> link_indexes;
+            /**
+             * @brief Number of 64 bit words in each row of the conflict matrix.
+             */
+            size_t words_per_row = 0;
+            /**
+             * @brief Row major conflict bit matrix.
+             */
+            std::vector<uint64_t> conflicts;
+
+        public:
+            /**
+             * @brief Construct an empty link conflict index.
+             */
+            link_conflict_index() = default;
+            /**
+             * @brief Construct a link conflict index for the link lanelets of an intersection.
+             *
+             * @param info intersection information.
+             */
+            explicit link_conflict_index( const OpenAPI::OAIIntersection_info &info);
+            /**
+             * @brief Number of link lanelets.
+             */
+            size_t size() const;
+            /**
+             * @brief Get the link lanelet index of a link lanelet id.
+             *
+             * @param link_id link lanelet id.
+             * @return int link lanelet index or -1 if the id is not a link lanelet of the intersection.
+             */
+            int get_link_index( const int link_id ) const;
+            /**
+             * @brief Whether a link lanelet conflicts with another link lanelet.
+             *
+             * @param link_index link lanelet index.
+             * @param other_link_index other link lanelet index.
+             * @return true if the other link lanelet is in the conflict lanelet ids of the link lanelet.
+             */
+            bool is_conflicting( const int link_index, const int other_link_index ) const;
+            /**
+             * @brief Record a scheduled vehicle departure from a link lanelet.
+             *
+             * @param departures latest departure of each link lanelet, indexed by link lanelet index.
+             * @param link_index link lanelet index of the scheduled vehicle. Departures on unknown link lanelets (-1) are ignored.
+             * @param dt departure time of the scheduled vehicle in milliseconds.
+             */
+            void add_departure( std::vector<link_departure> &departures, const int link_index, const uint64_t dt ) const;
+            /**
+             * @brief Get the latest departure time of the scheduled vehicles on link lanelets conflicting with a link lanelet.
+             *
+             * @param departures latest departure of each link lanelet, indexed by link lanelet index.
+             * @param link_index link lanelet index.
+             * @param dt set to the latest departure time of the conflicting scheduled vehicles in milliseconds.
+             * @return true if a vehicle is scheduled on a conflicting link lanelet.
+             * @return false if no vehicle is scheduled on a conflicting link lanelet.
+             */
+            bool get_latest_conflicting_dt( const std::vector<link_departure> &departures, const int link_index, uint64_t &dt ) const;
+    };
+}
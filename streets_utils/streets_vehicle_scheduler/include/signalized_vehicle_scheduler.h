@@ -3,6 +3,11 @@
 #include <spdlog/spdlog.h>
 #include <vector>
 #include <set>
+#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <exception>
 #include "vehicle.h"
 #include "vehicle_scheduler.h"
 #include "streets_configuration.h"
@@ -38,6 +43,29 @@ namespace streets_vehicle_scheduler {
              */
             uint64_t final_green_buffer;
 
+            /**
+             * @brief Maximum number of threads scheduling the EVs of different entry lanes in parallel, including the calling thread.
+             * 1 schedules all entry lanes on the calling thread.
+             * 
+             */
+            unsigned int ev_scheduling_threads = 1;
+
+            /**
+             * @brief EV schedules of an entry lane kept by schedule_vehicle_changes for reuse in later schedules.
+             * 
+             */
+            struct lane_schedule_cache {
+                // Movement state of the entry lane the EV schedules were estimated with
+                signal_phase_and_timing::movement_state move_state;
+                // EV schedules of the entry lane
+                std::vector<signalized_vehicle_schedule> ev_schedules;
+            };
+            /**
+             * @brief Cached EV schedules by entry lane id. Entries are removed when a vehicle of the entry lane changes.
+             * 
+             */
+            std::unordered_map<int, lane_schedule_cache> lane_schedules;
+
             /**
              * @brief Estimate the intersection departure times (dt's) for all currently Departing Vehicle (DVs) based on kinematic vehicle 
              * information and intersection geometry. Method assumes empty intersection_schedule is passed in. Method will add vehicle_schedule(s) 
@@ -53,12 +81,26 @@ namespace streets_vehicle_scheduler {
              * being the first vehicle in that entry lanes vehicle list. Then, for each entry lane, an entering time (ET)
              * for each EV in the entry lane is calculated sequentially starting from the first vehicle until in the list.
              * ET is estimated based on the EV's earliest entering time (EET), its preceding vehicle's estimated ET, and 
-             * the modifed spat.
+             * the modifed spat. Entry lanes are independent given the modified spat, so they are scheduled in parallel on up to 
+             * ev_scheduling_threads threads and their EV schedules are added to the schedule in entry lanelet order.
              * 
              * @param evs list of all EVs.
              * @param schedule signalized_intersection_schedule to add EV scheduling information to.
+             * @throw scheduling_exception if scheduling any entry lane fails, the exception of the first such entry lane in 
+             * entry lanelet order.
              */
             void schedule_evs( std::list<streets_vehicles::vehicle> &evs, const std::shared_ptr<signalized_intersection_schedule> &schedule ) const;
+            /**
+             * @brief Schedule the EVs of a single entry lane sequentially, starting from the vehicle closest to the intersection.
+             * 
+             * @param entry_lane lanelet_table index of the entry lanelet.
+             * @param evs EVs of the entry lane sorted by distance.
+             * @param preceding_veh schedule of the DV preceding the first EV of the entry lane, nullptr if there is none.
+             * @param schedule_timestamp schedule timestamp in milliseconds.
+             * @return std::vector<signalized_vehicle_schedule> EV schedules in the order of evs.
+             */
+            std::vector<signalized_vehicle_schedule> schedule_lane_evs( const size_t entry_lane, const std::vector<streets_vehicles::vehicle> &evs, 
+                                                                        std::shared_ptr<signalized_vehicle_schedule> preceding_veh, const uint64_t schedule_timestamp ) const;
             /**
              * @brief Estimate an entering time (ET) for a given Entering Vehicle (EV). ET is estimated based on the EV's 
              * earliest entering time (EET), its preceding vehicle's estimated ET, and the modifed spat.
@@ -170,12 +212,23 @@ namespace streets_vehicle_scheduler {
              * from a single entry lane share a signal_group_id. Therefore, vehicles from an entry lane with different directions
              * at the intersection box shall be able to receive protected green at the same time.
              * 
-             * @param entry_lane_info entry lanelet lane. 
+             * @param entry_lane lanelet_table index of entry lanelet. 
              * @return signal_phase_and_timing::movement_state movement stat object.
              * @throws if two or more connection link lanelets from a single entry lane have different signal_group_id, then the design
              * does not satisfy the requirement of the signalized_vehicle_scheduler and thus, this method throws exception. 
              */
-            signal_phase_and_timing::movement_state find_movement_state_for_lane(const OpenAPI::OAILanelet_info &entry_lane_info) const;
+            signal_phase_and_timing::movement_state find_movement_state_for_lane(const size_t entry_lane) const;
+            /**
+             * @brief Whether the cached EV schedules of an entry lane can be reused for a new schedule. Requires the movement state
+             * of the entry lane to be unchanged, all vehicles of the entry lane to be schedulable at the schedule timestamp and all 
+             * cached entering times to not be earlier than the schedule timestamp.
+             * 
+             * @param entry_lane_id entry lane id.
+             * @param lane_vehicles tracked vehicles of the entry lane.
+             * @param timestamp schedule timestamp in milliseconds.
+             * @return true if the cached EV schedules of the entry lane can be reused.
+             */
+            bool is_lane_schedule_reusable(const int entry_lane_id, const std::vector<const streets_vehicles::vehicle*> &lane_vehicles, const uint64_t timestamp) const;
 
         public:
             /**
@@ -198,6 +251,23 @@ namespace streets_vehicle_scheduler {
              * @param schedule A signalize_intersection schedule shared pointer populated with a vehicle schedule for all EVs and DVs in the map.
              */
             void schedule_vehicles( std::unordered_map<std::string,streets_vehicles::vehicle> &vehicles, std::shared_ptr<intersection_schedule> &schedule) override;
+            /**
+             * @brief Method to schedule vehicles incrementally. EV schedules only depend on the vehicles of their entry lane and the 
+             * movement state of the entry lane, so EV schedules of entry lanes without vehicle changes and with an unchanged movement 
+             * state are reused from the previous schedule, and only DVs and EVs of the remaining entry lanes are scheduled with 
+             * schedule_vehicles. Reused EV schedules were estimated from the vehicle information at the time their entry lane was 
+             * last scheduled.
+             * 
+             * @param changes vehicles added, updated or removed since the previous call.
+             * @param schedule A signalized_intersection schedule shared pointer populated with a vehicle schedule for all tracked EVs and DVs.
+             */
+            void schedule_vehicle_changes( const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<intersection_schedule> &schedule) override;
+            /**
+             * @brief Set the intersection info object and clear the cached EV schedules.
+             * 
+             * @param _intersection_info intersection information.
+             */
+            void set_intersection_info(std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info ) override;
             
             /**
              * @brief Set the initial green buffer (ms). This value is used to account for the time it takes a vehicle before 
@@ -226,6 +296,19 @@ namespace streets_vehicle_scheduler {
              * @return uint64_t final green buffer.
              */
             uint64_t get_final_green_buffer() const;   
+            /**
+             * @brief Set the maximum number of threads scheduling the EVs of different entry lanes in parallel, including the 
+             * calling thread. Values below 1 are treated as 1.
+             * 
+             * @param threads maximum number of threads.
+             */
+            void set_ev_scheduling_threads(const unsigned int threads);
+            /**
+             * @brief Get the maximum number of threads scheduling the EVs of different entry lanes in parallel.
+             * 
+             * @return unsigned int maximum number of threads.
+             */
+            unsigned int get_ev_scheduling_threads() const;
             /**
              * @brief Get the spat object
              * 
@@ -10,6 +10,7 @@
 #include "intersection_schedule.h"
 #include "intersection_client_api_lib/OAIIntersection_info.h"
 #include "scheduling_exception.h"
+#include "intersection_lanelet_table.h"
 
 
 namespace streets_vehicle_scheduler {
@@ -24,6 +25,12 @@ namespace streets_vehicle_scheduler {
              * 
              */
             std::shared_ptr<OpenAPI::OAIIntersection_info> intersection_info;
+            /**
+             * @brief Maximum age in milliseconds of a vehicle update at the schedule timestamp. Older vehicle updates are no 
+             * longer considered for scheduling.
+             * 
+             */
+            static constexpr u_int64_t MAX_VEHICLE_UPDATE_AGE_MS = 5000;
 
         
             /**
@@ -33,25 +40,44 @@ namespace streets_vehicle_scheduler {
              * 
              * @param vehicles Vehicle for which to calculate future position and speed.
              * @param timestamp Current or future time in milliseconds since epoch
+             * Vehicles with updates more recent than timestamp or older than MAX_VEHICLE_UPDATE_AGE_MS are removed.
              * @throw scheduling_exception if vehicle update time for any vehicle is more recent than timestamp.
              */
             void estimate_vehicles_at_common_time( std::unordered_map<std::string,streets_vehicles::vehicle> &vehicles, 
                                                     const u_int64_t timestamp) const;
 
             /**
-             * @brief Helper method to get entry lane OAILanelet_info from intersection information given a vehicle.
+             * @brief Entry and link lanelets of intersection_info, compiled once per intersection information update.
+             * 
+             */
+            intersection_lanelet_table lanelet_table;
+            /**
+             * @brief Helper method to get the entry lane index in lanelet_table given a vehicle.
              * 
-             * @param veh Vehicle for which to find entry lane OAILanlet_info.
-             * @return OpenAPI::OAILanelet_info for entry lane.
+             * @param veh Vehicle for which to find entry lane.
+             * @return size_t lanelet_table index of entry lane.
+             * @throw scheduling_exception if the entry lane is not in intersection info.
              */
-            OpenAPI::OAILanelet_info get_entry_lanelet_info(const streets_vehicles::vehicle &veh) const;
+            size_t get_entry_lanelet_index(const streets_vehicles::vehicle &veh) const;
             /**
-             * @brief Helper method to get link lane OAILanelet_info from intersection information given a vehicle.
+             * @brief Helper method to get the link lane index in lanelet_table given a vehicle.
              * 
-             * @param veh Vehicle for which to find link lane OAILanlet_info.
-             * @return OpenAPI::OAILanelet_info for link lane.
+             * @param veh Vehicle for which to find link lane.
+             * @return size_t lanelet_table index of link lane.
+             * @throw scheduling_exception if the link lane is not in intersection info.
              */
-            OpenAPI::OAILanelet_info get_link_lanelet_info(const streets_vehicles::vehicle &veh) const;
+            size_t get_link_lanelet_index(const streets_vehicles::vehicle &veh) const;
+            /**
+             * @brief Latest information of the vehicles scheduled with schedule_vehicle_changes, by vehicle id.
+             * 
+             */
+            std::unordered_map<std::string, streets_vehicles::vehicle> tracked_vehicles;
+            /**
+             * @brief Apply a vehicle change set to tracked_vehicles.
+             * 
+             * @param changes vehicles added, updated or removed since the previous change set.
+             */
+            void apply_vehicle_changes(const streets_vehicles::vehicle_change_set &changes);
 
            
         public:
@@ -73,6 +99,21 @@ namespace streets_vehicle_scheduler {
              * @param schedule empty intersection_schedule shared pointer which is returned by reference to provide calculated scheduling information.
              */
             virtual void schedule_vehicles( std::unordered_map<std::string,streets_vehicles::vehicle> &vehicles, std::shared_ptr<intersection_schedule> &schedule) = 0;
+            /**
+             * @brief Method to schedule vehicles incrementally. Applies the vehicle changes since the previous call to the tracked 
+             * vehicles and schedules all tracked vehicles. The default implementation recomputes the full schedule with schedule_vehicles.
+             * Implementations can override this method to reuse the parts of the previous schedule not affected by the changes.
+             * 
+             * @param changes vehicles added, updated or removed since the previous call.
+             * @param schedule empty intersection_schedule shared pointer which is returned by reference to provide calculated scheduling information.
+             */
+            virtual void schedule_vehicle_changes( const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<intersection_schedule> &schedule);
+            /**
+             * @brief Get the vehicles tracked by schedule_vehicle_changes.
+             * 
+             * @return const std::unordered_map<std::string, streets_vehicles::vehicle>& tracked vehicles by vehicle id.
+             */
+            const std::unordered_map<std::string, streets_vehicles::vehicle> &get_tracked_vehicles() const;
             /**
              * @brief Get the intersection info object
              * 
@@ -80,11 +121,12 @@ namespace streets_vehicle_scheduler {
              */
             std::shared_ptr<OpenAPI::OAIIntersection_info> get_intersection_info() const;
             /**
-             * @brief Set the intersection info object
+             * @brief Set the intersection info object and compile its lanelet_table. Implementations override this method to 
+             * derive further lookup structures from the intersection information once per update.
              * 
              * @param _intersection_info 
              */
-            void set_intersection_info(std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info );
+            virtual void set_intersection_info(std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info );
             
             
     };
@@ -6,6 +6,11 @@ namespace streets_vehicle_scheduler {
         flexibility_limit = limit;
     }
 
+    void all_stop_vehicle_scheduler::set_intersection_info( std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info) {
+        vehicle_scheduler::set_intersection_info(_intersection_info);
+        link_conflicts = _intersection_info ? link_conflict_index(*_intersection_info) : link_conflict_index();
+    }
+
     void all_stop_vehicle_scheduler::schedule_vehicles( std::unordered_map<std::string,streets_vehicles::vehicle> &vehicles, 
                                                             std::shared_ptr<intersection_schedule> &i_sched) {
         
@@ -66,11 +71,12 @@ namespace streets_vehicle_scheduler {
     }
 
     double all_stop_vehicle_scheduler::estimate_delta_x_prime(const streets_vehicles::vehicle &veh, 
-                                                                const OpenAPI::OAILanelet_info &entry_lane) const{
+                                                                const size_t entry_lane) const{
         if ( veh._cur_state == streets_vehicles::vehicle_state::EV ) {
-            // Get Entry Lanelet
-            double delta_x_prime = (pow(entry_lane.getSpeedLimit(),2)-pow(veh._cur_speed,2))/(2*veh._accel_max) - 
-                pow(entry_lane.getSpeedLimit(), 2)/(2*veh._decel_max); 
+            // Get Entry Lanelet speed limit
+            double speed_limit = lanelet_table.get_speed_limit(entry_lane);
+            double delta_x_prime = (pow(speed_limit,2)-pow(veh._cur_speed,2))/(2*veh._accel_max) - 
+                pow(speed_limit, 2)/(2*veh._decel_max); 
             return  delta_x_prime;
         }
         else {
@@ -123,10 +129,10 @@ namespace streets_vehicle_scheduler {
         int departure_position_index = 1;                                                    
         for ( const auto &departing_veh : dvs ) {
             SPDLOG_TRACE("Scheduling DV with ID {0} .", departing_veh._id);
-            // get link lane info
-            OpenAPI::OAILanelet_info lane_info =  get_link_lanelet_info( departing_veh );
+            // get link lane
+            size_t link_lane =  get_link_lanelet_index( departing_veh );
             // calculate clearance time in milliseconds 
-            uint64_t clearance_time = estimate_clearance_time(departing_veh, lane_info);
+            uint64_t clearance_time = estimate_clearance_time(departing_veh, link_lane);
 
             all_stop_vehicle_schedule veh_sched;
             // set id
@@ -169,69 +175,65 @@ namespace streets_vehicle_scheduler {
     }
 
     void all_stop_vehicle_scheduler::schedule_rdvs( std::list<streets_vehicles::vehicle> &rdvs, const std::shared_ptr<all_stop_intersection_schedule> &schedule ) {
-        // Vector of considered intersection_schedule_options
-        std::vector<std::shared_ptr<all_stop_intersection_schedule>> schedule_options;
         // Sort rdvs ascending order based on departure position
         rdvs.sort(departure_position_comparator);
+        rdv_departure_order_search search;
         // Earliest possible departure position for RDVs is last scheduled DV departure position +1 
-        int starting_departure_position;
         if ( !schedule->vehicle_schedules.empty() ) {
-            starting_departure_position = schedule->vehicle_schedules.back().dp +1;
+            search.starting_departure_position = schedule->vehicle_schedules.back().dp +1;
         }
         else {
             // If no scheduled DVs, first available departure position is 1
-            starting_departure_position =  1;
-        }
-        SPDLOG_TRACE("Staring the schedule RDVs from departure index {0}!", starting_departure_position );
-        // TODO: for 8 possible approaches this may need to be optimized (greedy search)
-        do { 
-            SPDLOG_TRACE("Considering scheduling options with {0} as first RDV." ,rdvs.front()._id);
-            // update schedule option to include already scheduled vehicles
-            auto option = std::make_shared<all_stop_intersection_schedule> (*schedule);
-            // consider current permutation of RDV departure order
-            bool valid_option =  consider_departure_position_permutation(rdvs, option, starting_departure_position);
-            SPDLOG_TRACE("Scheduling option is valid : {0}.", valid_option);
-            // is permutation valid in terms of flexibility limit? Has any vehicle's departure index changed by more
-            // than the current flexibility limit.
-            if ( valid_option ) {
-                schedule_options.push_back(option);
-            }
-
+            search.starting_departure_position =  1;
         }
-        while (std::next_permutation( rdvs.begin(), rdvs.end(), departure_position_comparator));
-        // If no valid options were added.
-        if ( schedule_options.empty()) {
+        SPDLOG_TRACE("Staring the schedule RDVs from departure index {0}!", search.starting_departure_position );
+        // Link lanelet and clearance time do not depend on departure order
+        search.rdvs.reserve(rdvs.size());
+        search.link_indexes.reserve(rdvs.size());
+        search.clearance_times.reserve(rdvs.size());
+        for ( const auto &veh : rdvs ) {
+            search.clearance_times.push_back(estimate_clearance_time(veh, get_link_lanelet_index(veh)));
+            search.link_indexes.push_back(link_conflicts.get_link_index(veh._link_id));
+            search.rdvs.push_back(veh);
+        }
+        search.scheduled.assign(rdvs.size(), false);
+        search.vehicle_schedules.reserve(schedule->vehicle_schedules.size() + rdvs.size());
+        search.vehicle_schedules = schedule->vehicle_schedules;
+        search.departures.assign(link_conflicts.size(), link_departure());
+        for ( const auto &sched : schedule->vehicle_schedules ) {
+            link_conflicts.add_departure(search.departures, link_conflicts.get_link_index(sched.link_id), sched.dt);
+        }
+        search.timestamp = schedule->timestamp;
+        search_rdv_departure_orders(search, 0);
+        // If no valid departure order was found.
+        if ( !search.found ) {
             throw scheduling_exception("There are no valid schedules for RDVs! Please check flexibility_limit setting.");
         }
-        // Sort in ascending order based on delay.
-        std::sort(schedule_options.begin(), schedule_options.end(), delay_comparator);
-
-        SPDLOG_TRACE("All scheduling options, the option with RDV {0} first has the least delay of {1}.",
-                                schedule_options.front()->vehicle_schedules[starting_departure_position-1].v_id,
-                                schedule_options.front()->get_delay());
+        SPDLOG_TRACE("Best RDV departure order has delay of {0}.", search.best_delay);
        
-        // Add scheduled RDVs starting at last scheduled DV position to schedule
-        for ( const auto &sched : schedule_options.front()->vehicle_schedules){
-            // starting at first available departure position for dvs, add rdvs from best option to current schedule
-            if (starting_departure_position <= sched.dp ) {
-                // if rdv was granted access in this schedule add it to the list of RDVs granted access
-                if ( sched.access ) {
-                        streets_vehicles::vehicle rdv_granted_access = get_vehicle_with_id( rdvs, sched.v_id );
-                        SPDLOG_TRACE("Added RDV {0} to list of RDVs previously granted access.", rdv_granted_access._id);
-                        rdvs_previously_granted_access.push_back(rdv_granted_access);
-                }
-                schedule->vehicle_schedules.push_back( sched );
-                starting_departure_position ++;
+        // Add scheduled RDVs of the best departure order to schedule
+        for ( const auto &sched : search.best_schedules ){
+            // if rdv was granted access in this schedule add it to the list of RDVs granted access
+            if ( sched.access ) {
+                    streets_vehicles::vehicle rdv_granted_access = get_vehicle_with_id( rdvs, sched.v_id );
+                    SPDLOG_TRACE("Added RDV {0} to list of RDVs previously granted access.", rdv_granted_access._id);
+                    rdvs_previously_granted_access.push_back(rdv_granted_access);
             }
+            schedule->vehicle_schedules.push_back( sched );
         }
         SPDLOG_TRACE("Schedule for RDVs: \n" + schedule->toCSV());
     }
 
     void all_stop_vehicle_scheduler::schedule_evs( std::list<streets_vehicles::vehicle> &evs, const std::shared_ptr<all_stop_intersection_schedule> &schedule ) const {
+        // Latest departure of already scheduled vehicles on each link lanelet
+        std::vector<link_departure> departures(link_conflicts.size());
+        for ( const auto &veh_sched : schedule->vehicle_schedules ) {
+            link_conflicts.add_departure(departures, link_conflicts.get_link_index(veh_sched.link_id), veh_sched.dt);
+        }
         // Map of entry lane ids to preceding already scheduled vehicle
         std::unordered_map<int , all_stop_vehicle_schedule> preceding_vehicle_entry_lane_map;
-        for ( const auto &entry_lane : intersection_info->getEntryLanelets() ) {
-            int lane_id = entry_lane.getId();
+        for ( const auto &entry_lane : lanelet_table.get_entry_lanelets() ) {
+            int lane_id = lanelet_table.get_id(entry_lane);
             all_stop_vehicle_schedule preceding_veh;
             // Only one RDV can exist for each approach
             for (const auto &veh_sched : schedule->vehicle_schedules ) {
@@ -256,18 +258,19 @@ namespace streets_vehicle_scheduler {
         
         // Create a map of entry lane id keys and list of vehicle to be scheduled next in each lane.
         std::unordered_map<int, std::list<streets_vehicles::vehicle>> vehicle_to_be_scheduled_next;
-        for ( const auto &entry_lane : intersection_info->getEntryLanelets() ) {
+        for ( const auto &entry_lane : lanelet_table.get_entry_lanelets() ) {
+            int lane_id = lanelet_table.get_id(entry_lane);
             std::list<streets_vehicles::vehicle> vehicles_in_lane;
             for ( const auto &ev : evs ) {
-                if ( ev._entry_lane_id == entry_lane.getId()) {
+                if ( ev._entry_lane_id == lane_id) {
                     SPDLOG_TRACE("Adding vehicle {0} to EVs list in entry lane {1}", ev._id, ev._entry_lane_id);
                     vehicles_in_lane.push_back(ev);
                 }
             }
             if ( !vehicles_in_lane.empty())
-                vehicle_to_be_scheduled_next.try_emplace( entry_lane.getId(), vehicles_in_lane );
+                vehicle_to_be_scheduled_next.try_emplace( lane_id, vehicles_in_lane );
             else {
-                SPDLOG_TRACE("No EVs in lane {0}.",static_cast<int>(entry_lane.getId()) );
+                SPDLOG_TRACE("No EVs in lane {0}.", lane_id );
             }
         }
         if ( !vehicle_to_be_scheduled_next.empty()) {
@@ -295,9 +298,9 @@ namespace streets_vehicle_scheduler {
                 streets_vehicles::vehicle ev = evs_in_lane.front();
                 SPDLOG_TRACE( "Estimating schedule for {0}.", ev._id);
 
-                // Get link lanelet information for ev
-                OpenAPI::OAILanelet_info link_lane = get_link_lanelet_info( ev );
-                SPDLOG_TRACE( "Link lanelet for {0} is {1}.", ev._id, link_lane.getId());
+                // Get link lanelet for ev
+                size_t link_lane = get_link_lanelet_index( ev );
+                SPDLOG_TRACE( "Link lanelet for {0} is {1}.", ev._id, lanelet_table.get_id(link_lane));
                 // Calculate EST for vehicle
                 uint64_t est = estimate_earliest_time_to_stop_bar(ev);
                 SPDLOG_TRACE( "EST for vehicle {0} is {1}." ,ev._id, est ) ;
@@ -334,7 +337,7 @@ namespace streets_vehicle_scheduler {
                     sched.state = streets_vehicles::vehicle_state::EV;
                     sched.access = false;
                     sched.dp = last_departure_index;
-                    sched.et = estimate_entering_time_for_ev(schedule->vehicle_schedules, ev, st);
+                    sched.et = estimate_entering_time_for_ev(departures, ev, st);
                     // Departure time is equal to entering time + clearance time
                     sched.dt = sched.et + estimate_clearance_time( ev, link_lane );
             
@@ -344,6 +347,7 @@ namespace streets_vehicle_scheduler {
             SPDLOG_TRACE( "Found vehicle {0} with lowest stopping time {1} in lane {2}", sched.v_id, sched.st, sched.entry_lane);
             // Add lowest ST to schedule
             schedule->vehicle_schedules.push_back(sched);
+            link_conflicts.add_departure(departures, link_conflicts.get_link_index(sched.link_id), sched.dt);
             // Increment departure index
             last_departure_index++;
             // Replace previous preceeding vehicle for lane with scheduled vehicle
@@ -365,24 +369,16 @@ namespace streets_vehicle_scheduler {
         while ( !vehicle_to_be_scheduled_next.empty() );
     }
 
-    uint64_t all_stop_vehicle_scheduler::estimate_entering_time_for_ev( const std::vector<all_stop_vehicle_schedule> &vehicle_schedules, const streets_vehicles::vehicle &ev, const uint64_t st) const {
-        // Get link lanelet information for ev
-        OpenAPI::OAILanelet_info link_lane = get_link_lanelet_info( ev );
-        // Get schedule of conflicting vehicle with largest dt from already scheduled vehicles
-        if ( !vehicle_schedules.empty() ) {
-            std::shared_ptr<all_stop_vehicle_schedule> conflict_with_largest_dt = get_latest_conflicting(link_lane, vehicle_schedules);
-            
-            if ( conflict_with_largest_dt != nullptr) {
-                SPDLOG_TRACE("Vehicle with largest conflict to {0} is {1}.", ev._id, conflict_with_largest_dt->v_id);
-                // Entering time is the maximum between the conflicting vehicles departure time and the current vehicles stopping time
-                return std::max(conflict_with_largest_dt->dt, st);
-            }else{
-                // If there is no conflicting scheduled vehicle, st == et
-                return st;
-            }
+    uint64_t all_stop_vehicle_scheduler::estimate_entering_time_for_ev( const std::vector<link_departure> &departures, const streets_vehicles::vehicle &ev, const uint64_t st) const {
+        // Get departure time of conflicting vehicle with largest dt from already scheduled vehicles
+        uint64_t latest_conflicting_dt = 0;
+        if ( link_conflicts.get_latest_conflicting_dt(departures, link_conflicts.get_link_index(ev._link_id), latest_conflicting_dt) ) {
+            SPDLOG_TRACE("Largest conflicting departure time for {0} is {1}.", ev._id, latest_conflicting_dt);
+            // Entering time is the maximum between the conflicting vehicles departure time and the current vehicles stopping time
+            return std::max(latest_conflicting_dt, st);
         }
         else {
-            // If schedule is empty there can be no conflict
+            // If there is no conflicting scheduled vehicle, st == et
             return st;
         }
     }
@@ -391,16 +387,16 @@ namespace streets_vehicle_scheduler {
         // Distance to stop bar 
         double delta_x = veh._cur_distance;
         // Get Entry Lane
-        OpenAPI::OAILanelet_info lane_info =  get_entry_lanelet_info( veh );
+        size_t entry_lane =  get_entry_lanelet_index( veh );
         // Distance necessary to get to max speed and decelerate with decel_max
-        double delta_x_prime =  estimate_delta_x_prime( veh, lane_info );
+        double delta_x_prime =  estimate_delta_x_prime( veh, entry_lane );
         SPDLOG_TRACE("Delta X Prime = {0}.", delta_x_prime);
 
         // Calculate v_hat and planned cruising time interval
         double v_hat;
         double t_cruising;
         if ( delta_x >= delta_x_prime ) {
-            v_hat = lane_info.getSpeedLimit();
+            v_hat = lanelet_table.get_speed_limit(entry_lane);
             SPDLOG_TRACE("V hat = {0}.", v_hat);
 
             t_cruising = calculate_cruising_time(veh, v_hat, delta_x_prime); 
@@ -429,97 +425,137 @@ namespace streets_vehicle_scheduler {
         return static_cast<uint64_t>(ceil(time_to_stop_bar * 1000.0)) + veh._cur_time;
     }
 
-    bool all_stop_vehicle_scheduler::consider_departure_position_permutation( 
-                                                                                const std::list<streets_vehicles::vehicle> &rdvs, 
-                                                                                const std::shared_ptr<all_stop_intersection_schedule> &option,
-                                                                                int starting_departure_position ) const {
-        for ( const auto &veh : rdvs ) {
-            // If scheduling option moves vehicle departure position more than flexibility limit it is not a valid option.
-            if ( abs(starting_departure_position - veh._departure_position) > flexibility_limit ) {
-                SPDLOG_WARN(
-                    "Not considering scheduling option since change in departure position for vehicle {0} exceeds flexibility limit {1}!",
-                    veh._id, flexibility_limit);
-                // Break out of scheduling estimation loop and do not consider this scheduling option
-                return false;
-            }
-            all_stop_vehicle_schedule sched;
-            // Populate common vehicle schedule information
-            sched.v_id = veh._id;
-            // RDVs should have already stopped
-            sched.st = veh._actual_st;
-            sched.est =  veh._actual_st;
-            // set dp position for current permutation                      
-            sched.dp = starting_departure_position;
-            // Set connection link lanelet id
-            sched.link_id = veh._link_id;
-            // Set entry lanelet id 
-            sched.entry_lane = veh._entry_lane_id;
-            // Get vehicle lane info
-            OpenAPI::OAILanelet_info veh_lane = get_link_lanelet_info(veh);
-            std::shared_ptr<all_stop_vehicle_schedule> latest_conflicting_vehicle = get_latest_conflicting( veh_lane, option->vehicle_schedules);
-            // If there is no conflicting scheduled vehicle (RDVs and DVs)
-            if ( latest_conflicting_vehicle == nullptr) {
-                // Consider previously scheduled vehicle. Current vehicle cannot be granted access
-                // to intersection regardless of conflict status before previously scheduled vehicle
-                // to preserve departure order
-                if ( option->vehicle_schedules.empty() || option->vehicle_schedules.back().access ) {
-                    // Give vehicle access since there are no proceeding vehicles
-                    sched.access = true;
-                    // Set vehicle state. Will not impact clearance time estimation since set on schedule
-                    sched.state = streets_vehicles::vehicle_state::DV;
-                    // Entering time equals schedule time
-                    sched.et = option->timestamp;
-                    // Departure time equals entering time + clearance time
-                    sched.dt =  sched.et + estimate_clearance_time( veh, veh_lane);
-                }
-                else {
-                    // Can not grant access to vehicle if previous vehicle does not have access yet.
-                    sched.access = false;
-                    // Set vehicle state. Will not impact clearance time estimation since set on schedule
-                    sched.state = streets_vehicles::vehicle_state::RDV;
-                    // Entering time equals schedule time
-                    sched.et = option->vehicle_schedules.back().et;
-                    // Departure time equals entering time + clearance time
-                    sched.dt =  sched.et + estimate_clearance_time( veh, veh_lane); 
+    void all_stop_vehicle_scheduler::search_rdv_departure_orders( rdv_departure_order_search &search, uint64_t delay ) const {
+        // Delay only grows as RDVs are added, so this departure order can not improve on the best one.
+        if ( search.found && delay >= search.best_delay ) {
+            return;
+        }
+        int departure_position = search.starting_departure_position + static_cast<int>(search.scheduled_count);
+        // All RDVs scheduled. Delay is less than the best departure order delay.
+        if ( search.scheduled_count == search.rdvs.size() ) {
+            search.best_schedules.assign(search.vehicle_schedules.end() - static_cast<long>(search.scheduled_count), search.vehicle_schedules.end());
+            search.best_delay = delay;
+            search.found = true;
+            SPDLOG_TRACE("Found RDV departure order with delay {0}.", delay);
+            return;
+        }
+        // Once a RDV is not granted access no later RDV is, and each entering time is at least the previous one. Unscheduled 
+        // RDVs will then be delayed at least until the entering time of the last scheduled vehicle.
+        if ( search.found && !search.vehicle_schedules.empty() && !search.vehicle_schedules.back().access ) {
+            uint64_t lower_bound = delay;
+            uint64_t last_et = search.vehicle_schedules.back().et;
+            for ( size_t i = 0; i < search.rdvs.size(); i++ ) {
+                if ( !search.scheduled[i] && last_et > search.rdvs[i]._actual_st ) {
+                    lower_bound += last_et - search.rdvs[i]._actual_st;
                 }
             }
+            if ( lower_bound >= search.best_delay ) {
+                return;
+            }
+        }
+        for ( size_t i = 0; i < search.rdvs.size(); i++ ) {
+            if ( search.scheduled[i] ) {
+                continue;
+            }
+            const auto &veh = search.rdvs[i];
+            // If departure order moves vehicle departure position more than flexibility limit it is not a valid option.
+            if ( abs(departure_position - veh._departure_position) > flexibility_limit ) {
+                SPDLOG_TRACE("Not considering departure position {0} for vehicle {1} since change exceeds flexibility limit {2}!",
+                    departure_position, veh._id, flexibility_limit);
+                continue;
+            }
+            int link_index = search.link_indexes[i];
+            all_stop_vehicle_schedule sched = schedule_rdv(veh, link_index, search.clearance_times[i], search.vehicle_schedules, 
+                                                            search.departures, search.timestamp, departure_position);
+            uint64_t veh_delay = sched.et - sched.st;
+            search.scheduled[i] = true;
+            search.scheduled_count++;
+            search.vehicle_schedules.push_back(sched);
+            // Link lanelet departure is restored when backtracking
+            link_departure previous_departure;
+            if ( link_index >= 0 ) {
+                previous_departure = search.departures[static_cast<size_t>(link_index)];
+            }
+            link_conflicts.add_departure(search.departures, link_index, sched.dt);
+            search_rdv_departure_orders(search, delay + veh_delay);
+            if ( link_index >= 0 ) {
+                search.departures[static_cast<size_t>(link_index)] = previous_departure;
+            }
+            search.vehicle_schedules.pop_back();
+            search.scheduled_count--;
+            search.scheduled[i] = false;
+        }
+    }
+
+    all_stop_vehicle_schedule all_stop_vehicle_scheduler::schedule_rdv( const streets_vehicles::vehicle &veh, 
+                                                                        const int link_index,
+                                                                        const uint64_t clearance_time,
+                                                                        const std::vector<all_stop_vehicle_schedule> &vehicle_schedules,
+                                                                        const std::vector<link_departure> &departures,
+                                                                        const uint64_t timestamp,
+                                                                        const int departure_position ) const {
+        all_stop_vehicle_schedule sched;
+        // Populate common vehicle schedule information
+        sched.v_id = veh._id;
+        // RDVs should have already stopped
+        sched.st = veh._actual_st;
+        sched.est =  veh._actual_st;
+        // set dp position for current departure order
+        sched.dp = departure_position;
+        // Set connection link lanelet id
+        sched.link_id = veh._link_id;
+        // Set entry lanelet id 
+        sched.entry_lane = veh._entry_lane_id;
+        // Find the latest departure time of the conflicting scheduled vehicles (RDVs and DVs)
+        uint64_t latest_conflicting_dt = 0;
+        bool has_conflict = link_conflicts.get_latest_conflicting_dt(departures, link_index, latest_conflicting_dt);
+        // If there is no conflicting scheduled vehicle (RDVs and DVs)
+        if ( !has_conflict ) {
+            // Consider previously scheduled vehicle. Current vehicle cannot be granted access
+            // to intersection regardless of conflict status before previously scheduled vehicle
+            // to preserve departure order
+            if ( vehicle_schedules.empty() || vehicle_schedules.back().access ) {
+                // Give vehicle access since there are no proceeding vehicles
+                sched.access = true;
+                // Set vehicle state. Will not impact clearance time estimation since set on schedule
+                sched.state = streets_vehicles::vehicle_state::DV;
+                // Entering time equals schedule time
+                sched.et = timestamp;
+            }
             else {
-                SPDLOG_TRACE("Latest conflicting vehicle is {0} and next vehicle is {1}", latest_conflicting_vehicle->v_id, veh._id);
+                // Can not grant access to vehicle if previous vehicle does not have access yet.
                 sched.access = false;
-                sched.state =  streets_vehicles::vehicle_state::RDV;
-                sched.et =  std::max(latest_conflicting_vehicle->dt, option->vehicle_schedules.back().et);
-                // Departure time is estimated clearance time for vehicle and link lane plus entering time
-                sched.dt = sched.et + estimate_clearance_time( veh, veh_lane );
-
-                
+                // Set vehicle state. Will not impact clearance time estimation since set on schedule
+                sched.state = streets_vehicles::vehicle_state::RDV;
+                // Entering time equals previous vehicle entering time
+                sched.et = vehicle_schedules.back().et;
             }
-            // Add vehicle schedule to option
-            option->vehicle_schedules.push_back(sched);
-            // Point to new previously scheduled vehicle
-            // Increment departure position
-            starting_departure_position++;
-
-            
         }
-        SPDLOG_TRACE("Schedule Option: \n"+option->toCSV());
-        SPDLOG_TRACE("With delay {0}." ,option->get_delay() );
-        return true;
-
-            
+        else {
+            SPDLOG_TRACE("Latest conflicting vehicle departs at {0} and next vehicle is {1}", latest_conflicting_dt, veh._id);
+            sched.access = false;
+            sched.state =  streets_vehicles::vehicle_state::RDV;
+            sched.et =  std::max(latest_conflicting_dt, vehicle_schedules.back().et);
+        }
+        // Departure time is estimated clearance time for vehicle and link lane plus entering time
+        sched.dt = sched.et + clearance_time;
+        return sched;
     }
 
     uint64_t all_stop_vehicle_scheduler::estimate_clearance_time( const streets_vehicles::vehicle &veh, 
-                                                                    const OpenAPI::OAILanelet_info &link_lane_info) const{
+                                                                    const size_t link_lane) const{
+        double speed_limit = lanelet_table.get_speed_limit(link_lane);
+        double length = lanelet_table.get_length(link_lane);
         // Clearance time in seconds 
         double clearance_time = 0;
         // If vehicle is Departing Vehicle consider its location in the link lanelet.
         if ( veh._cur_state == streets_vehicles::vehicle_state::DV ) {
             // Distance covered during constant max acceleration to speed limit
-            double constant_acceleration_delta_x = (pow(link_lane_info.getSpeedLimit(), 2) - pow( veh._cur_speed, 2))/(2* veh._accel_max);
+            double constant_acceleration_delta_x = (pow(speed_limit, 2) - pow( veh._cur_speed, 2))/(2* veh._accel_max);
             // If vehicle accelerates to speed limit with max acceleration is it still in link lanelet
             if ( veh._cur_distance > constant_acceleration_delta_x ) {
-                clearance_time = ( 2 * veh._accel_max * veh._cur_distance - link_lane_info.getSpeedLimit()*veh._cur_speed + pow(veh._cur_speed, 2))/
-                    (2*veh._accel_max*link_lane_info.getSpeedLimit());
+                clearance_time = ( 2 * veh._accel_max * veh._cur_distance - speed_limit*veh._cur_speed + pow(veh._cur_speed, 2))/
+                    (2*veh._accel_max*speed_limit);
             } else {
                 clearance_time = (sqrt(pow(veh._cur_speed, 2)+2*veh._accel_max*veh._cur_distance) -veh._cur_speed)/
                         veh._accel_max;
@@ -529,41 +565,21 @@ namespace streets_vehicle_scheduler {
         // Consider vehicle is stopped at stop bar
         else  {
             // Distance covered during constant max acceleration to speed limit assuming initial 0 speed.
-            double constant_acceleration_delta_x = pow(link_lane_info.getSpeedLimit(), 2) / (2 * veh._accel_max);
+            double constant_acceleration_delta_x = pow(speed_limit, 2) / (2 * veh._accel_max);
             // If vehicle accelerates to speed limit with max acceleration is it still in the link lanelet
-            if ( constant_acceleration_delta_x < link_lane_info.getLength()){
+            if ( constant_acceleration_delta_x < length){
                 // If yes assume vehicle cruises at speed limit for the duration of the lanelet
-                clearance_time = link_lane_info.getLength() / link_lane_info.getSpeedLimit() + 
-                            link_lane_info.getSpeedLimit() / (2 *veh._accel_max);
+                clearance_time = length / speed_limit + 
+                            speed_limit / (2 *veh._accel_max);
             } else{
                 // If not assume vehicle trajectory is constant acceleration from initial speed of 0
-                clearance_time = sqrt(2 * link_lane_info.getLength() / veh._accel_max) ;
+                clearance_time = sqrt(2 * length / veh._accel_max) ;
             }
         }
         // Convert time to milliseconds and round up.
         return static_cast<uint64_t>(ceil(1000.0* clearance_time));
     }
 
-    std::shared_ptr<all_stop_vehicle_schedule> all_stop_vehicle_scheduler::get_latest_conflicting(const OpenAPI::OAILanelet_info &link_lane, 
-                                                                                const std::vector<all_stop_vehicle_schedule> &schedules) const {       
-        std::shared_ptr<all_stop_vehicle_schedule> conflict = nullptr; 
-
-        // Loop through all scheduled vehicles and return conflict with largest dt
-        for ( const auto &sched : schedules ) {
-            // check if that have conflict with link_lane
-            if ( link_lane.getConflictLaneletIds().contains(sched.link_id)) {
-                // If no conflicting schedule has been set yet set conflict to first conflicting 
-                if ( conflict == nullptr ) {
-                    conflict = std::make_shared<all_stop_vehicle_schedule>( sched);
-                }
-                else if ( conflict->dt < sched.dt ) {
-                    conflict = std::make_shared<all_stop_vehicle_schedule>( sched);
-                }
-            }
-            
-        }
-        return conflict;                                              
-    }
     void all_stop_vehicle_scheduler::remove_rdv_previously_granted_access( const streets_vehicles::vehicle &veh) {
         auto previously_granted_itr = rdvs_previously_granted_access.begin();
         while ( previously_granted_itr != rdvs_previously_granted_access.end() ) {
@@ -0,0 +1,91 @@
+#include "intersection_lanelet_table.h"
+
+#include <algorithm>
+
+namespace streets_vehicle_scheduler {
+
+    intersection_lanelet_table::intersection_lanelet_table( const OpenAPI::OAIIntersection_info &info ) {
+        const auto entry_lanelet_infos = info.getEntryLanelets();
+        const auto link_lanelet_infos = info.getLinkLanelets();
+        size_t lanelet_count = static_cast<size_t>(entry_lanelet_infos.size() + link_lanelet_infos.size());
+        ids.reserve(lanelet_count);
+        lengths.reserve(lanelet_count);
+        speed_limits.reserve(lanelet_count);
+        signal_group_ids.reserve(lanelet_count);
+        connecting_link_lanelets.reserve(lanelet_count);
+        // Later lanelets with a duplicate id replace earlier ones, as the intersection information lookups did
+        for ( const auto &lanelet : entry_lanelet_infos ) {
+            size_t index = add_lanelet(lanelet);
+            entry_lanelets.push_back(index);
+            entry_indexes[lanelet.getId()] = index;
+        }
+        for ( const auto &lanelet : link_lanelet_infos ) {
+            size_t index = add_lanelet(lanelet);
+            link_lanelets.push_back(index);
+            link_indexes[lanelet.getId()] = index;
+        }
+        for ( size_t i = 0; i < entry_lanelets.size(); i++ ) {
+            const auto connecting_ids = entry_lanelet_infos[static_cast<int>(i)].getConnectingLaneletIds();
+            for ( const auto &link_index : link_lanelets ) {
+                if ( std::find(connecting_ids.begin(), connecting_ids.end(), ids[link_index]) != connecting_ids.end() ) {
+                    connecting_link_lanelets[entry_lanelets[i]].push_back(link_index);
+                }
+            }
+        }
+    }
+
+    size_t intersection_lanelet_table::add_lanelet( const OpenAPI::OAILanelet_info &lanelet ) {
+        ids.push_back(lanelet.getId());
+        lengths.push_back(lanelet.getLength());
+        speed_limits.push_back(lanelet.getSpeedLimit());
+        signal_group_ids.push_back(lanelet.getSignalGroupId());
+        connecting_link_lanelets.emplace_back();
+        return ids.size() - 1;
+    }
+
+    bool intersection_lanelet_table::find_entry_lanelet( const int lanelet_id, size_t &index ) const {
+        auto entry = entry_indexes.find(lanelet_id);
+        if ( entry == entry_indexes.end() ) {
+            return false;
+        }
+        index = entry->second;
+        return true;
+    }
+
+    bool intersection_lanelet_table::find_link_lanelet( const int lanelet_id, size_t &index ) const {
+        auto link = link_indexes.find(lanelet_id);
+        if ( link == link_indexes.end() ) {
+            return false;
+        }
+        index = link->second;
+        return true;
+    }
+
+    const std::vector<size_t> &intersection_lanelet_table::get_entry_lanelets() const {
+        return entry_lanelets;
+    }
+
+    const std::vector<size_t> &intersection_lanelet_table::get_link_lanelets() const {
+        return link_lanelets;
+    }
+
+    int intersection_lanelet_table::get_id( const size_t index ) const {
+        return ids[index];
+    }
+
+    double intersection_lanelet_table::get_length( const size_t index ) const {
+        return lengths[index];
+    }
+
+    double intersection_lanelet_table::get_speed_limit( const size_t index ) const {
+        return speed_limits[index];
+    }
+
+    int intersection_lanelet_table::get_signal_group_id( const size_t index ) const {
+        return signal_group_ids[index];
+    }
+
+    const std::vector<size_t> &intersection_lanelet_table::get_connecting_link_lanelets( const size_t index ) const {
+        return connecting_link_lanelets[index];
+    }
+}
@@ -0,0 +1,74 @@
+#include "link_conflict_index.h"
+
+namespace streets_vehicle_scheduler {
+
+    link_conflict_index::link_conflict_index( const OpenAPI::OAIIntersection_info &info) {
+        const auto link_lanelets = info.getLinkLanelets();
+        for ( const auto &link_lane : link_lanelets ) {
+            link_indexes.try_emplace( link_lane.getId(), static_cast<int>(link_indexes.size()));
+        }
+        words_per_row = (link_indexes.size() + 63) / 64;
+        conflicts.assign( link_indexes.size() * words_per_row, 0);
+        for ( const auto &link_lane : link_lanelets ) {
+            auto row = static_cast<size_t>(get_link_index(link_lane.getId()));
+            for ( const auto &conflict_id : link_lane.getConflictLaneletIds() ) {
+                int column = get_link_index(static_cast<int>(conflict_id));
+                // Conflict lanelet ids that are not link lanelets can not have scheduled vehicles
+                if ( column >= 0 ) {
+                    conflicts[row * words_per_row + static_cast<size_t>(column) / 64] |= uint64_t(1) << (static_cast<size_t>(column) % 64);
+                }
+            }
+        }
+    }
+
+    size_t link_conflict_index::size() const {
+        return link_indexes.size();
+    }
+
+    int link_conflict_index::get_link_index( const int link_id ) const {
+        auto link_index = link_indexes.find(link_id);
+        return link_index != link_indexes.end() ? link_index->second : -1;
+    }
+
+    bool link_conflict_index::is_conflicting( const int link_index, const int other_link_index ) const {
+        if ( link_index < 0 || other_link_index < 0 ) {
+            return false;
+        }
+        auto row = static_cast<size_t>(link_index);
+        auto column = static_cast<size_t>(other_link_index);
+        return (conflicts[row * words_per_row + column / 64] >> (column % 64)) & 1;
+    }
+
+    void link_conflict_index::add_departure( std::vector<link_departure> &departures, const int link_index, const uint64_t dt ) const {
+        if ( link_index < 0 ) {
+            return;
+        }
+        link_departure &departure = departures[static_cast<size_t>(link_index)];
+        if ( !departure.scheduled || departure.dt < dt ) {
+            departure.scheduled = true;
+            departure.dt = dt;
+        }
+    }
+
+    bool link_conflict_index::get_latest_conflicting_dt( const std::vector<link_departure> &departures, const int link_index, uint64_t &dt ) const {
+        if ( link_index < 0 ) {
+            return false;
+        }
+        bool has_conflict = false;
+        const uint64_t *row = conflicts.data() + static_cast<size_t>(link_index) * words_per_row;
+        for ( size_t word = 0; word < words_per_row; word++ ) {
+            uint64_t bits = row[word];
+            // Visit the set bits of the word, lowest first
+            while ( bits != 0 ) {
+                size_t column = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                const link_departure &departure = departures[column];
+                if ( departure.scheduled && ( !has_conflict || dt < departure.dt ) ) {
+                    has_conflict = true;
+                    dt = departure.dt;
+                }
+            }
+        }
+        return has_conflict;
+    }
+}
@@ -1,5 +1,6 @@
 
 #include "signalized_intersection_schedule.h"
+#include "json_writer.h"
 
 namespace streets_vehicle_scheduler {
 
@@ -46,12 +47,9 @@ namespace streets_vehicle_scheduler {
         }
         doc.AddMember("payload", json_sched, allocator);
 
-        rapidjson::StringBuffer buffer;                
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        doc.Accept(writer);
-        std::string string_sched = buffer.GetString();
-
-        return string_sched;
+        return streets_service::write_json([&doc](rapidjson::Writer<rapidjson::StringBuffer> &writer) {
+            return doc.Accept(writer);
+        });
     }
 
     rapidjson::Value signalized_vehicle_schedule::toJson(rapidjson::Document::AllocatorType& allocator) const {
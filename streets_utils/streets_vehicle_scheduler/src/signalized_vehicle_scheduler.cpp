@@ -43,12 +43,123 @@ namespace streets_vehicle_scheduler {
     }
 
 
+    void signalized_vehicle_scheduler::schedule_vehicle_changes( const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<intersection_schedule> &i_sched) {
+        // Entry lanes of changed vehicles, before and after the change
+        std::unordered_set<int> changed_lanes;
+        for ( const auto &v_id : changes.removed ) {
+            auto it = tracked_vehicles.find(v_id);
+            if ( it != tracked_vehicles.end() ) {
+                changed_lanes.insert(it->second._entry_lane_id);
+            }
+        }
+        for ( const auto &veh : changes.updated ) {
+            auto it = tracked_vehicles.find(veh._id);
+            if ( it != tracked_vehicles.end() ) {
+                changed_lanes.insert(it->second._entry_lane_id);
+            }
+            changed_lanes.insert(veh._entry_lane_id);
+        }
+        for ( const auto &lane_id : changed_lanes ) {
+            lane_schedules.erase(lane_id);
+        }
+        apply_vehicle_changes(changes);
+
+        auto schedule = std::dynamic_pointer_cast<signalized_intersection_schedule> (i_sched);
+        // Group tracked vehicles by entry lane
+        std::unordered_map<int, std::vector<const streets_vehicles::vehicle*>> lane_vehicles;
+        for ( const auto &[v_id, veh] : tracked_vehicles ) {
+            lane_vehicles[veh._entry_lane_id].push_back(&veh);
+        }
+        std::unordered_map<std::string, streets_vehicles::vehicle> vehicles;
+        std::vector<int> reused_lanes;
+        for ( const auto &[lane_id, vehicles_in_lane] : lane_vehicles ) {
+            bool reuse = is_lane_schedule_reusable(lane_id, vehicles_in_lane, schedule->timestamp);
+            if ( reuse ) {
+                reused_lanes.push_back(lane_id);
+            }
+            else {
+                lane_schedules.erase(lane_id);
+            }
+            for ( const auto &veh : vehicles_in_lane ) {
+                // DVs are always scheduled since their departure time depends on the schedule timestamp
+                if ( veh->_cur_state == streets_vehicles::vehicle_state::DV || ( !reuse && veh->_cur_state == streets_vehicles::vehicle_state::EV ) ) {
+                    vehicles.try_emplace(veh->_id, *veh);
+                }
+            }
+        }
+        // Remove cached EV schedules of entry lanes without vehicles
+        for ( auto it = lane_schedules.begin(); it != lane_schedules.end(); ) {
+            if ( lane_vehicles.find(it->first) == lane_vehicles.end() ) {
+                it = lane_schedules.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+        SPDLOG_DEBUG("Reusing EV schedules of {0} entry lanes.", reused_lanes.size());
+
+        schedule_vehicles(vehicles, i_sched);
+
+        // Cache the EV schedules of the scheduled entry lanes
+        std::unordered_map<int, std::vector<signalized_vehicle_schedule>> scheduled_lanes;
+        for ( const auto &veh_sched : schedule->vehicle_schedules ) {
+            if ( veh_sched.state == streets_vehicles::vehicle_state::EV ) {
+                scheduled_lanes[veh_sched.entry_lane].push_back(veh_sched);
+            }
+        }
+        for ( auto &[lane_id, ev_schedules] : scheduled_lanes ) {
+            size_t entry_lane_index = 0;
+            if ( lanelet_table.find_entry_lanelet(lane_id, entry_lane_index) ) {
+                lane_schedules.insert_or_assign(lane_id, lane_schedule_cache{find_movement_state_for_lane(entry_lane_index), std::move(ev_schedules)});
+            }
+        }
+        // Add the reused EV schedules
+        for ( const auto &lane_id : reused_lanes ) {
+            const auto &ev_schedules = lane_schedules.at(lane_id).ev_schedules;
+            schedule->vehicle_schedules.insert(schedule->vehicle_schedules.end(), ev_schedules.begin(), ev_schedules.end());
+        }
+    }
+
+    bool signalized_vehicle_scheduler::is_lane_schedule_reusable(const int entry_lane_id, const std::vector<const streets_vehicles::vehicle*> &lane_vehicles, const uint64_t timestamp) const {
+        auto cached = lane_schedules.find(entry_lane_id);
+        if ( cached == lane_schedules.end() ) {
+            return false;
+        }
+        size_t ev_count = 0;
+        for ( const auto &veh : lane_vehicles ) {
+            // Vehicles estimate_vehicles_at_common_time would remove change the entry lane schedule
+            if ( veh->_cur_time > timestamp || timestamp - veh->_cur_time > MAX_VEHICLE_UPDATE_AGE_MS ) {
+                return false;
+            }
+            if ( veh->_cur_state == streets_vehicles::vehicle_state::EV ) {
+                ev_count++;
+            }
+        }
+        if ( ev_count != cached->second.ev_schedules.size() ) {
+            return false;
+        }
+        for ( const auto &veh_sched : cached->second.ev_schedules ) {
+            if ( veh_sched.et < timestamp ) {
+                return false;
+            }
+        }
+        size_t entry_lane_index = 0;
+        if ( !lanelet_table.find_entry_lanelet(entry_lane_id, entry_lane_index) ) {
+            return false;
+        }
+        return find_movement_state_for_lane(entry_lane_index) == cached->second.move_state;
+    }
+
+    void signalized_vehicle_scheduler::set_intersection_info( std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info) {
+        vehicle_scheduler::set_intersection_info(_intersection_info);
+        lane_schedules.clear();
+    }
+
+
     void signalized_vehicle_scheduler::schedule_dvs( const std::list<streets_vehicles::vehicle> &dvs, const std::shared_ptr<signalized_intersection_schedule> &schedule ) const {
         
         for ( const auto &departing_veh : dvs ) {
             SPDLOG_DEBUG("Scheduling the departure time for DV with ID {0} .", departing_veh._id);
-            // get link lane info
-            OpenAPI::OAILanelet_info lane_info =  get_link_lanelet_info( departing_veh );
             // calculate clearance time in milliseconds 
             uint64_t clearance_time = estimate_clearance_time( departing_veh );
 
@@ -80,89 +191,123 @@ namespace streets_vehicle_scheduler {
         // Sort vehicles based on distance
         evs.sort(distance_comparator);
         
-        // Create a map of entry lane id keys and list of EVs in each lane.
-        std::unordered_map<int, std::list<streets_vehicles::vehicle>> vehicle_lane_map;
-        for ( const auto &entry_lane : intersection_info->getEntryLanelets() ) {
-            std::list<streets_vehicles::vehicle> vehicles_in_lane;
-            for ( const auto &ev : evs ) {
-                if ( ev._entry_lane_id == entry_lane.getId()) {
-                    SPDLOG_DEBUG("Adding vehicle {0} to EVs list in entry lane {1}", ev._id, ev._entry_lane_id);
-                    vehicles_in_lane.push_back(ev);
+        // Group EVs by entry lane, keeping the distance order within each entry lane.
+        std::vector<size_t> entry_lanes;
+        std::vector<std::vector<streets_vehicles::vehicle>> lane_evs;
+        std::unordered_map<int, size_t> lane_positions;
+        for ( const auto &ev : evs ) {
+            auto position = lane_positions.find(ev._entry_lane_id);
+            if ( position == lane_positions.end() ) {
+                size_t entry_lane_index = 0;
+                if ( !lanelet_table.find_entry_lanelet(ev._entry_lane_id, entry_lane_index) ) {
+                    SPDLOG_DEBUG("Entry lane {0} of vehicle {1} is not in intersection info.", ev._entry_lane_id, ev._id);
+                    continue;
                 }
+                position = lane_positions.try_emplace(ev._entry_lane_id, entry_lanes.size()).first;
+                entry_lanes.push_back(entry_lane_index);
+                lane_evs.emplace_back();
             }
-            if ( !vehicles_in_lane.empty()) {
-                vehicles_in_lane.sort(distance_comparator);
-                vehicle_lane_map.try_emplace( entry_lane.getId(), vehicles_in_lane );
-            }
-            else {
-                SPDLOG_DEBUG("No EVs in lane {0}.", static_cast<int>(entry_lane.getId()) );
-            }
+            SPDLOG_DEBUG("Adding vehicle {0} to EVs list in entry lane {1}", ev._id, ev._entry_lane_id);
+            lane_evs[position->second].push_back(ev);
         }
-        if ( vehicle_lane_map.empty() ) {
+        if ( entry_lanes.empty() ) {
             throw scheduling_exception("Map of vehicles to be scheduled is empty but list of EVs to be scheduled is not!");
         }
-        
-        for ( const auto &[entry_lane, evs_in_lane] : vehicle_lane_map ) {           
-            
-            SPDLOG_DEBUG("Scheduling EVs from entry lane {0} ", entry_lane);
 
-            // Find the last DV from the entry lane
-            std::shared_ptr<signalized_vehicle_schedule> preceding_veh = nullptr;
-            for (const auto &veh_sched : schedule->vehicle_schedules ) {
-                if ( veh_sched.entry_lane == entry_lane && veh_sched.state == streets_vehicles::vehicle_state::DV && (preceding_veh == nullptr || veh_sched.et < preceding_veh->et)) {
+        // Find the DV with the earliest ET in each entry lane
+        std::unordered_map<int, std::shared_ptr<signalized_vehicle_schedule>> preceding_dvs;
+        for ( const auto &veh_sched : schedule->vehicle_schedules ) {
+            if ( veh_sched.state == streets_vehicles::vehicle_state::DV && lane_positions.find(veh_sched.entry_lane) != lane_positions.end() ) {
+                auto &preceding_veh = preceding_dvs[veh_sched.entry_lane];
+                if ( preceding_veh == nullptr || veh_sched.et < preceding_veh->et ) {
                     preceding_veh = std::make_shared<signalized_vehicle_schedule>(veh_sched);
                 }
             }
-            
-            // Find the entry lane object
-            OpenAPI::OAILanelet_info entry_lane_info;
-            for ( const auto &lane : intersection_info->getEntryLanelets() ){
-                if ( lane.getId() == entry_lane ) {
-                    entry_lane_info = lane;
-                    break;
+        }
+
+        // Schedule entry lanes in parallel. Each entry lane writes only its own result slot.
+        std::vector<std::vector<signalized_vehicle_schedule>> lane_results(entry_lanes.size());
+        std::vector<std::exception_ptr> lane_errors(entry_lanes.size());
+        std::atomic<size_t> next_lane(0);
+        auto schedule_lanes = [&]() {
+            for ( size_t i = next_lane++; i < entry_lanes.size(); i = next_lane++ ) {
+                int lane_id = lanelet_table.get_id(entry_lanes[i]);
+                auto preceding_veh = preceding_dvs.find(lane_id);
+                try {
+                    lane_results[i] = schedule_lane_evs(entry_lanes[i], lane_evs[i], 
+                                                        preceding_veh != preceding_dvs.end() ? preceding_veh->second : nullptr, schedule->timestamp);
+                }
+                catch ( ... ) {
+                    lane_errors[i] = std::current_exception();
                 }
             }
-            SPDLOG_DEBUG("The entry lane id = {0}", entry_lane_info.getId());
-
-            // Get the movement_state object that connects to this entry lane
-            signal_phase_and_timing::movement_state move_state = find_movement_state_for_lane(entry_lane_info);
-            SPDLOG_DEBUG("The signal group id for the link lanelets connected to entry lane {0} = {1}", entry_lane_info.getId(), move_state.signal_group);
+        };
+        size_t thread_count = std::min(static_cast<size_t>(ev_scheduling_threads), entry_lanes.size());
+        std::vector<std::future<void>> workers;
+        for ( size_t t = 1; t < thread_count; t++ ) {
+            workers.push_back(std::async(std::launch::async, schedule_lanes));
+        }
+        schedule_lanes();
+        for ( auto &worker : workers ) {
+            worker.get();
+        }
 
-            for (const auto &ev : evs_in_lane){
-                signalized_vehicle_schedule sched;
-                SPDLOG_DEBUG( "Estimating schedule for {0}.", ev._id);
-                estimate_et(ev, preceding_veh, sched, move_state, schedule->timestamp);
-                // Add vehicle schedule to the schedule list.
-                schedule->vehicle_schedules.push_back(sched);
-                // Update the preceding vehicle schedule.
-                preceding_veh = std::make_shared<signalized_vehicle_schedule>(sched);
+        // Merge in entry lanelet order so the schedule does not depend on thread timing
+        std::vector<size_t> merge_order(entry_lanes.size());
+        for ( size_t i = 0; i < merge_order.size(); i++ ) {
+            merge_order[i] = i;
+        }
+        std::sort(merge_order.begin(), merge_order.end(), [&entry_lanes](size_t a, size_t b) { return entry_lanes[a] < entry_lanes[b]; });
+        for ( const auto &i : merge_order ) {
+            if ( lane_errors[i] ) {
+                std::rethrow_exception(lane_errors[i]);
             }
+        }
+        for ( const auto &i : merge_order ) {
+            schedule->vehicle_schedules.insert(schedule->vehicle_schedules.end(), lane_results[i].begin(), lane_results[i].end());
+            SPDLOG_DEBUG("All vehicles in lane {0} have been scheduled!", lanelet_table.get_id(entry_lanes[i]));
+        }
+    }
 
-            SPDLOG_DEBUG("All vehicles in lane {0} have been scheduled!", entry_lane);
-
+    std::vector<signalized_vehicle_schedule> signalized_vehicle_scheduler::schedule_lane_evs( const size_t entry_lane, const std::vector<streets_vehicles::vehicle> &evs, 
+                                                                                                std::shared_ptr<signalized_vehicle_schedule> preceding_veh, const uint64_t schedule_timestamp ) const {
+        SPDLOG_DEBUG("Scheduling EVs from entry lane {0} ", lanelet_table.get_id(entry_lane));
+        // Get the movement_state object that connects to this entry lane
+        signal_phase_and_timing::movement_state move_state = find_movement_state_for_lane(entry_lane);
+        SPDLOG_DEBUG("The signal group id for the link lanelets connected to entry lane {0} = {1}", lanelet_table.get_id(entry_lane), move_state.signal_group);
+
+        std::vector<signalized_vehicle_schedule> ev_schedules;
+        ev_schedules.reserve(evs.size());
+        for (const auto &ev : evs){
+            signalized_vehicle_schedule sched;
+            SPDLOG_DEBUG( "Estimating schedule for {0}.", ev._id);
+            estimate_et(ev, preceding_veh, sched, move_state, schedule_timestamp);
+            // Add vehicle schedule to the entry lane schedules.
+            ev_schedules.push_back(sched);
+            // Update the preceding vehicle schedule.
+            preceding_veh = std::make_shared<signalized_vehicle_schedule>(sched);
         }
+        return ev_schedules;
     }
 
 
-    signal_phase_and_timing::movement_state signalized_vehicle_scheduler::find_movement_state_for_lane(const OpenAPI::OAILanelet_info &entry_lane_info) const {
+    signal_phase_and_timing::movement_state signalized_vehicle_scheduler::find_movement_state_for_lane(const size_t entry_lane) const {
 
         // check if all links connected to the entry lane have the same signal ids or not!
         uint8_t signal_group_id = 0;
         bool first_link_visited = false;
-        auto connection_lanelet_ids = entry_lane_info.getConnectingLaneletIds();
-        for ( const auto &lane : intersection_info->getLinkLanelets() ) {
-            // check if the link lanelet's id (lane.getId()) is included in the list of connecting lanelet ids of the received entry lanelet.
-            if ( std::find(connection_lanelet_ids.begin(), connection_lanelet_ids.end(), lane.getId()) != connection_lanelet_ids.end() ) {
-                if ( !lane.getSignalGroupId() ) {
-                    throw scheduling_exception("The connection link lanelet does not have a group_id!");
-                }
-                if (first_link_visited && lane.getSignalGroupId() != signal_group_id){
-                    throw scheduling_exception("The link lanelets connected to the entry lane have different signal_group_ids! The signalized_vehicle_scheduler is only capable of understanding intersection where all connection lanes from a single entry lane share a signal_group_id!");
-                }
-                if (!first_link_visited) {
-                    signal_group_id = lane.getSignalGroupId();
-                    first_link_visited = true;
-                }
+        // link lanelets whose id is included in the list of connecting lanelet ids of the received entry lanelet.
+        for ( const auto &lane : lanelet_table.get_connecting_link_lanelets(entry_lane) ) {
+            int lane_signal_group_id = lanelet_table.get_signal_group_id(lane);
+            if ( !lane_signal_group_id ) {
+                throw scheduling_exception("The connection link lanelet does not have a group_id!");
+            }
+            if (first_link_visited && lane_signal_group_id != signal_group_id){
+                throw scheduling_exception("The link lanelets connected to the entry lane have different signal_group_ids! The signalized_vehicle_scheduler is only capable of understanding intersection where all connection lanes from a single entry lane share a signal_group_id!");
+            }
+            if (!first_link_visited) {
+                signal_group_id = lane_signal_group_id;
+                first_link_visited = true;
             }
         }
 
@@ -186,14 +331,14 @@ namespace streets_vehicle_scheduler {
 
     void signalized_vehicle_scheduler::estimate_et(const streets_vehicles::vehicle &veh, const std::shared_ptr<signalized_vehicle_schedule> &preceding_veh, signalized_vehicle_schedule &sched, const signal_phase_and_timing::movement_state &move_state, const uint64_t schedule_timestamp) const {
 
-        // Get link lanelet information for ev
-        OpenAPI::OAILanelet_info link_lane = get_link_lanelet_info( veh );
-        SPDLOG_DEBUG( "Link lanelet for vehicle {0} is {1}.", veh._id, link_lane.getId());
+        // Get link lanelet for ev
+        size_t link_lane = get_link_lanelet_index( veh );
+        SPDLOG_DEBUG( "Link lanelet for vehicle {0} is {1}.", veh._id, lanelet_table.get_id(link_lane));
         // Calculate EET for vehicle
         uint64_t eet = calculate_earliest_entering_time(veh);
         SPDLOG_DEBUG( "EET for vehicle {0} is {1}." ,veh._id, eet );
         // Calculate min_headway
-        uint64_t min_headway = calculate_min_headway( veh, link_lane.getSpeedLimit() );
+        uint64_t min_headway = calculate_min_headway( veh, lanelet_table.get_speed_limit(link_lane) );
         SPDLOG_DEBUG( "min headway for vehicle {0} is {1}.", veh._id, min_headway );
         /** estimate the earliest possible ET based on the current timestamp, the preceding vehicle's estimated ET, 
          * and the subject vehicle's minimum required safety time headway at tbe departure speed.
@@ -246,26 +391,26 @@ namespace streets_vehicle_scheduler {
         if ( veh._cur_state == streets_vehicles::vehicle_state::EV) {
             // Distance to stop bar 
             double delta_x = veh._cur_distance;
-            // Get Entry Lane
-            OpenAPI::OAILanelet_info entry_lane =  get_entry_lanelet_info( veh );
-            // Get Link Lane
-            OpenAPI::OAILanelet_info link_lane =  get_link_lanelet_info( veh );
+            // Get Entry Lane speed limit
+            double entry_speed_limit =  lanelet_table.get_speed_limit(get_entry_lanelet_index( veh ));
+            // Get Link Lane speed limit
+            double link_speed_limit =  lanelet_table.get_speed_limit(get_link_lanelet_index( veh ));
             // Distance necessary to get to max speed and decelerate with decel_max to departure speed
-            double delta_x_prime =  calculate_distance_accel_and_decel( veh, entry_lane.getSpeedLimit(), link_lane.getSpeedLimit() );
+            double delta_x_prime =  calculate_distance_accel_and_decel( veh, entry_speed_limit, link_speed_limit );
             // Distance necessary to get to the departure speed
-            double delta_x_zegond =  calculate_distance_accel_or_decel( veh, link_lane.getSpeedLimit() );
+            double delta_x_zegond =  calculate_distance_accel_or_decel( veh, link_speed_limit );
             SPDLOG_DEBUG("Delta X = {0}, Delta X Prime = {1}, Delta X Zegond = {2}.", delta_x, delta_x_prime, delta_x_zegond);
 
             // Calculate v_hat
-            double v_hat = calculate_v_hat(veh, entry_lane.getSpeedLimit(), link_lane.getSpeedLimit(), delta_x, delta_x_prime, delta_x_zegond);
+            double v_hat = calculate_v_hat(veh, entry_speed_limit, link_speed_limit, delta_x, delta_x_prime, delta_x_zegond);
             SPDLOG_DEBUG("V hat = {0}.", v_hat);
 
             // calculate planned acceleration time interval
-            double t_accel = calculate_acceleration_time(veh, v_hat, link_lane.getSpeedLimit(), delta_x, delta_x_zegond);
+            double t_accel = calculate_acceleration_time(veh, v_hat, link_speed_limit, delta_x, delta_x_zegond);
             SPDLOG_DEBUG("T accel = {0}.",t_accel);
 
             // calculate planned deceleration time interval
-            double t_decel = calculate_deceleration_time(veh, v_hat, link_lane.getSpeedLimit(), delta_x, delta_x_zegond);
+            double t_decel = calculate_deceleration_time(veh, v_hat, link_speed_limit, delta_x, delta_x_zegond);
             SPDLOG_DEBUG("T decel = {0}.",t_decel);
 
             // Calculate planned cruising time interval
@@ -380,18 +525,19 @@ namespace streets_vehicle_scheduler {
 
     uint64_t signalized_vehicle_scheduler::estimate_clearance_time( const streets_vehicles::vehicle &veh ) const {
         // Get Link Lane
-        OpenAPI::OAILanelet_info link_lane =  get_link_lanelet_info( veh );
+        size_t link_lane =  get_link_lanelet_index( veh );
         if ( veh._cur_state == streets_vehicles::vehicle_state::DV ) {
             return static_cast<uint64_t>( ceil(1000 * veh._cur_distance / veh._cur_speed) );
         }
         else {
-            return static_cast<uint64_t>( ceil(1000 * link_lane.getLength() / link_lane.getSpeedLimit()) );
+            return static_cast<uint64_t>( ceil(1000 * lanelet_table.get_length(link_lane) / lanelet_table.get_speed_limit(link_lane)) );
         }
     }
 
 
     void signalized_vehicle_scheduler::set_initial_green_buffer(const uint64_t buffer){
         initial_green_buffer = buffer;
+        lane_schedules.clear();
     }
 
     uint64_t signalized_vehicle_scheduler::get_initial_green_buffer() const {
@@ -400,18 +546,28 @@ namespace streets_vehicle_scheduler {
 
     void signalized_vehicle_scheduler::set_final_green_buffer(const uint64_t buffer){
         final_green_buffer = buffer;
+        lane_schedules.clear();
     }
 
     uint64_t signalized_vehicle_scheduler::get_final_green_buffer() const {
         return final_green_buffer;
     }
 
+    void signalized_vehicle_scheduler::set_ev_scheduling_threads(const unsigned int threads){
+        ev_scheduling_threads = std::max(threads, 1U);
+    }
+
+    unsigned int signalized_vehicle_scheduler::get_ev_scheduling_threads() const {
+        return ev_scheduling_threads;
+    }
+
     std::shared_ptr<signal_phase_and_timing::spat> signalized_vehicle_scheduler::get_spat() const {
         return spat_ptr;
     }
 
     void signalized_vehicle_scheduler::set_spat(std::shared_ptr<signal_phase_and_timing::spat> spat_info) {
         spat_ptr = spat_info;
+        lane_schedules.clear();
     }
     
 }
\ No newline at end of file
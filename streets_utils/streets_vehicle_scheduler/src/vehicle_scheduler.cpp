@@ -7,43 +7,44 @@ namespace streets_vehicle_scheduler {
 
     void vehicle_scheduler::set_intersection_info( std::shared_ptr<OpenAPI::OAIIntersection_info> _intersection_info) {
         intersection_info = _intersection_info;
+        lanelet_table = _intersection_info ? intersection_lanelet_table(*_intersection_info) : intersection_lanelet_table();
     }
 
 
-    OpenAPI::OAILanelet_info vehicle_scheduler::get_entry_lanelet_info(const streets_vehicles::vehicle &veh) const{
-        OpenAPI::OAILanelet_info entry_lane;
-        bool is_found = false;
-        for (const auto &lanelet : intersection_info->getEntryLanelets() ) {
-            int lane_id =lanelet.getId();
-            if ( lane_id == veh._entry_lane_id ) {
-                entry_lane =  lanelet;
-                is_found = true;
-            }
-            
+    void vehicle_scheduler::schedule_vehicle_changes( const streets_vehicles::vehicle_change_set &changes, std::shared_ptr<intersection_schedule> &schedule) {
+        apply_vehicle_changes(changes);
+        // schedule_vehicles estimates vehicles at the schedule timestamp in place, so schedule a copy
+        auto vehicles = tracked_vehicles;
+        schedule_vehicles(vehicles, schedule);
+    }
+
+    const std::unordered_map<std::string, streets_vehicles::vehicle> &vehicle_scheduler::get_tracked_vehicles() const {
+        return tracked_vehicles;
+    }
+
+    void vehicle_scheduler::apply_vehicle_changes(const streets_vehicles::vehicle_change_set &changes) {
+        for ( const auto &v_id : changes.removed ) {
+            tracked_vehicles.erase(v_id);
         }
-        if (!is_found) {
-            throw scheduling_exception("No entry lane " + std::to_string(veh._cur_lane_id) + " found in intersection info!");
+        for ( const auto &veh : changes.updated ) {
+            tracked_vehicles.insert_or_assign(veh._id, veh);
         }
-        return entry_lane;
-
     }
 
-     OpenAPI::OAILanelet_info vehicle_scheduler::get_link_lanelet_info(const streets_vehicles::vehicle &veh) const{
-        OpenAPI::OAILanelet_info link_lane;
-        bool is_found = false;
-        for ( const auto &lanelet : intersection_info->getLinkLanelets() ) {
-            int lane_id = lanelet.getId();
-            if ( lane_id == veh._link_id ) {
-                link_lane =  lanelet;
-                is_found = true;
-            }
-            
+    size_t vehicle_scheduler::get_entry_lanelet_index(const streets_vehicles::vehicle &veh) const{
+        size_t index = 0;
+        if ( !lanelet_table.find_entry_lanelet(veh._entry_lane_id, index) ) {
+            throw scheduling_exception("No entry lane " + std::to_string(veh._cur_lane_id) + " found in intersection info!");
         }
-        if (!is_found) {
+        return index;
+    }
+
+    size_t vehicle_scheduler::get_link_lanelet_index(const streets_vehicles::vehicle &veh) const{
+        size_t index = 0;
+        if ( !lanelet_table.find_link_lanelet(veh._link_id, index) ) {
             throw scheduling_exception("No link lane " + std::to_string(veh._cur_lane_id) + " found in intersection info!");
         }
-        return link_lane;
-
+        return index;
     }
 
     void vehicle_scheduler::estimate_vehicles_at_common_time( std::unordered_map<std::string,streets_vehicles::vehicle> &vehicles, 
@@ -53,8 +54,8 @@ namespace streets_vehicle_scheduler {
             // Time difference in seconds
             double delta_t = (((double)timestamp) - ((double)veh._cur_time))/1000.0;
             SPDLOG_TRACE("Schedule timestamp {0} vs vehicle timestamp {1}.", timestamp, veh._cur_time);
-            if ( delta_t > 5 ) {
-                SPDLOG_WARN("Vehicle update {0} is older than 5 s and no longer considered for scheduling!", veh._id);
+            if ( delta_t > MAX_VEHICLE_UPDATE_AGE_MS/1000.0 ) {
+                SPDLOG_WARN("Vehicle update {0} is older than {1} ms and no longer considered for scheduling!", veh._id, MAX_VEHICLE_UPDATE_AGE_MS);
                 vehicles_to_remove.push_back(veh._id);
                 continue;
             }
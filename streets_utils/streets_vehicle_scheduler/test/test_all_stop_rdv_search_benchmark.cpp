@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <set>
+
+#include "all_stop_vehicle_scheduler.h"
+#include "all_stop_intersection_schedule.h"
+
+using namespace streets_vehicles;
+using namespace streets_vehicle_scheduler;
+namespace {
+
+    const int round_count = 20;
+    const std::string intersection_json = "{\"departure_lanelets\":[{ \"id\":162, \"length\":41.60952439839113, \"speed_limit\":11.176}, { \"id\":164, \"length\":189.44565302601367, \"speed_limit\":11.176 }, { \"id\":168, \"length\":34.130869420842046, \"speed_limit\":11.176 } ], \"entry_lanelets\":[ { \"id\":167, \"length\":195.73023157287864, \"speed_limit\":11.176 }, { \"id\":171, \"length\":34.130869411176431136, \"speed_limit\":11.176 }, { \"id\":163, \"length\":41.60952435603712, \"speed_limit\":11.176 } ], \"id\":9001, \"link_lanelets\":[ { \"conflict_lanelet_ids\":[ 161 ], \"id\":169, \"length\":15.85409574709938, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 165, 156, 161 ], \"id\":155, \"length\":16.796388658952235, \"speed_limit\":4.4704 }, { \"conflict_lanelet_ids\":[ 155, 161, 160 ], \"id\":165, \"length\":15.853947840111768943, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 155 ], \"id\":156, \"length\":9.744590320260139, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 169, 155, 165 ], \"id\":161, \"length\":16.043077028554038, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 165 ], \"id\":160, \"length\":10.295559117055083, \"speed_limit\":11.176 } ], \"name\":\"WestIntersection\"}";
+    // Link lanelets of the intersection and their entry lanelets
+    const std::vector<std::pair<int, int>> links = {{169, 167}, {155, 171}, {165, 171}, {156, 163}, {161, 163}, {160, 167}};
+
+    std::unique_ptr<all_stop_vehicle_scheduler> create_scheduler(int flexibility_limit) {
+        auto scheduler = std::unique_ptr<all_stop_vehicle_scheduler>(new all_stop_vehicle_scheduler());
+        scheduler->set_flexibility_limit(flexibility_limit);
+        OpenAPI::OAIIntersection_info info;
+        info.fromJson(QString::fromStdString(intersection_json));
+        scheduler->set_intersection_info(std::make_shared<OpenAPI::OAIIntersection_info>(info));
+        return scheduler;
+    }
+
+    /**
+     * @brief RDVs stopped at the stop bar with departure positions 1 to rdv_count, the first RDVs stopped earliest.
+     */
+    std::unordered_map<std::string, vehicle> create_rdvs(int rdv_count, uint64_t timestamp) {
+        std::unordered_map<std::string, vehicle> veh_list;
+        for (int i = 0; i < rdv_count; i++) {
+            vehicle veh;
+            veh._id = "TEST_RDV_0" + std::to_string(i + 1);
+            veh._accel_max = 2.0;
+            veh._decel_max = -2.0;
+            veh._cur_speed = 0.0;
+            veh._cur_accel = 0.0;
+            veh._cur_distance = 1.0;
+            veh._cur_state = vehicle_state::RDV;
+            veh._cur_time = timestamp;
+            veh._link_id = links[i % links.size()].first;
+            veh._entry_lane_id = links[i % links.size()].second;
+            veh._cur_lane_id = veh._entry_lane_id;
+            veh._exit_lane_id = 164;
+            veh._direction = "straight";
+            veh._departure_position = i + 1;
+            veh._actual_st = timestamp - 1000 * (rdv_count - i);
+            veh_list.insert({veh._id, veh});
+        }
+        return veh_list;
+    }
+
+    /**
+     * @brief RDVs with departure positions 1 to rdv_count on a mix of conflicting and non conflicting link lanelets, stopped
+     * at times that do not follow their departure positions. The variant selects the link lanelets and stopping times.
+     */
+    std::unordered_map<std::string, vehicle> create_mixed_rdvs(int rdv_count, int variant, uint64_t timestamp) {
+        auto veh_list = create_rdvs(rdv_count, timestamp);
+        for (auto &[v_id, veh] : veh_list) {
+            int i = veh._departure_position - 1;
+            const auto &link = links[(i * (variant + 2) + variant) % links.size()];
+            veh._link_id = link.first;
+            veh._entry_lane_id = link.second;
+            veh._cur_lane_id = veh._entry_lane_id;
+            veh._actual_st = timestamp - 500 * ((i * 7 + variant * 3) % 11 + 1);
+        }
+        return veh_list;
+    }
+
+    std::shared_ptr<all_stop_intersection_schedule> schedule_rdvs(std::unordered_map<std::string, vehicle> veh_list, int flexibility_limit, uint64_t timestamp) {
+        auto scheduler = create_scheduler(flexibility_limit);
+        std::shared_ptr<intersection_schedule> schedule = std::make_shared<all_stop_intersection_schedule>();
+        schedule->timestamp = timestamp;
+        scheduler->schedule_vehicles(veh_list, schedule);
+        return std::dynamic_pointer_cast<all_stop_intersection_schedule>(schedule);
+    }
+
+    std::shared_ptr<all_stop_intersection_schedule> schedule_rdvs(int rdv_count, int flexibility_limit, uint64_t timestamp) {
+        return schedule_rdvs(create_rdvs(rdv_count, timestamp), flexibility_limit, timestamp);
+    }
+
+    /**
+     * @brief Exhaustive reference search over all RDV departure orders. Each order within the flexibility limit is scheduled
+     * alone, by renumbering the departure positions in that order and scheduling with a flexibility limit of 0. Orders are
+     * visited in ascending departure position permutation order and only a strictly lower delay replaces the best order.
+     * 
+     * @return false if no departure order is within the flexibility limit.
+     */
+    bool exhaustive_best_order(const std::unordered_map<std::string, vehicle> &veh_list, int flexibility_limit, uint64_t timestamp, 
+                                std::vector<std::string> &best_order, uint64_t &best_delay) {
+        std::vector<vehicle> rdvs;
+        for (const auto &[v_id, veh] : veh_list) {
+            rdvs.push_back(veh);
+        }
+        std::sort(rdvs.begin(), rdvs.end(), [](const vehicle &a, const vehicle &b) { return a._departure_position < b._departure_position; });
+        std::vector<size_t> order(rdvs.size());
+        std::iota(order.begin(), order.end(), 0);
+        bool found = false;
+        do {
+            bool within_flexibility_limit = true;
+            std::unordered_map<std::string, vehicle> ordered_rdvs;
+            for (size_t position = 0; position < order.size(); position++) {
+                vehicle veh = rdvs[order[position]];
+                if (abs(static_cast<int>(position) + 1 - veh._departure_position) > flexibility_limit) {
+                    within_flexibility_limit = false;
+                    break;
+                }
+                veh._departure_position = static_cast<int>(position) + 1;
+                ordered_rdvs.insert({veh._id, veh});
+            }
+            if (!within_flexibility_limit) {
+                continue;
+            }
+            uint64_t delay = schedule_rdvs(ordered_rdvs, 0, timestamp)->get_delay();
+            if (!found || delay < best_delay) {
+                found = true;
+                best_delay = delay;
+                best_order.clear();
+                for (const auto &index : order) {
+                    best_order.push_back(rdvs[index]._id);
+                }
+            }
+        } while (std::next_permutation(order.begin(), order.end()));
+        return found;
+    }
+}
+
+/**
+ * @brief The branch and bound RDV departure order search finds the same best delay and departure order as an exhaustive
+ * search over all departure orders, for 2 to 6 RDVs with mixed link lanelet conflicts and tight to unrestricted flexibility
+ * limits.
+ */
+TEST(all_stop_rdv_search_benchmark, search_matches_exhaustive_search) {
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int rdv_count = 2; rdv_count <= 6; rdv_count++) {
+        for (int variant = 0; variant < 3; variant++) {
+            for (int flexibility_limit : {1, 2, rdv_count}) {
+                auto veh_list = create_mixed_rdvs(rdv_count, variant, timestamp);
+                std::vector<std::string> expected_order;
+                uint64_t expected_delay = 0;
+                ASSERT_TRUE(exhaustive_best_order(veh_list, flexibility_limit, timestamp, expected_order, expected_delay));
+
+                auto sched = schedule_rdvs(veh_list, flexibility_limit, timestamp);
+                ASSERT_EQ(sched->vehicle_schedules.size(), rdv_count);
+                std::vector<all_stop_vehicle_schedule> departure_order = sched->vehicle_schedules;
+                std::sort(departure_order.begin(), departure_order.end(), 
+                            [](const all_stop_vehicle_schedule &a, const all_stop_vehicle_schedule &b) { return a.dp < b.dp; });
+                std::vector<std::string> order;
+                for (const auto &veh_sched : departure_order) {
+                    order.push_back(veh_sched.v_id);
+                }
+                SCOPED_TRACE("rdv_count " + std::to_string(rdv_count) + " variant " + std::to_string(variant) + " flexibility_limit " + std::to_string(flexibility_limit));
+                ASSERT_EQ(sched->get_delay(), expected_delay);
+                ASSERT_EQ(order, expected_order);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Schedules for 2 to 8 RDVs when every departure order is within the flexibility limit. Each RDV has to be 
+ * scheduled once, at a distinct departure position, and the best departure order can not have more delay than keeping 
+ * the current departure order.
+ */
+TEST(all_stop_rdv_search_benchmark, schedule_rdvs_departure_orders) {
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int rdv_count = 2; rdv_count <= 8; rdv_count++) {
+        auto sched = schedule_rdvs(rdv_count, rdv_count, timestamp);
+        ASSERT_EQ(sched->vehicle_schedules.size(), rdv_count);
+        std::set<std::string> v_ids;
+        std::set<int> dps;
+        for (const auto &veh_sched : sched->vehicle_schedules) {
+            v_ids.insert(veh_sched.v_id);
+            dps.insert(veh_sched.dp);
+        }
+        ASSERT_EQ(v_ids.size(), rdv_count);
+        ASSERT_EQ(*dps.begin(), 1);
+        ASSERT_EQ(*dps.rbegin(), rdv_count);
+        ASSERT_TRUE(sched->vehicle_schedules.front().access);
+        auto unchanged_order = schedule_rdvs(rdv_count, 0, timestamp);
+        ASSERT_LE(sched->get_delay(), unchanged_order->get_delay());
+    }
+}
+
+/**
+ * @brief Scheduling cycle time for 2 to 8 RDVs when every departure order is within the flexibility limit. Disabled by 
+ * default since it is timing dependent. Run with --gtest_also_run_disabled_tests --gtest_filter=*rdv_search_benchmark*
+ */
+TEST(all_stop_rdv_search_benchmark, DISABLED_schedule_rdvs_cycle_time) {
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int rdv_count = 2; rdv_count <= 8; rdv_count++) {
+        auto sched = schedule_rdvs(rdv_count, rdv_count, timestamp);
+        auto unchanged_order = schedule_rdvs(rdv_count, 0, timestamp);
+        std::chrono::duration<double, std::micro> elapsed(0);
+        for (int round = 0; round < round_count; round++) {
+            auto scheduler = create_scheduler(rdv_count);
+            auto veh_list = create_rdvs(rdv_count, timestamp);
+            std::shared_ptr<intersection_schedule> schedule = std::make_shared<all_stop_intersection_schedule>();
+            schedule->timestamp = timestamp;
+            auto start = std::chrono::steady_clock::now();
+            scheduler->schedule_vehicles(veh_list, schedule);
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        SPDLOG_INFO("Scheduling {0} RDVs takes {1:.1f} us per cycle with delay {2} ms ({3} ms in current departure order).",
+                    rdv_count, elapsed.count() / round_count, sched->get_delay(), unchanged_order->get_delay());
+    }
+}
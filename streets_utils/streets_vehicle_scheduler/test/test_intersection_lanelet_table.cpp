@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "intersection_lanelet_table.h"
+
+using namespace streets_vehicle_scheduler;
+
+TEST(test_intersection_lanelet_table, compile_intersection_info) {
+    OpenAPI::OAIIntersection_info info;
+    std::string json = "{\"departure_lanelets\":[{ \"id\":162, \"length\":41.60952439839113, \"speed_limit\":11.176} ], \"entry_lanelets\":[ { \"id\":167, \"length\":195.73023157287864, \"speed_limit\":11.176, \"connecting_lanelet_ids\": [155, 169] }, { \"id\":171, \"length\":34.130869411176431136, \"speed_limit\":8.0, \"connecting_lanelet_ids\": [160] } ], \"id\":9001, \"link_lanelets\":[{ \"conflict_lanelet_ids\":[ 160 ], \"id\":169, \"length\":15.85409574709938, \"speed_limit\":11.176, \"signal_group_id\":1 }, { \"conflict_lanelet_ids\":[ 160 ], \"id\":155, \"length\":16.796388658952235, \"speed_limit\":4.4704, \"signal_group_id\":1 }, { \"conflict_lanelet_ids\":[ 169, 155 ], \"id\":160, \"length\":10.295559117055083, \"speed_limit\":11.176, \"signal_group_id\":2 } ], \"name\":\"WestIntersection\"}";
+    info.fromJson(QString::fromStdString(json));
+    intersection_lanelet_table table(info);
+
+    ASSERT_EQ(table.get_entry_lanelets().size(), 2);
+    ASSERT_EQ(table.get_link_lanelets().size(), 3);
+    size_t index = 0;
+    ASSERT_TRUE(table.find_entry_lanelet(171, index));
+    ASSERT_EQ(table.get_id(index), 171);
+    ASSERT_DOUBLE_EQ(table.get_speed_limit(index), 8.0);
+    ASSERT_DOUBLE_EQ(table.get_length(index), 34.130869411176431136);
+    // Link and departure lanelets are not entry lanelets
+    ASSERT_FALSE(table.find_entry_lanelet(169, index));
+    ASSERT_FALSE(table.find_entry_lanelet(162, index));
+
+    ASSERT_TRUE(table.find_link_lanelet(155, index));
+    ASSERT_EQ(table.get_id(index), 155);
+    ASSERT_DOUBLE_EQ(table.get_speed_limit(index), 4.4704);
+    ASSERT_EQ(table.get_signal_group_id(index), 1);
+    ASSERT_FALSE(table.find_link_lanelet(167, index));
+
+    // Connecting link lanelets are in link lanelet order
+    ASSERT_TRUE(table.find_entry_lanelet(167, index));
+    const auto &connecting = table.get_connecting_link_lanelets(index);
+    ASSERT_EQ(connecting.size(), 2);
+    ASSERT_EQ(table.get_id(connecting[0]), 169);
+    ASSERT_EQ(table.get_id(connecting[1]), 155);
+    ASSERT_TRUE(table.find_link_lanelet(160, index));
+    ASSERT_TRUE(table.get_connecting_link_lanelets(index).empty());
+
+    intersection_lanelet_table empty;
+    ASSERT_TRUE(empty.get_entry_lanelets().empty());
+    ASSERT_FALSE(empty.find_link_lanelet(155, index));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "link_conflict_index.h"
+
+using namespace streets_vehicle_scheduler;
+
+namespace {
+    OpenAPI::OAIIntersection_info create_intersection_info() {
+        OpenAPI::OAIIntersection_info info;
+        std::string json = "{\"departure_lanelets\":[{ \"id\":162, \"length\":41.60952439839113, \"speed_limit\":11.176} ], \"entry_lanelets\":[ { \"id\":167, \"length\":195.73023157287864, \"speed_limit\":11.176 } ], \"id\":9001, \"link_lanelets\":[ { \"conflict_lanelet_ids\":[ 161 ], \"id\":169, \"length\":15.85409574709938, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 165, 156, 161 ], \"id\":155, \"length\":16.796388658952235, \"speed_limit\":4.4704 }, { \"conflict_lanelet_ids\":[ 155, 161, 160 ], \"id\":165, \"length\":15.853947840111768943, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 155, 999 ], \"id\":156, \"length\":9.744590320260139, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 169, 155, 165 ], \"id\":161, \"length\":16.043077028554038, \"speed_limit\":11.176 }, { \"conflict_lanelet_ids\":[ 165 ], \"id\":160, \"length\":10.295559117055083, \"speed_limit\":11.176 } ], \"name\":\"WestIntersection\"}";
+        info.fromJson(QString::fromStdString(json));
+        return info;
+    }
+}
+
+TEST(test_link_conflict_index, conflict_matrix) {
+    link_conflict_index index(create_intersection_info());
+    ASSERT_EQ(index.size(), 6);
+    ASSERT_EQ(index.get_link_index(169), 0);
+    ASSERT_EQ(index.get_link_index(160), 5);
+    // Entry lanelets and unknown ids are not link lanelets
+    ASSERT_EQ(index.get_link_index(167), -1);
+    ASSERT_EQ(index.get_link_index(999), -1);
+
+    ASSERT_TRUE(index.is_conflicting(index.get_link_index(169), index.get_link_index(161)));
+    ASSERT_TRUE(index.is_conflicting(index.get_link_index(155), index.get_link_index(156)));
+    ASSERT_FALSE(index.is_conflicting(index.get_link_index(169), index.get_link_index(155)));
+    ASSERT_FALSE(index.is_conflicting(index.get_link_index(169), index.get_link_index(169)));
+    ASSERT_FALSE(index.is_conflicting(index.get_link_index(169), -1));
+}
+
+TEST(test_link_conflict_index, latest_conflicting_dt) {
+    link_conflict_index index(create_intersection_info());
+    std::vector<link_departure> departures(index.size());
+    uint64_t dt = 0;
+    ASSERT_FALSE(index.get_latest_conflicting_dt(departures, index.get_link_index(155), dt));
+
+    // Departures on non conflicting link lanelets are ignored
+    index.add_departure(departures, index.get_link_index(169), 5000);
+    ASSERT_FALSE(index.get_latest_conflicting_dt(departures, index.get_link_index(155), dt));
+
+    index.add_departure(departures, index.get_link_index(165), 2000);
+    index.add_departure(departures, index.get_link_index(161), 3000);
+    ASSERT_TRUE(index.get_latest_conflicting_dt(departures, index.get_link_index(155), dt));
+    ASSERT_EQ(dt, 3000);
+
+    // Only the latest departure of a link lanelet is kept
+    index.add_departure(departures, index.get_link_index(165), 4000);
+    index.add_departure(departures, index.get_link_index(165), 1000);
+    ASSERT_TRUE(index.get_latest_conflicting_dt(departures, index.get_link_index(155), dt));
+    ASSERT_EQ(dt, 4000);
+
+    // Unknown link lanelets have no conflicts
+    index.add_departure(departures, -1, 6000);
+    ASSERT_FALSE(index.get_latest_conflicting_dt(departures, -1, dt));
+}
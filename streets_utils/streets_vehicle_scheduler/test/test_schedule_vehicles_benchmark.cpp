@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+
+#include "all_stop_vehicle_scheduler.h"
+#include "all_stop_intersection_schedule.h"
+#include "signalized_vehicle_scheduler.h"
+#include "signalized_intersection_schedule.h"
+#include "spat.h"
+
+using namespace streets_vehicles;
+using namespace streets_vehicle_scheduler;
+namespace {
+
+    const int round_count = 10;
+    const std::string intersection_json = "{\"departure_lanelets\":[{ \"id\":162, \"length\":41.60952439839113, \"speed_limit\":11.176}, { \"id\":164, \"length\":189.44565302601367, \"speed_limit\":11.176 }, { \"id\":168, \"length\":34.130869420842046, \"speed_limit\":11.176 } ], \"entry_lanelets\":[ { \"id\":167, \"length\":195.73023157287864, \"speed_limit\":11.176, \"connecting_lanelet_ids\": [155, 169] }, { \"id\":171, \"length\":34.130869411176431136, \"speed_limit\":11.176, \"connecting_lanelet_ids\": [160, 161] }, { \"id\":163, \"length\":41.60952435603712, \"speed_limit\":11.176 , \"connecting_lanelet_ids\": [156, 165]} ], \"id\":9001, \"link_lanelets\":[{ \"conflict_lanelet_ids\":[ 161 ], \"id\":169, \"length\":15.85409574709938, \"speed_limit\":11.176, \"signal_group_id\":1 }, { \"conflict_lanelet_ids\":[ 165, 156, 161 ], \"id\":155, \"length\":16.796388658952235, \"speed_limit\":4.4704, \"signal_group_id\":1 }, { \"conflict_lanelet_ids\":[ 155, 161, 160 ], \"id\":165, \"length\":15.853947840111768943, \"speed_limit\":11.176, \"signal_group_id\":3 }, { \"conflict_lanelet_ids\":[ 155 ], \"id\":156, \"length\":9.744590320260139, \"speed_limit\":11.176, \"signal_group_id\":3 }, { \"conflict_lanelet_ids\":[ 169, 155, 165 ], \"id\":161, \"length\":16.043077028554038, \"speed_limit\":11.176, \"signal_group_id\":2 }, { \"conflict_lanelet_ids\":[ 165 ], \"id\":160, \"length\":10.295559117055083, \"speed_limit\":11.176, \"signal_group_id\":2 } ], \"name\":\"WestIntersection\"}";
+    /**
+     * @brief Signal group 1 is green from 9950 to 10100 tenths of seconds from the current hour, signal group 2 from 10150 to 10250 
+     * and signal group 3 is red until 10300.
+     */
+    const std::string spat_json = "{\"timestamp\":0,\"name\":\"West Intersection\",\"intersections\":[{\"name\":\"West Intersection\",\"id\":1909,\"status\":0,\"revision\":123,\"moy\":34232,\"time_stamp\":130,\"enabled_lanes\":[155,156,160,161,165,169],\"states\":[{\"movement_name\":\"All Directions\",\"signal_group\":1,\"state_time_speed\":[{\"event_state\":6,\"timing\":{\"start_time\":9950,\"min_end_time\":10100}},{\"event_state\":8,\"timing\":{\"start_time\":10100,\"min_end_time\":10130}}, {\"event_state\":3,\"timing\":{\"start_time\":10130,\"min_end_time\":10300}}]},{\"movement_name\":\"All Directions\",\"signal_group\":2,\"state_time_speed\":[{\"event_state\":3,\"timing\":{\"start_time\":9950,\"min_end_time\":10150}},{\"event_state\":6,\"timing\":{\"start_time\":10150,\"min_end_time\":10250}}, {\"event_state\":8,\"timing\":{\"start_time\":10250,\"min_end_time\":10280}}, {\"event_state\":3,\"timing\":{\"start_time\":10280,\"min_end_time\":10300}}]},{\"movement_name\":\"All Directions\",\"signal_group\":3,\"state_time_speed\":[{\"event_state\":3,\"timing\":{\"start_time\":9950,\"min_end_time\":10300}}],\"maneuver_assist_list\":[{\"connection_id\":7,\"queue_length\":4,\"available_storage_length\":8,\"wait_on_stop\":true,\"ped_bicycle_detect\":false}]}],\"maneuver_assist_list\":[{\"connection_id\":7,\"queue_length\":4,\"available_storage_length\":8,\"wait_on_stop\":true,\"ped_bicycle_detect\":false}]}]}";
+    // Entry lanelets of the intersection and their link lanelets
+    const std::vector<std::pair<int, int>> lanes = {{167, 169}, {167, 155}, {171, 160}, {171, 161}, {163, 156}, {163, 165}};
+
+    std::shared_ptr<OpenAPI::OAIIntersection_info> create_intersection_info() {
+        OpenAPI::OAIIntersection_info info;
+        info.fromJson(QString::fromStdString(intersection_json));
+        return std::make_shared<OpenAPI::OAIIntersection_info>(info);
+    }
+
+    /**
+     * @brief Schedule timestamp 10000 tenths of seconds from the current hour, the time the SPaT is relative to.
+     */
+    uint64_t create_timestamp() {
+        auto hours_since_epoch = std::chrono::duration_cast<std::chrono::hours>(std::chrono::system_clock::now().time_since_epoch()).count();
+        return hours_since_epoch * 3600 * 1000 + 10000 * 100;
+    }
+
+    /**
+     * @brief EVs queued on the entry lanelets, 8 meters apart.
+     */
+    std::unordered_map<std::string, vehicle> create_evs(int ev_count, uint64_t timestamp) {
+        std::unordered_map<std::string, vehicle> veh_list;
+        for (int i = 0; i < ev_count; i++) {
+            vehicle veh;
+            veh._id = "TEST_EV_" + std::to_string(i);
+            veh._length = 5.0;
+            veh._min_gap = 2.0;
+            veh._reaction_time = 1.0;
+            veh._accel_max = 2.0;
+            veh._decel_max = -1.5;
+            veh._cur_speed = 4.4704;
+            veh._cur_accel = 0.0;
+            veh._cur_distance = 10.0 + 8.0 * (i / static_cast<int>(lanes.size()));
+            veh._cur_state = vehicle_state::EV;
+            veh._cur_time = timestamp;
+            veh._entry_lane_id = lanes[i % lanes.size()].first;
+            veh._cur_lane_id = veh._entry_lane_id;
+            veh._link_id = lanes[i % lanes.size()].second;
+            veh._exit_lane_id = 164;
+            veh._direction = "straight";
+            veh_list.insert({veh._id, veh});
+        }
+        return veh_list;
+    }
+}
+
+/**
+ * @brief schedule_vehicles cycle time of the all stop and signalized schedulers for 50 to 300 EVs. Disabled by default since it 
+ * is timing dependent. Run with --gtest_also_run_disabled_tests --gtest_filter=*schedule_vehicles_benchmark*
+ */
+TEST(schedule_vehicles_benchmark, DISABLED_schedule_evs_cycle_time) {
+    uint64_t timestamp = create_timestamp();
+    all_stop_vehicle_scheduler all_stop_scheduler;
+    all_stop_scheduler.set_intersection_info(create_intersection_info());
+    signalized_vehicle_scheduler signalized_scheduler;
+    signalized_scheduler.set_intersection_info(create_intersection_info());
+    signal_phase_and_timing::spat spat_message;
+    spat_message.fromJson(spat_json);
+    signalized_scheduler.set_spat(std::make_shared<signal_phase_and_timing::spat>(spat_message));
+
+    for (int ev_count = 50; ev_count <= 300; ev_count += 50) {
+        std::chrono::duration<double, std::micro> all_stop_elapsed(0);
+        std::chrono::duration<double, std::micro> signalized_elapsed(0);
+        for (int round = 0; round < round_count; round++) {
+            auto veh_list = create_evs(ev_count, timestamp);
+            std::shared_ptr<intersection_schedule> all_stop_schedule = std::make_shared<all_stop_intersection_schedule>();
+            all_stop_schedule->timestamp = timestamp;
+            auto start = std::chrono::steady_clock::now();
+            all_stop_scheduler.schedule_vehicles(veh_list, all_stop_schedule);
+            all_stop_elapsed += std::chrono::steady_clock::now() - start;
+            ASSERT_EQ(std::dynamic_pointer_cast<all_stop_intersection_schedule>(all_stop_schedule)->vehicle_schedules.size(), ev_count);
+
+            veh_list = create_evs(ev_count, timestamp);
+            std::shared_ptr<intersection_schedule> signalized_schedule = std::make_shared<signalized_intersection_schedule>();
+            signalized_schedule->timestamp = timestamp;
+            start = std::chrono::steady_clock::now();
+            signalized_scheduler.schedule_vehicles(veh_list, signalized_schedule);
+            signalized_elapsed += std::chrono::steady_clock::now() - start;
+            ASSERT_EQ(std::dynamic_pointer_cast<signalized_intersection_schedule>(signalized_schedule)->vehicle_schedules.size(), ev_count);
+        }
+        SPDLOG_INFO("Scheduling {0} EVs takes {1:.1f} us per cycle with the all stop scheduler and {2:.1f} us with the signalized scheduler.",
+                    ev_count, all_stop_elapsed.count() / round_count, signalized_elapsed.count() / round_count);
+    }
+}
+
+/**
+ * @brief schedule_vehicles cycle time of the signalized scheduler scheduling entry lanes sequentially and in parallel. Parallel
+ * scheduling must produce the same schedule in the same order. Disabled by default since it is timing dependent, the 
+ * parallel_ev_scheduling unit test covers the schedules. Run with --gtest_also_run_disabled_tests --gtest_filter=*schedule_vehicles_benchmark*
+ */
+TEST(schedule_vehicles_benchmark, DISABLED_parallel_schedule_evs_cycle_time) {
+    uint64_t timestamp = create_timestamp();
+    signalized_vehicle_scheduler sequential_scheduler;
+    sequential_scheduler.set_intersection_info(create_intersection_info());
+    signalized_vehicle_scheduler parallel_scheduler;
+    parallel_scheduler.set_intersection_info(create_intersection_info());
+    parallel_scheduler.set_ev_scheduling_threads(3);
+    signal_phase_and_timing::spat spat_message;
+    spat_message.fromJson(spat_json);
+    auto spat_ptr = std::make_shared<signal_phase_and_timing::spat>(spat_message);
+    sequential_scheduler.set_spat(spat_ptr);
+    parallel_scheduler.set_spat(spat_ptr);
+
+    for (int ev_count = 50; ev_count <= 300; ev_count += 50) {
+        std::chrono::duration<double, std::micro> sequential_elapsed(0);
+        std::chrono::duration<double, std::micro> parallel_elapsed(0);
+        for (int round = 0; round < round_count; round++) {
+            auto veh_list = create_evs(ev_count, timestamp);
+            auto sequential_schedule = std::make_shared<signalized_intersection_schedule>();
+            sequential_schedule->timestamp = timestamp;
+            std::shared_ptr<intersection_schedule> schedule = sequential_schedule;
+            auto start = std::chrono::steady_clock::now();
+            sequential_scheduler.schedule_vehicles(veh_list, schedule);
+            sequential_elapsed += std::chrono::steady_clock::now() - start;
+
+            veh_list = create_evs(ev_count, timestamp);
+            auto parallel_schedule = std::make_shared<signalized_intersection_schedule>();
+            parallel_schedule->timestamp = timestamp;
+            schedule = parallel_schedule;
+            start = std::chrono::steady_clock::now();
+            parallel_scheduler.schedule_vehicles(veh_list, schedule);
+            parallel_elapsed += std::chrono::steady_clock::now() - start;
+
+            ASSERT_EQ(parallel_schedule->vehicle_schedules.size(), ev_count);
+            ASSERT_EQ(parallel_schedule->vehicle_schedules.size(), sequential_schedule->vehicle_schedules.size());
+            for (size_t i = 0; i < parallel_schedule->vehicle_schedules.size(); i++) {
+                ASSERT_EQ(parallel_schedule->vehicle_schedules[i].v_id, sequential_schedule->vehicle_schedules[i].v_id);
+                ASSERT_EQ(parallel_schedule->vehicle_schedules[i].et, sequential_schedule->vehicle_schedules[i].et);
+                ASSERT_EQ(parallel_schedule->vehicle_schedules[i].dt, sequential_schedule->vehicle_schedules[i].dt);
+            }
+        }
+        SPDLOG_INFO("Scheduling {0} EVs takes {1:.1f} us per cycle with sequential entry lanes and {2:.1f} us with 3 threads.",
+                    ev_count, sequential_elapsed.count() / round_count, parallel_elapsed.count() / round_count);
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 #include "vehicle_list.h"
 #include "signalized_vehicle_scheduler.h"
@@ -333,3 +334,135 @@ TEST_F(signalized_scheduler_test, one_ev_with_cruising_2){
 
 
 
+
+namespace {
+    vehicle create_ev( const std::string &v_id, const int entry_lane_id, const int link_id, const double distance, const uint64_t timestamp) {
+        vehicle veh;
+        veh._id = v_id;
+        veh._length = 5.0;
+        veh._min_gap = 2.0;
+        veh._reaction_time = 1.0;
+        veh._accel_max = 2.0;
+        veh._decel_max = -1.5;
+        veh._cur_speed = 6.7056;
+        veh._cur_accel = 0.0;
+        veh._cur_distance = distance;
+        veh._cur_lane_id = entry_lane_id;
+        veh._cur_state = vehicle_state::EV;
+        veh._cur_time = timestamp;
+        veh._entry_lane_id = entry_lane_id;
+        veh._link_id = link_id;
+        veh._exit_lane_id = 168;
+        veh._direction = "straight";
+        return veh;
+    }
+
+    void assert_same_schedules( const std::shared_ptr<intersection_schedule> &schedule, const std::shared_ptr<intersection_schedule> &expected_schedule) {
+        auto sched = std::dynamic_pointer_cast<signalized_intersection_schedule> (schedule);
+        auto expected = std::dynamic_pointer_cast<signalized_intersection_schedule> (expected_schedule);
+        ASSERT_EQ( sched->vehicle_schedules.size(), expected->vehicle_schedules.size());
+        for ( const auto &expected_sched : expected->vehicle_schedules ) {
+            auto veh_sched = std::find_if(sched->vehicle_schedules.begin(), sched->vehicle_schedules.end(), 
+                [&expected_sched](const signalized_vehicle_schedule &s){ return s.v_id == expected_sched.v_id; });
+            ASSERT_NE( veh_sched, sched->vehicle_schedules.end());
+            ASSERT_EQ( veh_sched->eet, expected_sched.eet);
+            ASSERT_EQ( veh_sched->et, expected_sched.et);
+            ASSERT_EQ( veh_sched->dt, expected_sched.dt);
+        }
+    }
+}
+
+/**
+ * @brief Test incremental scheduling of vehicle changes against scheduling all vehicles. Only the entry lane of a changed vehicle 
+ * and entry lanes with a changed movement state are rescheduled.
+ */
+TEST_F(signalized_scheduler_test, schedule_vehicle_changes){
+    vehicle_change_set changes;
+    changes.updated.push_back(create_ev("TEST01", 167, 169, 20.0, schedule->timestamp));
+    changes.updated.push_back(create_ev("TEST02", 167, 169, 40.0, schedule->timestamp));
+    changes.updated.push_back(create_ev("TEST03", 171, 161, 30.0, schedule->timestamp));
+    scheduler->schedule_vehicle_changes(changes, schedule);
+    ASSERT_EQ( scheduler->get_tracked_vehicles().size(), 3);
+
+    auto expected = std::make_shared<signalized_intersection_schedule>();
+    expected->timestamp = schedule->timestamp;
+    std::shared_ptr<intersection_schedule> expected_schedule = expected;
+    auto vehicles = scheduler->get_tracked_vehicles();
+    scheduler->schedule_vehicles(vehicles, expected_schedule);
+    assert_same_schedules(schedule, expected_schedule);
+
+    // Update the vehicle in entry lane 171, entry lane 167 schedules are reused
+    changes.updated.clear();
+    changes.updated.push_back(create_ev("TEST03", 171, 161, 25.0, schedule->timestamp));
+    auto incremental_schedule = std::make_shared<signalized_intersection_schedule>();
+    incremental_schedule->timestamp = schedule->timestamp;
+    schedule = incremental_schedule;
+    scheduler->schedule_vehicle_changes(changes, schedule);
+
+    expected_schedule = std::make_shared<signalized_intersection_schedule>();
+    expected_schedule->timestamp = schedule->timestamp;
+    vehicles = scheduler->get_tracked_vehicles();
+    scheduler->schedule_vehicles(vehicles, expected_schedule);
+    assert_same_schedules(schedule, expected_schedule);
+
+    // Changing the movement state of entry lane 167 reschedules it without vehicle changes
+    spat_ptr->intersections.front().states.front().state_time_speed.front().timing.start_time = 10050;
+    incremental_schedule = std::make_shared<signalized_intersection_schedule>();
+    incremental_schedule->timestamp = schedule->timestamp;
+    schedule = incremental_schedule;
+    scheduler->schedule_vehicle_changes(vehicle_change_set(), schedule);
+
+    expected_schedule = std::make_shared<signalized_intersection_schedule>();
+    expected_schedule->timestamp = schedule->timestamp;
+    vehicles = scheduler->get_tracked_vehicles();
+    scheduler->schedule_vehicles(vehicles, expected_schedule);
+    assert_same_schedules(schedule, expected_schedule);
+
+    // Removed vehicles are no longer scheduled
+    changes.updated.clear();
+    changes.removed.push_back("TEST03");
+    incremental_schedule = std::make_shared<signalized_intersection_schedule>();
+    incremental_schedule->timestamp = schedule->timestamp;
+    schedule = incremental_schedule;
+    scheduler->schedule_vehicle_changes(changes, schedule);
+    ASSERT_EQ( scheduler->get_tracked_vehicles().size(), 2);
+    ASSERT_EQ( std::dynamic_pointer_cast<signalized_intersection_schedule>(schedule)->vehicle_schedules.size(), 2);
+}
+
+/**
+ * @brief Test scheduling the EVs of different entry lanes in parallel against scheduling them sequentially. Both have to produce the 
+ * same vehicle schedules in the same order.
+ */
+TEST_F(signalized_scheduler_test, parallel_ev_scheduling){
+    veh_list.insert({"TEST01", create_ev("TEST01", 167, 169, 20.0, schedule->timestamp)});
+    veh_list.insert({"TEST02", create_ev("TEST02", 167, 155, 35.0, schedule->timestamp)});
+    veh_list.insert({"TEST03", create_ev("TEST03", 171, 161, 15.0, schedule->timestamp)});
+    veh_list.insert({"TEST04", create_ev("TEST04", 171, 160, 28.0, schedule->timestamp)});
+    veh_list.insert({"TEST05", create_ev("TEST05", 163, 156, 25.0, schedule->timestamp)});
+    veh_list.insert({"TEST06", create_ev("TEST06", 163, 165, 40.0, schedule->timestamp)});
+
+    ASSERT_EQ( scheduler->get_ev_scheduling_threads(), 1U);
+    auto vehicles = veh_list;
+    scheduler->schedule_vehicles(vehicles, schedule);
+    auto sequential = std::dynamic_pointer_cast<signalized_intersection_schedule> (schedule);
+    ASSERT_EQ( sequential->vehicle_schedules.size(), 6);
+
+    // Values below 1 are treated as 1
+    scheduler->set_ev_scheduling_threads(0);
+    ASSERT_EQ( scheduler->get_ev_scheduling_threads(), 1U);
+
+    for ( unsigned int threads : {2U, 3U, 8U} ) {
+        scheduler->set_ev_scheduling_threads(threads);
+        auto parallel = std::make_shared<signalized_intersection_schedule>();
+        parallel->timestamp = sequential->timestamp;
+        std::shared_ptr<intersection_schedule> parallel_schedule = parallel;
+        vehicles = veh_list;
+        scheduler->schedule_vehicles(vehicles, parallel_schedule);
+        ASSERT_EQ( parallel->vehicle_schedules.size(), sequential->vehicle_schedules.size());
+        for ( size_t i = 0; i < parallel->vehicle_schedules.size(); i++ ) {
+            ASSERT_EQ( parallel->vehicle_schedules[i].v_id, sequential->vehicle_schedules[i].v_id);
+            ASSERT_EQ( parallel->vehicle_schedules[i].et, sequential->vehicle_schedules[i].et);
+            ASSERT_EQ( parallel->vehicle_schedules[i].dt, sequential->vehicle_schedules[i].dt);
+        }
+    }
+}
@@ -25,15 +25,15 @@ namespace traffic_signal_controller_service {
             /**
              * @brief Kafka producer for spat JSON
              */
-            std::shared_ptr<kafka_clients::kafka_producer_worker> spat_producer;
+            std::shared_ptr<kafka_clients::producer_transport> spat_producer;
             /**
              * @brief Kafka producer for tsc_configuration_state JSON
              */
-            std::shared_ptr<kafka_clients::kafka_producer_worker> tsc_config_producer;
+            std::shared_ptr<kafka_clients::producer_transport> tsc_config_producer;
             /*
              * @brief Kafka consumer for consuming desired phase plan JSON
              */
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> desired_phase_plan_consumer;
+            std::shared_ptr<kafka_clients::consumer_transport> desired_phase_plan_consumer;
 
             /**
              * @brief spat_worker contains udp_socket_listener and consumes UDP data 
@@ -77,6 +77,9 @@ namespace traffic_signal_controller_service {
             // desired phase plan information consumed from desire_phase_plan Kafka topic
             bool use_desired_phase_plan_update_ = false;
 
+            // Transport of the kafka producers and consumers, read from the message_transport configuration
+            kafka_clients::transport_type message_transport_ = kafka_clients::transport_type::KAFKA;
+
             //Add Friend Test to share private members
             FRIEND_TEST(traffic_signal_controller_service, test_produce_spat_json_timeout) ;
             FRIEND_TEST(traffic_signal_controller_service, test_produce_tsc_config_json_timeout);
@@ -104,20 +107,23 @@ namespace traffic_signal_controller_service {
              * @param bootstap_server for CARMA-Streets Kafka broker.
              * @param producer_topic name of topic to produce to.
              * @param producer kafka producer set up on producer topic.
+             * @param properties librdkafka tuning properties applied to the producer.
              * @return true if initialization is successful.
              * @return false if initialization is not successful.
              */
 
             bool initialize_kafka_producer( const std::string &bootstap_server, const std::string &producer_topic, 
-                    std::shared_ptr<kafka_clients::kafka_producer_worker>& producer);
+                    std::shared_ptr<kafka_clients::producer_transport>& producer, const kafka_clients::kafka_properties &properties = {});
             /**
              * @brief Initialize Kafka Desired phase plan consumer. 
              * @param bootstap_server for CARMA-Streets Kafka broker.
              * @param desired_phase_plan_consumer_topic name of topic to produce to.
+             * @param properties librdkafka tuning properties applied to the consumer.
              * @return true if initialization is successful.
              * @return false if initialization is not successful.
              */
-            bool initialize_kafka_consumer(const std::string &bootstrap_server, const std::string &desired_phase_plan_consumer_topic, std::string &consumer_group);
+            bool initialize_kafka_consumer(const std::string &bootstrap_server, const std::string &desired_phase_plan_consumer_topic, std::string &consumer_group,
+                    const kafka_clients::kafka_properties &properties = {});
 
             /**
              * @brief Initialize SNMP Client to make SNMP calls to Traffic Signal Controller.
@@ -10,17 +10,25 @@ namespace traffic_signal_controller_service {
         {
             // Intialize spat kafka producer
             std::string bootstrap_server = streets_service::streets_configuration::get_string_config("bootstrap_server");
+            message_transport_ = kafka_clients::parse_transport_type(streets_service::streets_configuration::get_string_config("message_transport"));
             std::string spat_topic_name = streets_service::streets_configuration::get_string_config("spat_producer_topic");
 
             std::string dpp_consumer_topic = streets_service::streets_configuration::get_string_config("desired_phase_plan_consumer_topic");
             std::string dpp_consumer_group = streets_service::streets_configuration::get_string_config("desired_phase_plan_consumer_group");
-            if (!initialize_kafka_producer(bootstrap_server, spat_topic_name, spat_producer)) {
+            auto producer_properties = kafka_clients::get_producer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_producer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_producer_properties"));
+            auto consumer_properties = kafka_clients::get_consumer_properties(
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_profile"),
+                    streets_service::streets_configuration::get_string_config("kafka_consumer_properties"));
+            if (!initialize_kafka_producer(bootstrap_server, spat_topic_name, spat_producer, producer_properties)) {
                 return false;
             }
 
-            if (!initialize_kafka_consumer(bootstrap_server, dpp_consumer_topic, dpp_consumer_group)) {
+            if (!initialize_kafka_consumer(bootstrap_server, dpp_consumer_topic, dpp_consumer_group, consumer_properties)) {
                 return false;
             }            
+            kafka_clients::pipeline_trace_metrics::instance().set_log_interval_ms(streets_service::streets_configuration::get_int_config("pipeline_trace_log_interval"));
             // Initialize SNMP Client
             std::string target_ip = streets_service::streets_configuration::get_string_config("target_ip");
             int target_port = streets_service::streets_configuration::get_int_config("target_port");
@@ -33,7 +41,7 @@ namespace traffic_signal_controller_service {
             
             //  Initialize tsc configuration state kafka producer
             std::string tsc_config_topic_name = streets_service::streets_configuration::get_string_config("tsc_config_producer_topic");
-            if (!initialize_kafka_producer(bootstrap_server, tsc_config_topic_name, tsc_config_producer)) {
+            if (!initialize_kafka_producer(bootstrap_server, tsc_config_topic_name, tsc_config_producer, producer_properties)) {
                 return false;
             }
             //Initialize TSC State
@@ -78,10 +86,10 @@ namespace traffic_signal_controller_service {
     }
 
     bool tsc_service::initialize_kafka_producer(const std::string &bootstrap_server, const std::string &producer_topic,
-         std::shared_ptr<kafka_clients::kafka_producer_worker>& producer) {
+         std::shared_ptr<kafka_clients::producer_transport>& producer, const kafka_clients::kafka_properties &properties) {
         
-        auto client = std::make_unique<kafka_clients::kafka_client>();
-        producer = client->create_producer(bootstrap_server, producer_topic);
+        auto client = std::make_unique<kafka_clients::kafka_client>(message_transport_);
+        producer = client->create_producer_transport(bootstrap_server, producer_topic, properties);
         if (!producer->init())
         {
             SPDLOG_CRITICAL("Kafka producer initialize error on topic {0}", producer_topic);
@@ -91,9 +99,10 @@ namespace traffic_signal_controller_service {
         return true;
     }
 
-    bool tsc_service::initialize_kafka_consumer(const std::string &bootstrap_server, const std::string &desired_phase_plan_consumer_topic,  std::string &consumer_group) {
-        auto client = std::make_unique<kafka_clients::kafka_client>();
-        desired_phase_plan_consumer = client->create_consumer(bootstrap_server, desired_phase_plan_consumer_topic, consumer_group);
+    bool tsc_service::initialize_kafka_consumer(const std::string &bootstrap_server, const std::string &desired_phase_plan_consumer_topic,  std::string &consumer_group,
+         const kafka_clients::kafka_properties &properties) {
+        auto client = std::make_unique<kafka_clients::kafka_client>(message_transport_);
+        desired_phase_plan_consumer = client->create_consumer_transport(bootstrap_server, {desired_phase_plan_consumer_topic}, consumer_group, properties);
         if (!desired_phase_plan_consumer->init())
         {
             SPDLOG_CRITICAL("Kafka desired phase plan initialize error");
@@ -225,12 +234,19 @@ namespace traffic_signal_controller_service {
     void tsc_service::consume_desired_phase_plan() const {
        while (desired_phase_plan_consumer->is_running())
         {
-            const std::string payload = desired_phase_plan_consumer->consume(1000);
-            if (payload.length() != 0)
+            kafka_clients::kafka_message msg = desired_phase_plan_consumer->consume_message(1000);
+            if (!msg.empty())
             {
+                kafka_clients::trace_context trace = kafka_clients::read_trace_context(msg);
+                trace.mark(kafka_clients::trace_stage::TSC_INGEST);
+                const std::string payload = msg.to_string();
                 SPDLOG_DEBUG("Consumed: {0}", payload);
-                std::scoped_lock<std::mutex> lck{dpp_mtx};
-                monitor_dpp_ptr->update_desired_phase_plan(payload);
+                {
+                    std::scoped_lock<std::mutex> lck{dpp_mtx};
+                    monitor_dpp_ptr->update_desired_phase_plan(payload);
+                }
+                trace.mark(kafka_clients::trace_stage::TSC_UPDATE);
+                kafka_clients::pipeline_trace_metrics::instance().record(trace, kafka_clients::trace_stage::TSC_INGEST, kafka_clients::trace_stage::TSC_UPDATE);
             }
         }        
     }